@@ -6,6 +6,8 @@
 #include "Local.h"
 #include "Date.h"
 #include "Atribuicao.h"
+#include "BufferEscrita.h"
+#include "Necessidade.h"
 
 /**
  * Acidente que foi declarado à Proteção Civil
@@ -17,6 +19,8 @@ protected:
 	const unsigned int numOcorrencia;		/**< Número atribuído à ocorrência							*/
 	std::vector<Atribuicao> atribuicoes;	/**< Vetor de Atribuições de meios a esta ocorrência		*/
 public:
+	static const unsigned int MAX_NECESSIDADES = 2;		/**< Número máximo de necessidades de um acidente (ver getNecessidades)		*/
+
 	/**
 	 * @brief Construtor da classe Acidente
 	 * @param data - Data da ocorrência no formato DD-MM-AAAA
@@ -60,10 +64,23 @@ public:
 	virtual void printInfoAcidente() const = 0;
 
 	/**
-	 * @brief Método puramente virtual que imprime numa stream o conteudo simplificado de um acidente. A implementação encontra-se nas classes derivadas: Assalto, AcidenteViacao, IncendioDomestico e IncendioFlorestal
+	 * @brief Imprime numa stream o conteudo simplificado de um acidente
 	 * @param os - Stream para a qual o conteúdo do acidente é impresso
 	 */
-	virtual void printSimplifiedInfo(std::ostream & os) const = 0;
+	void printSimplifiedInfo(std::ostream & os) const;
+
+	/**
+	 * @brief Método puramente virtual que escreve num buffer de escrita o conteudo simplificado de um acidente. A implementação encontra-se nas classes derivadas: Assalto, AcidenteViacao, IncendioDomestico e IncendioFlorestal
+	 * @param buf - Buffer para o qual o conteúdo do acidente é escrito
+	 */
+	virtual void serializar(BufferEscrita & buf) const = 0;
+
+	/**
+	 * @brief Método puramente virtual que permite obter as necessidades do acidente, pela ordem em que são supridas (ver NecessidadesAcidente). A implementação encontra-se nas classes derivadas: AcidenteViacao, Assalto e Incendio
+	 * @param necessidades - Onde são colocadas as necessidades
+	 * @return Retorna o número de necessidades colocadas
+	 */
+	virtual unsigned int getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const = 0;
 
 	/**
 	 * @brief Adiciona uma atribuicao ao vetor de atribuicoes
@@ -58,10 +58,17 @@ public:
 	void printInfoAcidente() const;		
 
 	/**
-	 * @brief Imprime numa stream o conteudo simplificado de um Acidente de Viação
-	 * @param os - Stream para a qual o conteúdo do Acidente de Viação é impresso
+	 * @brief Escreve num buffer de escrita o conteudo simplificado de um Acidente de Viação
+	 * @param buf - Buffer para o qual o conteúdo do Acidente de Viação é escrito
 	 */
-	void printSimplifiedInfo(std::ostream & os) const;
+	void serializar(BufferEscrita & buf) const;
+
+	/**
+	 * @brief Permite obter as necessidades do acidente de viação (ver NecessidadesAcidente<AcidenteViacao>)
+	 * @param necessidades - Onde são colocadas as necessidades
+	 * @return Retorna o número de necessidades colocadas
+	 */
+	unsigned int getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const;
 };
 
 #endif /* ACIDENTEVIACAO_H_ */
@@ -0,0 +1,244 @@
+#ifndef ARQUIVOACIDENTES_H_
+#define ARQUIVOACIDENTES_H_
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include "Acidente.h"
+#include "Date.h"
+#include "DescritorAcidente.h"
+#include "CodificadorArquivo.h"
+#include "FicheiroMapeado.h"
+
+/**
+ * Bloco de registos consecutivos de uma partição do arquivo: é a unidade do índice esparso (uma entrada por bloco, e não por acidente)
+ */
+struct BlocoArquivo {
+	unsigned long long inicio;			/**< Posição do primeiro registo do bloco no ficheiro da partição	*/
+	unsigned long long fim;				/**< Posição a seguir ao último registo do bloco					*/
+	unsigned int numRegistos;			/**< Número de registos do bloco									*/
+	unsigned int minNum;				/**< Menor número de ocorrência do bloco							*/
+	unsigned int maxNum;				/**< Maior número de ocorrência do bloco							*/
+	uint32_t minData;					/**< Menor data (compactada) do bloco								*/
+	uint32_t maxData;					/**< Maior data (compactada) do bloco								*/
+	unsigned long long maxSeq;			/**< Maior número de sequência do bloco							*/
+	uint32_t crc;						/**< CRC32C de todos os bytes do bloco							*/
+	BaseBloco base;						/**< Valores do primeiro registo, em relação aos quais os restantes são codificados	*/
+};
+
+/**
+ * Posição de um registo no arquivo, que permite lê-lo sem ler o resto do seu bloco
+ */
+struct PosicaoRegisto {
+	unsigned int ano;					/**< Ano da partição do registo									*/
+	unsigned int indiceBloco;			/**< Posição do bloco do registo no índice esparso da partição	*/
+	unsigned long long inicio;			/**< Posição do registo no ficheiro da partição					*/
+	unsigned long long fim;				/**< Posição a seguir ao registo								*/
+	unsigned int numOcorrencia;			/**< Número de ocorrência do acidente							*/
+	unsigned long long seq;				/**< Número de sequência (no diário) do registo do seu término	*/
+};
+
+/**
+ * Referência para um bloco de uma partição do arquivo
+ */
+struct ReferenciaBloco {
+	unsigned int ano;					/**< Ano da partição do bloco									*/
+	unsigned int indice;				/**< Posição do bloco no índice esparso da partição				*/
+	unsigned int numRegistos;			/**< Número de registos que o bloco tem atualmente				*/
+};
+
+/**
+ * Partição do arquivo: todos os acidentes terminados que ocorreram num dado ano
+ */
+struct ParticaoArquivo {
+	std::string ficheiro;				/**< Nome do ficheiro de dados da partição										*/
+	std::vector<BlocoArquivo> blocos;	/**< Índice esparso da partição (o último bloco pode estar incompleto)			*/
+	unsigned int blocosIndexados;		/**< Número de blocos já escritos no ficheiro de índice						*/
+	unsigned long long tamanho;			/**< Tamanho dos dados da partição, incluindo os registos ainda por escrever	*/
+	std::string pendente;				/**< Registos acrescentados mas ainda não escritos no ficheiro					*/
+	std::shared_ptr<FicheiroMapeado> mapa;	/**< Mapeamento em memória dos dados já escritos no ficheiro					*/
+	bool nova;							/**< Indica que a partição ainda não consta do manifesto do arquivo			*/
+};
+
+/**
+ * Arquivo de acidentes terminados, em disco. O arquivo só cresce (os registos são acrescentados no fim) e está dividido em partições por ano do acidente.
+ * Em memória fica apenas o índice esparso de cada partição (uma entrada por bloco de REGISTOS_POR_BLOCO registos, com os intervalos de datas e de números de ocorrência do bloco),
+ * pelo que as pesquisas leem apenas os blocos das partições relevantes.
+ * Os ficheiros das partições são mapeados em memória (mmap): os blocos são verificados e descodificados diretamente nas páginas do ficheiro, sem cópias.
+ * Cada registo e cada bloco têm um CRC32C; as leituras lançam a exceção DadosCorrompidos caso um deles não corresponda ao conteúdo lido.
+ *
+ * Ficheiros (para um ficheiro de acidentes "acidentes"):
+ *   acidentes.arq , manifesto com os anos das partições (uma linha por ano)
+ *   acidentes.arq.dic , dicionário dos textos dos registos (locais e tipos), partilhado por todas as partições
+ *   acidentes.arqANO , dados da partição, em binário: cada registo é codificado pelo CodificadorArquivo (varints, diferenças em relação à base do bloco e identificadores do dicionário)
+ *   acidentes.arqANO.idx , índice esparso da partição: uma linha por bloco completo, com o CRC32C e a base do bloco
+ */
+class ArquivoAcidentes {
+public:
+	/**
+	 * Momento em que os checksums dos blocos indexados são verificados
+	 */
+	enum ModoVerificacao {
+		VERIFICAR_AO_ABRIR,		/**< Todos os blocos são lidos e verificados ao abrir o arquivo							*/
+		VERIFICAR_AO_LER		/**< Cada bloco é verificado apenas quando é lido (a abertura não depende do tamanho do arquivo)	*/
+	};
+
+	static const unsigned int REGISTOS_POR_BLOCO = 64;		/**< Número de registos de cada bloco do índice esparso	*/
+private:
+	const std::string prefixo;						/**< Prefixo dos nomes dos ficheiros do arquivo							*/
+	const ModoVerificacao modoVerificacao;			/**< Momento em que os checksums dos blocos são verificados				*/
+	DicionarioArquivo dicionario;					/**< Dicionário dos textos dos registos									*/
+	std::map<unsigned int, ParticaoArquivo> particoes;	/**< Partições do arquivo, por ano										*/
+	unsigned long long ultimoSeq;					/**< Maior número de sequência arquivado									*/
+	unsigned int numRegistos;						/**< Número total de registos do arquivo									*/
+
+	/**
+	 * @brief Lê um registo do arquivo, lançando a exceção DadosCorrompidos caso o checksum do registo não corresponda ao seu conteúdo
+	 * @param pos - Posição de início do registo; no fim aponta para o início do registo seguinte
+	 * @param fim - Fim dos dados
+	 * @param base - Valores em relação aos quais o registo foi codificado
+	 * @param registo - Variável onde é colocado o registo lido
+	 * @return Retorna true caso tenha sido lido um registo completo e false caso contrário
+	 */
+	bool lerRegisto(const char* &pos, const char* fim, const BaseBloco &base, RegistoArquivo &registo) const;
+
+	/**
+	 * @brief Verifica o CRC32C de um bloco lido, lançando a exceção DadosCorrompidos caso não corresponda ao conteúdo
+	 * @param particao - Partição do bloco
+	 * @param bloco - Bloco lido
+	 * @param inicio - Início dos bytes lidos do bloco
+	 * @param fim - Fim dos bytes lidos do bloco
+	 */
+	static void verificarBloco(const ParticaoArquivo &particao, const BlocoArquivo &bloco, const char* inicio, const char* fim);
+
+	/**
+	 * @brief Contabiliza um registo no índice esparso de uma partição
+	 * @param particao - Partição do registo
+	 * @param registo - Registo acrescentado
+	 * @param dados - Bytes do registo (para o CRC do bloco)
+	 * @param tamanhoRegisto - Tamanho do registo, em bytes
+	 */
+	void indexar(ParticaoArquivo &particao, const RegistoArquivo &registo, const char* dados, unsigned long long tamanhoRegisto);
+
+	/**
+	 * @brief Abre uma partição: lê o seu índice e os registos que ainda não estão indexados, descartando um registo final incompleto
+	 * @param ano - Ano da partição
+	 */
+	void abrirParticao(unsigned int ano);
+
+	/**
+	 * @brief Lê um intervalo de bytes de uma partição: diretamente do mapeamento do ficheiro caso já esteja todo escrito, ou copiado caso inclua registos ainda por escrever
+	 * @param particao - Partição a ler
+	 * @param inicio - Posição inicial
+	 * @param fim - Posição final (exclusive)
+	 * @param copia - Buffer onde são copiados os bytes, caso não possam ser lidos diretamente do mapeamento
+	 * @param inicioTexto - Variável onde é colocado o início dos bytes lidos
+	 * @param fimTexto - Variável onde é colocado o fim dos bytes lidos (o intervalo fica mais curto caso o ficheiro não tenha todos os bytes)
+	 */
+	void lerTexto(const ParticaoArquivo &particao, unsigned long long inicio, unsigned long long fim, std::string &copia, const char* &inicioTexto, const char* &fimTexto) const;
+
+	/**
+	 * @brief Lê todos os registos de um bloco de uma partição (do ficheiro e/ou dos registos ainda por escrever)
+	 * @param particao - Partição do bloco
+	 * @param bloco - Bloco a ler
+	 * @return Retorna os registos do bloco
+	 */
+	std::vector<RegistoArquivo> lerBloco(const ParticaoArquivo &particao, const BlocoArquivo &bloco) const;
+public:
+	/**
+	 * @brief Construtor da classe ArquivoAcidentes
+	 * @param ficheiroAcidentes - Nome do ficheiro de acidentes, usado como prefixo dos ficheiros do arquivo
+	 * @param modoVerificacao - Momento em que os checksums dos blocos indexados são verificados
+	 */
+	ArquivoAcidentes(const std::string &ficheiroAcidentes, ModoVerificacao modoVerificacao = VERIFICAR_AO_LER);
+
+	/**
+	 * @brief Abre o arquivo, lendo o manifesto e o índice esparso de cada partição, lançando a exceção DadosCorrompidos caso seja encontrado um registo ou bloco corrompido
+	 */
+	void abrir();
+
+	/**
+	 * @brief Acrescenta um acidente terminado ao arquivo (na partição do ano em que ocorreu). O registo só fica no disco na próxima sincronização
+	 * @param acidente - Acidente terminado
+	 * @param seq - Número de sequência (no diário) do registo do seu término
+	 */
+	void adicionar(const Acidente* acidente, unsigned long long seq);
+
+	/**
+	 * @brief Acrescenta um acidente terminado ao arquivo, a partir da sua entrada no formato do ficheiro de acidentes
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @param entrada - Entrada do acidente no formato do ficheiro de acidentes
+	 * @param seq - Número de sequência (no diário) do registo do seu término
+	 */
+	void adicionar(unsigned int numOcorrencia, const std::string &entrada, unsigned long long seq);
+
+	/**
+	 * @brief Atualiza o manifesto, escreve os registos pendentes, sincroniza as partições com o disco (fsync) e acrescenta aos índices os blocos completos, lançando a exceção ErroEscrita em caso de falha
+	 */
+	void sincronizar();
+
+	/**
+	 * @brief Procura no arquivo os acidentes com um dado número de ocorrência, lendo apenas os blocos cujo intervalo de números o inclui
+	 * @param numOcorrencia - Número de ocorrência a procurar
+	 * @return Retorna os registos encontrados, pela ordem em que foram arquivados
+	 */
+	std::vector<RegistoArquivo> procurarNumero(unsigned int numOcorrencia) const;
+
+	/**
+	 * @brief Procura no arquivo os acidentes ocorridos num intervalo de datas, lendo apenas as partições desses anos e os blocos cujo intervalo de datas o interseta
+	 * @param inicio - Data inicial (inclusive)
+	 * @param fim - Data final (inclusive)
+	 * @return Retorna os registos encontrados, por ano
+	 */
+	std::vector<RegistoArquivo> procurarIntervalo(const Date &inicio, const Date &fim) const;
+
+	/**
+	 * @brief Procura os blocos cujo intervalo de números de ocorrência inclui um dado número (apenas com o índice esparso, sem ler ficheiros)
+	 * @param numOcorrencia - Número de ocorrência a procurar
+	 * @return Retorna as referências dos blocos que podem conter o número
+	 */
+	std::vector<ReferenciaBloco> procurarBlocos(unsigned int numOcorrencia) const;
+
+	/**
+	 * @brief Lê as posições dos registos de um bloco, sem interpretar as entradas dos acidentes
+	 * @param bloco - Referência do bloco
+	 * @return Retorna as posições dos registos do bloco
+	 */
+	std::vector<PosicaoRegisto> lerPosicoes(const ReferenciaBloco &bloco) const;
+
+	/**
+	 * @brief Permite obter as referências de todos os blocos do arquivo (por ano e por ordem no ficheiro), para percorrer o arquivo bloco a bloco
+	 * @return Retorna as referências de todos os blocos
+	 */
+	std::vector<ReferenciaBloco> getBlocos() const;
+
+	/**
+	 * @brief Lê todos os registos de um bloco
+	 * @param bloco - Referência do bloco
+	 * @return Retorna os registos do bloco, pela ordem em que foram arquivados (vazio caso o bloco não exista)
+	 */
+	std::vector<RegistoArquivo> lerBloco(const ReferenciaBloco &bloco) const;
+
+	/**
+	 * @brief Lê um único registo do arquivo, a partir da sua posição
+	 * @param posicao - Posição do registo
+	 * @param registo - Variável onde é colocado o registo lido
+	 * @return Retorna true caso o registo tenha sido lido e false caso contrário
+	 */
+	bool lerRegisto(const PosicaoRegisto &posicao, RegistoArquivo &registo) const;
+
+	/**
+	 * @brief Permite obter o maior número de sequência arquivado (os registos do diário até este número já estão no arquivo)
+	 * @return Retorna o maior número de sequência arquivado
+	 */
+	unsigned long long getUltimoSeq() const;
+
+	/**
+	 * @brief Permite obter o número de acidentes arquivados
+	 * @return Retorna o número de registos do arquivo
+	 */
+	unsigned int getNumRegistos() const;
+};
+
+#endif /* ARQUIVOACIDENTES_H_ */
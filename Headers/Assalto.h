@@ -50,10 +50,17 @@ public:
 	void printInfoAcidente() const;
 
 	/**
-	 * @brief Imprime numa stream o conteudo simplificado de um Assalto
-	 * @param os - Stream para a qual o conteúdo do Assalto é impresso
+	 * @brief Escreve num buffer de escrita o conteudo simplificado de um Assalto
+	 * @param buf - Buffer para o qual o conteúdo do Assalto é escrito
 	 */
-	void printSimplifiedInfo(std::ostream & os) const;
+	void serializar(BufferEscrita & buf) const;
+
+	/**
+	 * @brief Permite obter as necessidades do assalto (ver NecessidadesAcidente<Assalto>)
+	 * @param necessidades - Onde são colocadas as necessidades
+	 * @return Retorna o número de necessidades colocadas
+	 */
+	unsigned int getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const;
 };
 
 #endif /* ASSALTO_H_ */
@@ -2,7 +2,7 @@
 #define ATRIBUICAO_H_
 #include <iostream>
 #include <string>
-#include "Posto.h"
+#include "BufferEscrita.h"
 
 /**
  * Representa uma atribuição de meios de um posto para um acidente.
@@ -64,6 +64,14 @@ public:
 	 * @return Retorna referência de stream de output
 	 */
 	friend std::ostream & operator<<(std::ostream & os, const Atribuicao& atribuicao);
+
+	/**
+	 * @brief Overload do operador de inserção num buffer de escrita para a classe Atribuicao
+	 * @param buf - Buffer passado por referência para o qual será efetuada a escrita
+	 * @param atribuicao - Atribuição a ser escrita no buffer
+	 * @return Retorna referência do buffer de escrita
+	 */
+	friend BufferEscrita & operator<<(BufferEscrita & buf, const Atribuicao& atribuicao);
 };
 
 
@@ -0,0 +1,165 @@
+#ifndef BITMAPCOMPRIMIDO_H_
+#define BITMAPCOMPRIMIDO_H_
+#include <vector>
+#include <cstdint>
+
+/**
+ * Conjunto comprimido de inteiros (ao estilo "roaring bitmap"), utilizado para indexar acidentes pela sua linha (ver IndiceAcidentes).
+ * O espaço de valores é dividido em blocos de 2^16 valores; cada bloco é guardado como um vetor ordenado (poucos elementos) ou como um mapa de bits (muitos elementos).
+ */
+class BitmapComprimido {
+private:
+	/**
+	 * Bloco de 2^16 valores consecutivos do bitmap
+	 */
+	struct Contentor {
+		uint16_t chave;					/**< 16 bits mais significativos comuns a todos os valores do bloco 				*/
+		bool denso;						/**< Indica se o bloco está guardado como mapa de bits (true) ou como vetor (false)	*/
+		unsigned int cardinalidade;		/**< Número de valores presentes no bloco 											*/
+		std::vector<uint16_t> valores;	/**< 16 bits menos significativos dos valores, por ordem crescente (bloco esparso)	*/
+		std::vector<uint64_t> palavras;	/**< Mapa de bits com 1024 palavras de 64 bits (bloco denso)						*/
+	};
+
+	static const unsigned int LIMITE_ESPARSO = 4096;	/**< Número máximo de valores de um bloco esparso antes de passar a denso */
+	static const unsigned int NUM_PALAVRAS = 1024;		/**< Número de palavras de 64 bits de um bloco denso */
+
+	std::vector<Contentor> contentores;		/**< Blocos do bitmap, ordenados pela chave */
+
+	/**
+	 * @brief Procura o índice do bloco com uma dada chave
+	 * @param chave - Chave do bloco a procurar
+	 * @return Retorna o índice do primeiro bloco com chave maior ou igual a 'chave'
+	 */
+	unsigned int procurarContentor(uint16_t chave) const;
+
+	/**
+	 * @brief Converte um bloco esparso num bloco denso
+	 * @param contentor - Bloco a converter
+	 */
+	static void tornarDenso(Contentor &contentor);
+
+	/**
+	 * @brief Converte um bloco denso num bloco esparso, caso tenha poucos elementos
+	 * @param contentor - Bloco a converter
+	 */
+	static void tornarEsparso(Contentor &contentor);
+
+	/**
+	 * @brief Indica se um valor de 16 bits pertence a um bloco
+	 */
+	static bool contentorContem(const Contentor &contentor, uint16_t valor);
+
+	/**
+	 * @brief Calcula a interseção de dois blocos com a mesma chave
+	 */
+	static Contentor interseccao(const Contentor &c1, const Contentor &c2);
+
+	/**
+	 * @brief Calcula a união de dois blocos com a mesma chave
+	 */
+	static Contentor uniao(const Contentor &c1, const Contentor &c2);
+
+	/**
+	 * @brief Calcula a diferença (c1 \ c2) de dois blocos com a mesma chave
+	 */
+	static Contentor diferenca(const Contentor &c1, const Contentor &c2);
+
+	/**
+	 * @brief Conta os elementos da interseção de dois blocos sem a construir
+	 */
+	static unsigned int contarInterseccao(const Contentor &c1, const Contentor &c2);
+public:
+	/**
+	 * @brief Construtor da classe BitmapComprimido, cria um bitmap vazio
+	 */
+	BitmapComprimido();
+
+	/**
+	 * @brief Adiciona um valor ao bitmap
+	 * @param valor - Valor a adicionar
+	 */
+	void adicionar(unsigned int valor);
+
+	/**
+	 * @brief Remove um valor do bitmap
+	 * @param valor - Valor a remover
+	 */
+	void remover(unsigned int valor);
+
+	/**
+	 * @brief Indica se um valor pertence ao bitmap
+	 * @param valor - Valor a procurar
+	 * @return Retorna true caso o valor pertença ao bitmap e false caso contrário
+	 */
+	bool contem(unsigned int valor) const;
+
+	/**
+	 * @brief Permite obter o número de valores do bitmap
+	 * @return Retorna o número de valores presentes no bitmap
+	 */
+	unsigned int cardinalidade() const;
+
+	/**
+	 * @brief Indica se o bitmap está vazio
+	 * @return Retorna true caso o bitmap não tenha quaisquer valores
+	 */
+	bool vazio() const;
+
+	/**
+	 * @brief Permite obter todos os valores do bitmap
+	 * @return Retorna um vetor com todos os valores do bitmap, por ordem crescente
+	 */
+	std::vector<unsigned int> getValores() const;
+
+	/**
+	 * @brief Percorre todos os valores do bitmap, por ordem crescente, sem os copiar para um vetor
+	 * @param funcao - Função chamada com cada valor
+	 */
+	template <class Funcao>
+	void percorrer(Funcao funcao) const;
+
+	/**
+	 * @brief Conta os valores comuns a este bitmap e a outro, sem construir a interseção
+	 * @param outro - Bitmap com o qual é feita a interseção
+	 * @return Retorna o número de valores comuns aos dois bitmaps
+	 */
+	unsigned int contarInterseccao(const BitmapComprimido &outro) const;
+
+	/**
+	 * @brief Operador & para calcular a interseção de dois bitmaps (AND)
+	 */
+	BitmapComprimido operator&(const BitmapComprimido &outro) const;
+
+	/**
+	 * @brief Operador | para calcular a união de dois bitmaps (OR)
+	 */
+	BitmapComprimido operator|(const BitmapComprimido &outro) const;
+
+	/**
+	 * @brief Operador - para calcular a diferença de dois bitmaps (AND NOT)
+	 */
+	BitmapComprimido operator-(const BitmapComprimido &outro) const;
+};
+
+template <class Funcao>
+void BitmapComprimido::percorrer(Funcao funcao) const{
+	for (unsigned int i=0 ; i<contentores.size() ; i++){
+		unsigned int alto = (unsigned int)contentores[i].chave << 16;
+		if (contentores[i].denso){
+			for (unsigned int j=0 ; j<NUM_PALAVRAS ; j++){
+				uint64_t palavra = contentores[i].palavras[j];
+				while (palavra != 0){
+					funcao(alto + (j << 6) + __builtin_ctzll(palavra));
+					palavra &= palavra - 1;
+				}
+			}
+		}
+		else {
+			for (unsigned int j=0 ; j<contentores[i].valores.size() ; j++){
+				funcao(alto + contentores[i].valores[j]);
+			}
+		}
+	}
+}
+
+#endif /* BITMAPCOMPRIMIDO_H_ */
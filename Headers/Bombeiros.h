@@ -7,8 +7,8 @@
  */
 class Bombeiros : public Posto {
 private:
-	unsigned int numAutotanques;		/**< Número de Autotanques neste Posto dos Bombeiros */
-	unsigned int numAmbulancias;;		/**< Número de Ambulancias neste Posto dos Bombeiros */
+	std::atomic<unsigned int> numAutotanques;		/**< Número de Autotanques neste Posto dos Bombeiros */
+	std::atomic<unsigned int> numAmbulancias;		/**< Número de Ambulancias neste Posto dos Bombeiros */
 public:
 	/**
 	 * @brief Construtor da classe Bombeiros
@@ -51,6 +51,22 @@ public:
 	 */
 	bool rmAmbulancias(unsigned int num);
 
+	/**
+	 * @brief Reserva, se possível, um certo número de autotanques do posto juntamente com os bombeiros que os tripulam (tudo ou nada, sem trincos).
+	 * @param quantidadeAutotanques - Número de autotanques a reservar.
+	 * @param quantidadeSocorristas - Número de bombeiros a reservar.
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário (o posto fica como estava).
+	 */
+	bool reservarAutotanques(unsigned int quantidadeAutotanques, unsigned int quantidadeSocorristas);
+
+	/**
+	 * @brief Reserva, se possível, um certo número de ambulâncias do posto juntamente com os bombeiros que as tripulam (tudo ou nada, sem trincos).
+	 * @param quantidadeAmbulancias - Número de ambulâncias a reservar.
+	 * @param quantidadeSocorristas - Número de bombeiros a reservar.
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário (o posto fica como estava).
+	 */
+	bool reservarAmbulancias(unsigned int quantidadeAmbulancias, unsigned int quantidadeSocorristas);
+
 	/**
 	 * @brief Permite obter o número de autotanques presentes no posto
 	 * @return Retorna o número de autotanques
@@ -69,16 +85,23 @@ public:
 	 */
 	std::string getTipoPosto() const;
 
+	/**
+	 * @brief Permite obter o tipo dos veículos que este posto envia para um tipo de recurso
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna "Autotanque" para AUTOTANQUES e "Ambulancia" para os restantes
+	 */
+	std::string getTipoVeiculos(ResultadoDespacho::TipoRecurso recurso) const;
+
 	/**
 	 * @brief Imprime no ecrã toda a informação sobre este posto dos Bombeiros
 	 */
 	void printInfoPosto() const;
 
 	/**
-	 * @brief Imprime numa stream o conteudo simplificado de um posto dos Bombeiros
-	 * @param os - Stream para a qual o conteúdo do posto de Bombeiros é impresso
+	 * @brief Escreve num buffer de escrita o conteudo simplificado de um posto dos Bombeiros
+	 * @param buf - Buffer para o qual o conteúdo do posto de Bombeiros é escrito
 	 */
-	void printSimplifiedInfo(std::ostream & os) const;
+	void serializar(BufferEscrita & buf) const;
 };
 
 #endif /* BOMBEIROS_H_ */
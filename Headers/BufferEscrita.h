@@ -0,0 +1,106 @@
+#ifndef BUFFERESCRITA_H_
+#define BUFFERESCRITA_H_
+#include <string>
+#include <vector>
+#include <iostream>
+
+/**
+ * Buffer de escrita reutilizável. O texto é formatado diretamente num vetor de bytes (sem criar strings temporárias) e enviado para a stream de destino em blocos grandes.
+ */
+class BufferEscrita {
+private:
+	std::ostream &destino;			/**< Stream para a qual o conteúdo do buffer é enviado 				*/
+	std::vector<char> dados;		/**< Conteúdo ainda por enviar										*/
+	unsigned int usado;				/**< Número de bytes de 'dados' ocupados							*/
+
+	/**
+	 * @brief Garante que há espaço no buffer para mais 'num' bytes, enviando o conteúdo atual para o destino caso necessário
+	 * @param num - Número de bytes a escrever
+	 */
+	void reservar(unsigned int num) {
+		if (usado + num > dados.size()){
+			flush();
+			if (num > dados.size())
+				dados.resize(num);
+		}
+	}
+public:
+	/**
+	 * @brief Construtor da classe BufferEscrita
+	 * @param destino - Stream para a qual o conteúdo do buffer é enviado
+	 * @param capacidade - Tamanho do buffer, em bytes
+	 */
+	BufferEscrita(std::ostream &destino, unsigned int capacidade = 1 << 20);
+
+	/**
+	 * @brief Destrutor da classe BufferEscrita, envia para o destino o conteúdo ainda no buffer
+	 */
+	~BufferEscrita();
+
+	/**
+	 * @brief Escreve um caráter no buffer
+	 */
+	BufferEscrita & operator<<(char c) {
+		reservar(1);
+		dados[usado++] = c;
+		return *this;
+	}
+
+	/**
+	 * @brief Escreve uma string no buffer
+	 */
+	BufferEscrita & operator<<(const std::string &texto) {
+		escrever(texto.data(), texto.size());
+		return *this;
+	}
+
+	/**
+	 * @brief Escreve uma string terminada em '\0' no buffer
+	 */
+	BufferEscrita & operator<<(const char* texto);
+
+	/**
+	 * @brief Escreve um número inteiro (em decimal) no buffer
+	 */
+	BufferEscrita & operator<<(unsigned int num) {
+		escreverNumero(num, 1);
+		return *this;
+	}
+
+	/**
+	 * @brief Escreve um número inteiro (em decimal) no buffer, como o tamanho de um vetor
+	 */
+	BufferEscrita & operator<<(unsigned long num) {
+		escreverNumero(num, 1);
+		return *this;
+	}
+
+	/**
+	 * @brief Escreve um número inteiro de 64 bits (em decimal) no buffer
+	 */
+	BufferEscrita & operator<<(unsigned long long num) {
+		escreverNumero(num, 1);
+		return *this;
+	}
+
+	/**
+	 * @brief Escreve um conjunto de bytes no buffer
+	 * @param texto - Início dos bytes a escrever
+	 * @param tamanho - Número de bytes a escrever
+	 */
+	void escrever(const char* texto, unsigned int tamanho);
+
+	/**
+	 * @brief Escreve um número inteiro (em decimal) no buffer, preenchido com zeros à esquerda até ter pelo menos 'largura' dígitos
+	 * @param num - Número a escrever
+	 * @param largura - Número mínimo de dígitos
+	 */
+	void escreverNumero(unsigned long long num, unsigned int largura);
+
+	/**
+	 * @brief Envia o conteúdo do buffer para a stream de destino
+	 */
+	void flush();
+};
+
+#endif /* BUFFERESCRITA_H_ */
@@ -0,0 +1,152 @@
+#ifndef CODIFICADORARQUIVO_H_
+#define CODIFICADORARQUIVO_H_
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "DescritorAcidente.h"
+
+/**
+ * Acidente terminado lido do arquivo
+ */
+struct RegistoArquivo {
+	unsigned int numOcorrencia;			/**< Número de ocorrência do acidente								*/
+	unsigned long long seq;				/**< Número de sequência (no diário) do registo do seu término	*/
+	DescritorAcidente descritor;		/**< Descrição do acidente, com as suas atribuições				*/
+};
+
+/**
+ * Valores de referência de um bloco do arquivo: o número de ocorrência, o número de sequência e a data de cada registo são codificados como diferenças em relação a estes valores
+ * (os do primeiro registo do bloco; o primeiro registo é codificado em relação a zero)
+ */
+struct BaseBloco {
+	unsigned int numOcorrencia;			/**< Número de ocorrência de referência							*/
+	unsigned long long seq;				/**< Número de sequência de referência								*/
+	uint32_t data;						/**< Data (compactada) de referência								*/
+};
+
+/**
+ * Dicionário de texto do arquivo: os nomes dos locais, os tipos de veículos, de casa e de estrada são guardados nos registos como identificadores numéricos.
+ * O dicionário só cresce: cada valor novo é acrescentado ao fim do ficheiro e o seu identificador é a sua posição.
+ *
+ * O ficheiro começa pelo cabeçalho "DICIONARIO V2", seguido de um valor por linha, precedido do seu CRC32C (8 dígitos hexadecimais e um espaço), tal como os registos do diário e do arquivo:
+ * uma escrita interrompida deixaria os identificadores seguintes a apontar para textos errados sem que os registos o detetassem.
+ * Um dicionário da versão 1 (sem cabeçalho nem CRC) é reescrito no formato atual ao ser aberto.
+ */
+class DicionarioArquivo {
+private:
+	static const std::string CABECALHO;				/**< Primeira linha do ficheiro (versão do formato)							*/
+
+	const std::string ficheiro;						/**< Nome do ficheiro do dicionário										*/
+	std::vector<std::string> valores;				/**< Valores do dicionário, por identificador								*/
+	std::map<std::string, unsigned int> ids;		/**< Identificador de cada valor											*/
+	unsigned int numGravados;						/**< Número de valores já escritos no ficheiro								*/
+	bool temCabecalho;								/**< Indica se o ficheiro já existe com o cabeçalho							*/
+public:
+	/**
+	 * @brief Construtor da classe DicionarioArquivo
+	 * @param ficheiro - Nome do ficheiro do dicionário
+	 */
+	DicionarioArquivo(const std::string &ficheiro);
+
+	/**
+	 * @brief Lê o ficheiro do dicionário, descartando uma última entrada incompleta ou com o CRC errado (escrita interrompida).
+	 * Uma entrada com o CRC errado seguida de outras lança a exceção DadosCorrompidos
+	 */
+	void abrir();
+
+	/**
+	 * @brief Permite obter o identificador de um valor, acrescentando-o ao dicionário caso ainda não exista
+	 * @param valor - Valor a procurar
+	 * @return Retorna o identificador do valor
+	 */
+	unsigned int obterId(const std::string &valor);
+
+	/**
+	 * @brief Permite obter o valor de um identificador, lançando a exceção DadosCorrompidos caso o identificador não exista
+	 * @param id - Identificador do valor
+	 * @return Retorna o valor
+	 */
+	const std::string & getValor(unsigned long long id) const;
+
+	/**
+	 * @brief Escreve no ficheiro os valores novos e sincroniza-o com o disco, lançando a exceção ErroEscrita em caso de falha
+	 */
+	void sincronizar();
+
+	/**
+	 * @brief Permite obter o número de valores do dicionário
+	 * @return Retorna o número de valores
+	 */
+	unsigned int getNumValores() const;
+};
+
+/**
+ * Codificação binária compacta dos registos do arquivo. Cada registo tem o formato:
+ *   tamanho (varint) , CRC32C do conteúdo (4 bytes, little-endian) , conteúdo com 'tamanho' bytes:
+ *   numOcorrencia, seq e data (diferenças em relação à base do bloco, varint zigzag) , tipo (1 byte) , local (id no dicionário) ,
+ *   campos do tipo de acidente (varint ou id no dicionário) , número de atribuições (varint) e, para cada atribuição,
+ *   o número do posto (diferença em relação à atribuição anterior, varint zigzag), o tipo de veículo (id no dicionário), o número de socorristas e de veículos (varint)
+ * Os registos são codificados e descodificados um a um, à medida que são escritos ou lidos, sem ter todo o bloco em memória.
+ */
+class CodificadorArquivo {
+public:
+	/**
+	 * @brief Acrescenta um inteiro sem sinal num texto, em formato varint (7 bits por byte, o bit mais significativo indica que há mais bytes)
+	 * @param saida - Texto onde é acrescentado o inteiro
+	 * @param valor - Valor a escrever
+	 */
+	static void escreverVarint(std::string &saida, unsigned long long valor);
+
+	/**
+	 * @brief Lê um inteiro sem sinal em formato varint
+	 * @param pos - Posição de início do inteiro; no fim aponta para o byte seguinte
+	 * @param fim - Fim do texto
+	 * @param valor - Variável onde é colocado o valor lido
+	 * @return Retorna true caso o inteiro esteja completo e false caso contrário
+	 */
+	static bool lerVarint(const char* &pos, const char* fim, unsigned long long &valor);
+
+	/**
+	 * @brief Codifica um acidente e acrescenta o registo (tamanho, CRC32C e conteúdo) a um texto
+	 * @param registo - Acidente a codificar, com o seu número de ocorrência e de sequência
+	 * @param base - Valores de referência do bloco do registo
+	 * @param dicionario - Dicionário do arquivo (os valores novos são acrescentados)
+	 * @param saida - Texto onde é acrescentado o registo
+	 */
+	static void codificar(const RegistoArquivo &registo, const BaseBloco &base, DicionarioArquivo &dicionario, std::string &saida);
+
+	/**
+	 * @brief Lê o cabeçalho de um registo (tamanho e CRC32C), sem descodificar o conteúdo
+	 * @param pos - Posição de início do registo; no fim aponta para o início do conteúdo
+	 * @param fim - Fim do texto
+	 * @param tamanho - Variável onde é colocado o tamanho do conteúdo, em bytes
+	 * @param checksum - Variável onde é colocado o CRC32C do conteúdo
+	 * @return Retorna true caso o cabeçalho e o conteúdo estejam completos e false caso contrário
+	 */
+	static bool lerCabecalho(const char* &pos, const char* fim, unsigned long long &tamanho, uint32_t &checksum);
+
+	/**
+	 * @brief Descodifica apenas o número de ocorrência e o número de sequência do conteúdo de um registo
+	 * @param pos - Início do conteúdo
+	 * @param fim - Fim do conteúdo
+	 * @param base - Valores de referência do bloco do registo
+	 * @param numOcorrencia - Variável onde é colocado o número de ocorrência
+	 * @param seq - Variável onde é colocado o número de sequência
+	 * @return Retorna true em caso de sucesso e false caso o conteúdo esteja incompleto
+	 */
+	static bool descodificarIdentificacao(const char* pos, const char* fim, const BaseBloco &base, unsigned int &numOcorrencia, unsigned long long &seq);
+
+	/**
+	 * @brief Descodifica o conteúdo de um registo
+	 * @param pos - Início do conteúdo
+	 * @param fim - Fim do conteúdo
+	 * @param base - Valores de referência do bloco do registo
+	 * @param dicionario - Dicionário do arquivo
+	 * @param registo - Variável onde é colocado o registo descodificado
+	 * @return Retorna true em caso de sucesso e false caso o conteúdo esteja incompleto ou seja inválido
+	 */
+	static bool descodificar(const char* pos, const char* fim, const BaseBloco &base, const DicionarioArquivo &dicionario, RegistoArquivo &registo);
+};
+
+#endif /* CODIFICADORARQUIVO_H_ */
@@ -0,0 +1,46 @@
+#ifndef CRC32C_H_
+#define CRC32C_H_
+#include <cstdint>
+
+/**
+ * Cálculo do CRC32C (polinómio de Castagnoli), usado para detetar corrupção nos registos do diário, nos segmentos de checkpoint e no arquivo.
+ * Em processadores x86 com SSE4.2 é usada a instrução crc32 (8 bytes por instrução); nos restantes é usada uma tabela de 256 entradas.
+ * O CRC pode ser calculado por partes: o resultado de uma chamada é passado como valor inicial da seguinte.
+ */
+class Crc32c {
+private:
+	/**
+	 * @brief Calcula o CRC32C com a tabela (implementação portável)
+	 * @param crc - CRC dos dados anteriores
+	 * @param dados - Início dos dados
+	 * @param tamanho - Tamanho dos dados, em bytes
+	 * @return Retorna o CRC atualizado
+	 */
+	static uint32_t calcularTabela(uint32_t crc, const char* dados, unsigned long long tamanho);
+
+	/**
+	 * @brief Calcula o CRC32C com as instruções SSE4.2
+	 * @param crc - CRC dos dados anteriores
+	 * @param dados - Início dos dados
+	 * @param tamanho - Tamanho dos dados, em bytes
+	 * @return Retorna o CRC atualizado
+	 */
+	static uint32_t calcularHardware(uint32_t crc, const char* dados, unsigned long long tamanho);
+public:
+	/**
+	 * @brief Calcula o CRC32C de um conjunto de bytes, usando as instruções SSE4.2 caso o processador as suporte
+	 * @param dados - Início dos dados
+	 * @param tamanho - Tamanho dos dados, em bytes
+	 * @param crc - CRC dos dados anteriores, caso o cálculo seja feito por partes (0 para começar)
+	 * @return Retorna o CRC32C dos dados
+	 */
+	static uint32_t calcular(const char* dados, unsigned long long tamanho, uint32_t crc = 0);
+
+	/**
+	 * @brief Verifica se o CRC32C é calculado com as instruções SSE4.2
+	 * @return Retorna true caso o processador suporte SSE4.2 e false caso contrário
+	 */
+	static bool temSuporteHardware();
+};
+
+#endif /* CRC32C_H_ */
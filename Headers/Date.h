@@ -1,6 +1,7 @@
 #ifndef DATE_H_
 #define DATE_H_
 #include <string>
+#include "BufferEscrita.h"
 
 /**
  * Classe Data utilizada para comparar datas de ocorrencias.
@@ -58,6 +59,14 @@ public:
 	 * @brief Destrutor da classe Date.
 	 */
 	~Date();
+
+	/**
+	 * @brief Overload do operador de inserção num buffer de escrita para a classe Date, escrevendo a data no formato DD-MM-AAAA sem criar strings temporárias.
+	 * @param buf - Buffer para o qual é escrita a data.
+	 * @param data - Data a escrever.
+	 * @return Retorna referência do buffer de escrita.
+	 */
+	friend BufferEscrita & operator<<(BufferEscrita & buf, const Date &data);
 };
 
 #endif /* DATE_H_ */
@@ -0,0 +1,57 @@
+#ifndef DESCRITORACIDENTE_H_
+#define DESCRITORACIDENTE_H_
+#include <string>
+#include <vector>
+#include "Acidente.h"
+#include "Atribuicao.h"
+
+/**
+ * Descrição de um acidente ainda por criar, tal como aparece numa entrada do ficheiro de acidentes (com o local identificado apenas pelo nome).
+ * Permite ler e validar acidentes sem depender dos vetores da Proteção Civil, sendo os locais resolvidos e os acidentes criados posteriormente.
+ */
+struct DescritorAcidente {
+	std::string nomeLocal;					/**< Nome do local em que decorreu o acidente 									*/
+	std::string data;						/**< Data do acidente, no formato DD-MM-AAAA									*/
+	std::string tipo;						/**< Tipo de acidente, tal como no ficheiro: "Incendio", "Viacao" ou "Assalto"	*/
+	std::string tipoIncendio;				/**< Tipo de incêndio: "Florestal" ou "Domestico" (Incêndios)					*/
+	std::string tipoCasa;					/**< Tipo de casa (Assaltos e Incêndios Domésticos)								*/
+	std::string tipoEstrada;				/**< Tipo de estrada (Acidentes de Viação)										*/
+	unsigned int numAutotanquesNecess;		/**< Número de autotanques necessários (Incêndios)								*/
+	unsigned int numBombeirosNecess;		/**< Número de bombeiros necessários (Incêndios)								*/
+	unsigned int areaChamas;				/**< Área das chamas (Incêndios Florestais)										*/
+	unsigned int numFeridos;				/**< Número de feridos (Acidentes de Viação)									*/
+	unsigned int numVeiculos;				/**< Número de veículos envolvidos (Acidentes de Viação)						*/
+	bool haFeridos;							/**< Existência de feridos (Assaltos)											*/
+	std::vector<Atribuicao> atribuicoes;	/**< Atribuições de meios já efetuadas ao acidente								*/
+
+	/**
+	 * @brief Construtor da struct DescritorAcidente, com todos os campos numéricos a 0
+	 */
+	DescritorAcidente();
+
+	/**
+	 * @brief Lê uma entrada do ficheiro de acidentes (linha do acidente seguida das linhas das suas atribuições), lançando a exceção InputInvalido caso um campo numérico
+	 * esteja mal formado ou em falta, ou caso o tipo de acidente seja desconhecido
+	 * @param pos - Posição de início da entrada no texto; no fim aponta para o início da entrada seguinte (em caso de erro, aponta para a linha com o erro)
+	 * @param fim - Fim do texto
+	 * @param descritor - Descritor onde é colocado o conteúdo da entrada
+	 * @return Retorna true caso tenha sido lida uma entrada e false caso o texto tenha terminado
+	 */
+	static bool ler(const char* &pos, const char* fim, DescritorAcidente &descritor);
+
+	/**
+	 * @brief Verifica se o descritor representa um acidente válido (tipo conhecido e campos coerentes)
+	 * @return Retorna true caso o acidente seja válido e false caso contrário
+	 */
+	bool valido() const;
+
+	/**
+	 * @brief Cria o acidente descrito, incluindo as suas atribuições
+	 * @param local - Apontador para o local do acidente (já resolvido a partir de nomeLocal)
+	 * @param numOcorrencia - Número de ocorrência a atribuir ao acidente
+	 * @return Retorna um apontador para o acidente criado (alocado dinamicamente)
+	 */
+	Acidente* criarAcidente(const Local* local, unsigned int numOcorrencia) const;
+};
+
+#endif /* DESCRITORACIDENTE_H_ */
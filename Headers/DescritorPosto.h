@@ -0,0 +1,34 @@
+#ifndef DESCRITORPOSTO_H_
+#define DESCRITORPOSTO_H_
+#include <string>
+#include "Posto.h"
+
+/**
+ * Descrição de um posto ainda por criar, tal como aparece numa linha do ficheiro de postos (com o local identificado apenas pelo nome)
+ */
+struct DescritorPosto {
+	unsigned int id;				/**< Número de identificação do posto							*/
+	std::string nomeLocal;			/**< Nome do local em que o posto se encontra					*/
+	unsigned int numSocorristas;	/**< Número de socorristas do posto								*/
+	unsigned int numVeiculos;		/**< Número de veículos do posto								*/
+	std::string tipoPosto;			/**< Tipo de posto: "Policia", "Inem" ou "Bombeiros"			*/
+	std::string tipoVeiculo;		/**< Tipo de veículo (postos da Polícia e do Inem)				*/
+	unsigned int numAutotanques;	/**< Número de autotanques (postos dos Bombeiros)				*/
+	unsigned int numAmbulancias;	/**< Número de ambulâncias (postos dos Bombeiros)				*/
+
+	/**
+	 * @brief Lê uma linha do ficheiro de postos
+	 * @param line - Linha no formato id/local/socorristas/veiculos/tipo/...
+	 * @return Retorna o descritor do posto descrito na linha
+	 */
+	static DescritorPosto ler(std::string line);
+
+	/**
+	 * @brief Cria o posto descrito
+	 * @param local - Apontador para o local do posto (já resolvido a partir de nomeLocal)
+	 * @return Retorna um apontador para o posto criado (alocado dinamicamente)
+	 */
+	Posto* criarPosto(const Local* local) const;
+};
+
+#endif /* DESCRITORPOSTO_H_ */
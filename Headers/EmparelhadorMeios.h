@@ -0,0 +1,169 @@
+#ifndef EMPARELHADORMEIOS_H_
+#define EMPARELHADORMEIOS_H_
+#include <vector>
+#include <algorithm>
+#include "Posto.h"
+#include "Acidente.h"
+#include "AcidenteViacao.h"
+#include "Incendio.h"
+#include "Assalto.h"
+#include "MeiosPostos.h"
+#include "Necessidade.h"
+#include "ResultadoDespacho.h"
+
+/**
+ * Necessidades de cada tipo de acidente, pela ordem em que são supridas. Cada tipo de acidente especializa esta estrutura com o número de necessidades (NUM_NECESSIDADES)
+ * e a forma de as obter a partir do acidente (obter), e implementa Acidente::getNecessidades com EmparelhadorMeios::obterNecessidades; um novo tipo de acidente
+ * só precisa destas duas peças para ser despachado por EmparelhadorMeios::emparelhar, sem tocar em quem despacha.
+ */
+template <class TipoAcidente>
+struct NecessidadesAcidente;
+
+/**
+ * Necessidades de um acidente de viação: uma equipa médica por ferido.
+ */
+template <>
+struct NecessidadesAcidente<AcidenteViacao> {
+	static const unsigned int NUM_NECESSIDADES = 1;		/**< Número de necessidades		*/
+
+	/**
+	 * @brief Obtém as necessidades de um acidente de viação
+	 * @param acidente - Acidente de viação
+	 * @param necessidades - Onde são colocadas as necessidades
+	 */
+	static void obter(const AcidenteViacao* acidente, Necessidade necessidades[NUM_NECESSIDADES]){
+		necessidades[0] = Necessidade(ResultadoDespacho::EQUIPAS_MEDICAS, acidente->getNumFeridos());
+	}
+};
+
+/**
+ * Necessidades de um incêndio: autotanques, que levam também os bombeiros necessários (3 por autotanque).
+ */
+template <>
+struct NecessidadesAcidente<Incendio> {
+	static const unsigned int NUM_NECESSIDADES = 1;		/**< Número de necessidades		*/
+
+	/**
+	 * @brief Obtém as necessidades de um incêndio
+	 * @param acidente - Incêndio
+	 * @param necessidades - Onde são colocadas as necessidades
+	 */
+	static void obter(const Incendio* acidente, Necessidade necessidades[NUM_NECESSIDADES]){
+		unsigned int porBombeiros = (acidente->getNumBombeirosNecess() + 2) / 3;
+		unsigned int autotanques = acidente->getNumAutotanquesNecess();
+		necessidades[0] = Necessidade(ResultadoDespacho::AUTOTANQUES, (autotanques > porBombeiros ? autotanques : porBombeiros));
+	}
+};
+
+/**
+ * Necessidades de um assalto: uma equipa policial e, caso haja feridos, uma equipa médica.
+ */
+template <>
+struct NecessidadesAcidente<Assalto> {
+	static const unsigned int NUM_NECESSIDADES = 2;		/**< Número de necessidades		*/
+
+	/**
+	 * @brief Obtém as necessidades de um assalto
+	 * @param acidente - Assalto
+	 * @param necessidades - Onde são colocadas as necessidades
+	 */
+	static void obter(const Assalto* acidente, Necessidade necessidades[NUM_NECESSIDADES]){
+		necessidades[0] = Necessidade(ResultadoDespacho::EQUIPAS_POLICIAIS, 1);
+		necessidades[1] = Necessidade(ResultadoDespacho::EQUIPAS_MEDICAS, (acidente->haFeridos() ? 1 : 0));
+	}
+};
+
+/**
+ * Algoritmo guloso de despacho, comum a todos os tipos de acidente: cada necessidade do acidente é suprida pelos postos mais próximos, por ordem, com tantos veículos de cada posto
+ * quantos ainda faltarem (cada veículo só sai com a sua equipa completa). Todos os veículos que saem do mesmo posto para a mesma necessidade são reservados de uma só vez e formam uma única atribuição.
+ *
+ * O que muda de um tipo de acidente para outro são apenas as necessidades (NecessidadesAcidente), obtidas com uma única chamada virtual por acidente (Acidente::getNecessidades).
+ * O ciclo sobre os postos é sempre o mesmo (suprir) e é instanciado para o tipo concreto dos meios (MeiosReais ou TabelaCapacidades), pelo que não faz chamadas virtuais;
+ * decide se um posto fornece o recurso com uma leitura da sua tabela de tripulações, sem comparar strings nem converter o tipo do posto.
+ */
+class EmparelhadorMeios {
+public:
+	/**
+	 * @brief Obtém as necessidades de um acidente a partir da especialização de NecessidadesAcidente do seu tipo (usado pelas implementações de Acidente::getNecessidades)
+	 * @param acidente - Acidente
+	 * @param necessidades - Onde são colocadas as necessidades
+	 * @return Retorna o número de necessidades colocadas
+	 */
+	template <class TipoAcidente>
+	static unsigned int obterNecessidades(const TipoAcidente* acidente, Necessidade necessidades[Acidente::MAX_NECESSIDADES]);
+
+	/**
+	 * @brief Supre uma necessidade de um acidente com os meios dos postos, por ordem de preferência
+	 * @param acidente - Acidente a que são acrescentadas as atribuições
+	 * @param necessidade - Necessidade a suprir
+	 * @param ordem - Postos por ordem de preferência (distância crescente ao local do acidente)
+	 * @param meios - Meios de onde são reservados os veículos e as equipas (MeiosReais ou TabelaCapacidades)
+	 * @return Retorna o número de unidades atribuídas (no máximo as necessárias)
+	 */
+	template <class Meios>
+	static unsigned int suprir(Acidente* acidente, const Necessidade &necessidade, const std::vector<Posto*> &ordem, Meios &meios);
+
+	/**
+	 * @brief Atribui a um acidente os meios para todas as suas necessidades (ver Acidente::getNecessidades)
+	 * @param acidente - Acidente
+	 * @param ordem - Postos por ordem de preferência (distância crescente ao local do acidente)
+	 * @param meios - Meios de onde são reservados os veículos e as equipas (MeiosReais ou TabelaCapacidades)
+	 * @return Retorna 0 se todas as necessidades foram supridas, 1 se apenas parte das necessidades foram supridas ou 2 caso não haja quaisquer meios para suprir as necessidades do acidente
+	 */
+	template <class Meios>
+	static unsigned short emparelhar(Acidente* acidente, const std::vector<Posto*> &ordem, Meios &meios);
+};
+
+template <class TipoAcidente>
+unsigned int EmparelhadorMeios::obterNecessidades(const TipoAcidente* acidente, Necessidade necessidades[Acidente::MAX_NECESSIDADES]){
+	static_assert(NecessidadesAcidente<TipoAcidente>::NUM_NECESSIDADES <= Acidente::MAX_NECESSIDADES, "Acidente::MAX_NECESSIDADES tem de cobrir todos os tipos de acidente");
+	NecessidadesAcidente<TipoAcidente>::obter(acidente, necessidades);
+	return NecessidadesAcidente<TipoAcidente>::NUM_NECESSIDADES;
+}
+
+template <class Meios>
+unsigned int EmparelhadorMeios::suprir(Acidente* acidente, const Necessidade &necessidade, const std::vector<Posto*> &ordem, Meios &meios){
+	unsigned int atribuidas = 0;
+
+	for (std::vector<Posto*>::const_iterator it = ordem.begin() ; it != ordem.end() && atribuidas < necessidade.unidades ; it++){
+		Posto* posto = *it;
+
+		// Postos que nao fornecem o recurso tem tripulacao 0
+		unsigned int tripulacao = posto->getTripulacao(necessidade.recurso);
+		if (tripulacao == 0)
+			continue;
+
+		// Cada veiculo sai com a sua equipa: do posto saem de uma so vez tantos veiculos quantos o posto pode enviar e ainda faltam
+		unsigned int falta = necessidade.unidades - atribuidas;
+		unsigned int doPosto = std::min(meios.getOferta(posto, necessidade.recurso), falta);
+		while (doPosto > 0 && !meios.reservar(posto, necessidade.recurso, doPosto, tripulacao * doPosto))
+			doPosto = std::min(meios.getOferta(posto, necessidade.recurso), falta);	// Outro despachante ficou entretanto com parte dos meios
+
+		if (doPosto > 0){
+			acidente->addAtribuicao(Atribuicao(posto->getId(), tripulacao * doPosto, doPosto, posto->getTipoVeiculos(necessidade.recurso)));
+			atribuidas += doPosto;
+		}
+	}
+
+	return atribuidas;
+}
+
+template <class Meios>
+unsigned short EmparelhadorMeios::emparelhar(Acidente* acidente, const std::vector<Posto*> &ordem, Meios &meios){
+	Necessidade necessidades[Acidente::MAX_NECESSIDADES];
+	unsigned int numNecessidades = acidente->getNecessidades(necessidades);
+
+	bool supridas = true;
+	unsigned int atribuidas = 0;
+	for (unsigned int i=0 ; i<numNecessidades ; i++){
+		unsigned int unidades = suprir(acidente, necessidades[i], ordem, meios);
+		supridas = supridas && (unidades == necessidades[i].unidades);
+		atribuidas += unidades;
+	}
+
+	if (supridas)
+		return 0;	// Todas as necessidades foram supridas
+	return (atribuidas != 0 ? 1 : 2);
+}
+
+#endif /* EMPARELHADORMEIOS_H_ */
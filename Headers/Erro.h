@@ -126,4 +126,30 @@ public:
 	MeiosInexistentes(const std::string &info) : Erro(info) { }
 };
 
+
+
+/**
+ * Classe utilizada para lançar exceções do tipo Erro de Escrita (falha ao gravar um ficheiro)
+ */
+class ErroEscrita : public Erro {
+public:
+	/**
+	 * @brief Construtor da classe ErroEscrita
+	 */
+	ErroEscrita(const std::string &info) : Erro(info) { }
+};
+
+
+
+/**
+ * Classe utilizada para lançar exceções do tipo Dados Corrompidos (o checksum de um registo ou bloco gravado não corresponde ao seu conteúdo)
+ */
+class DadosCorrompidos : public Erro {
+public:
+	/**
+	 * @brief Construtor da classe DadosCorrompidos
+	 */
+	DadosCorrompidos(const std::string &info) : Erro(info) { }
+};
+
 #endif /* ERRO_H_ */
@@ -0,0 +1,110 @@
+#ifndef ESCRITORPERSISTENCIA_H_
+#define ESCRITORPERSISTENCIA_H_
+#include <string>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "RegistoAlteracao.h"
+#include "Erro.h"
+
+/**
+ * Escritor do diário de alterações, numa thread dedicada. Os registos são recebidos por uma fila limitada e escritos no diário em lotes (group commit):
+ * cada escrita no disco leva todos os registos que se acumularam enquanto a anterior decorria, pelo que quem submete não espera pelo disco.
+ */
+class EscritorPersistencia {
+public:
+	/**
+	 * Modos de durabilidade do diário
+	 */
+	enum ModoDurabilidade {
+		ASSINCRONO,		/**< Os registos são escritos sem fsync: sobrevivem à terminação do programa, mas não a uma falha do sistema	*/
+		POR_LOTE,		/**< É feito um fsync depois de escrito cada lote de registos													*/
+		POR_OPERACAO	/**< É feito um fsync por registo e a submissão só retorna depois de o registo estar no disco					*/
+	};
+
+	static const unsigned int CAPACIDADE_FILA = 4096;	/**< Número máximo de registos à espera de serem escritos	*/
+private:
+	const std::string ficheiro;					/**< Nome do ficheiro do diário															*/
+	const ModoDurabilidade modo;				/**< Modo de durabilidade do diário														*/
+	const unsigned int capacidade;				/**< Número máximo de registos na fila														*/
+	const std::string cabecalho;				/**< Cabeçalho do diário (identifica a base sobre a qual os registos são escritos)			*/
+	int descritor;								/**< Descritor do ficheiro do diário, aberto em modo de acrescento							*/
+	std::deque< std::pair<unsigned long long, std::shared_ptr<const RegistoAlteracao> > > fila;	/**< Registos por escrever, com o seu número de sequência	*/
+	unsigned long long ultimoSubmetido;			/**< Número de sequência do último registo submetido										*/
+	unsigned long long ultimoGravado;			/**< Número de sequência do último registo escrito (e sincronizado, conforme o modo)		*/
+	bool aTerminar;								/**< Indica que a thread deve terminar depois de esvaziar a fila							*/
+	bool falhou;								/**< Indica que houve uma falha de escrita no diário										*/
+	std::mutex trinco;							/**< Protege a fila e os números de sequência												*/
+	std::condition_variable haRegistos;			/**< Sinaliza a thread de escrita de que há registos na fila (ou de que deve terminar)		*/
+	std::condition_variable haEspaco;			/**< Sinaliza quem submete de que há espaço na fila										*/
+	std::condition_variable gravado;			/**< Sinaliza quem espera de que mais registos foram escritos								*/
+	std::thread thread;							/**< Thread de escrita																		*/
+
+	/**
+	 * @brief Ciclo da thread de escrita: retira da fila todos os registos acumulados e escreve-os no diário de uma só vez
+	 */
+	void executar();
+
+	/**
+	 * @brief Escreve um conjunto de bytes no diário
+	 * @param dados - Conteúdo a escrever
+	 * @return Retorna true em caso de sucesso e false caso contrário
+	 */
+	bool escreverDiario(const std::string &dados);
+
+	/**
+	 * @brief Escreve o cabeçalho num diário vazio
+	 * @return Retorna true em caso de sucesso e false caso contrário
+	 */
+	bool escreverCabecalho();
+public:
+	/**
+	 * @brief Construtor da classe EscritorPersistencia, abre (e esvazia) o diário e inicia a thread de escrita, lançando a exceção ErroEscrita caso não seja possível abrir o diário
+	 * @param ficheiro - Nome do ficheiro do diário
+	 * @param modo - Modo de durabilidade
+	 * @param assinaturaBase - Assinatura do ficheiro de acidentes sobre o qual os registos são escritos
+	 * @param ultimoSeq - Número de sequência do último registo já gravado (a numeração continua a partir deste)
+	 * @param capacidade - Número máximo de registos na fila; quem submete espera caso a fila esteja cheia
+	 */
+	EscritorPersistencia(const std::string &ficheiro, ModoDurabilidade modo, unsigned long long assinaturaBase, unsigned long long ultimoSeq, unsigned int capacidade = CAPACIDADE_FILA);
+
+	/**
+	 * @brief Destrutor da classe EscritorPersistencia, escreve os registos ainda na fila e termina a thread de escrita
+	 */
+	~EscritorPersistencia();
+
+	/**
+	 * @brief Submete um registo para ser escrito no diário. No modo POR_OPERACAO só retorna depois de o registo estar no disco (caso 'aguardar' seja true)
+	 * @param registo - Registo a escrever
+	 * @param aguardar - No modo POR_OPERACAO, indica se se espera pela escrita (false quando quem submete um lote espera uma só vez pelo último registo, com aguardar)
+	 * @return Retorna o número de sequência atribuído ao registo
+	 */
+	unsigned long long submeter(const std::shared_ptr<const RegistoAlteracao> &registo, bool aguardar = true);
+
+	/**
+	 * @brief Espera até que todos os registos até um dado número de sequência tenham sido escritos, lançando a exceção ErroEscrita caso a escrita tenha falhado
+	 * @param seq - Número de sequência a esperar
+	 */
+	void aguardar(unsigned long long seq);
+
+	/**
+	 * @brief Espera que todos os registos submetidos sejam escritos e esvazia o diário (as alterações já estão gravadas noutro lado, ex: num checkpoint)
+	 */
+	void reiniciar();
+
+	/**
+	 * @brief Permite obter o modo de durabilidade do diário
+	 * @return Retorna o modo de durabilidade
+	 */
+	ModoDurabilidade getModo() const;
+
+	/**
+	 * @brief Permite obter o número de sequência do último registo submetido
+	 * @return Retorna o número de sequência do último registo submetido
+	 */
+	unsigned long long getUltimoSubmetido();
+};
+
+#endif /* ESCRITORPERSISTENCIA_H_ */
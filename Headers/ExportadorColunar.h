@@ -0,0 +1,122 @@
+#ifndef EXPORTADORCOLUNAR_H_
+#define EXPORTADORCOLUNAR_H_
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "DescritorAcidente.h"
+#include "FicheiroAtomico.h"
+#include "BufferEscrita.h"
+
+/**
+ * Exportação dos acidentes (em decurso e arquivados) e das suas atribuições para análise: cada campo é escrito num ficheiro próprio (uma coluna), de largura fixa,
+ * para que as ferramentas externas possam mapear em memória apenas as colunas de que precisam, sem interpretar as restantes.
+ * Os acidentes são acrescentados um a um (numa única passagem) e as colunas são escritas à medida, através de buffers, sem guardar os acidentes em memória.
+ *
+ * Ficheiros (para um prefixo "exp"):
+ *   exp.esquema , manifesto de texto, escrito no fim: "ESQUEMA versao", "ORDEM little-endian" e, para cada tabela, "TABELA nome numLinhas" seguido de uma linha "COLUNA nome tipo ficheiro" por coluna (ficheiro relativo ao diretório do manifesto)
+ *   exp.acidentes.COLUNA e exp.atribuicoes.COLUNA , valores da coluna, por ordem das linhas
+ *
+ * Tipos das colunas (inteiros sem sinal, little-endian):
+ *   u8, u32, u64 , um valor de largura fixa por linha
+ *   texto , bytes de todos os valores concatenados; o ficheiro "COLUNA.off" tem numLinhas+1 deslocamentos u64 (o valor da linha i está entre os deslocamentos i e i+1)
+ */
+class ExportadorColunar {
+public:
+	/**
+	 * Tipo dos valores de uma coluna
+	 */
+	enum TipoColuna { U8, U32, U64, TEXTO };
+
+	static const unsigned int VERSAO_ESQUEMA = 1;		/**< Versão do formato descrito no manifesto	*/
+private:
+	/**
+	 * Coluna a ser escrita: o ficheiro de valores (e, nas colunas de texto, o ficheiro de deslocamentos), com os respetivos buffers
+	 */
+	struct Coluna {
+		std::string tabela;									/**< Tabela da coluna ("acidentes" ou "atribuicoes")						*/
+		std::string nome;									/**< Nome da coluna															*/
+		TipoColuna tipo;									/**< Tipo dos valores da coluna												*/
+		std::unique_ptr<FicheiroAtomico> dados;				/**< Ficheiro dos valores													*/
+		std::unique_ptr<BufferEscrita> bufDados;			/**< Buffer de escrita dos valores											*/
+		std::unique_ptr<FicheiroAtomico> deslocamentos;		/**< Ficheiro dos deslocamentos (apenas colunas de texto)					*/
+		std::unique_ptr<BufferEscrita> bufDeslocamentos;	/**< Buffer de escrita dos deslocamentos (apenas colunas de texto)			*/
+		unsigned long long tamanhoTexto;					/**< Número de bytes de texto já escritos (apenas colunas de texto)			*/
+	};
+
+	// Colunas da tabela de acidentes
+	enum ColunaAcidentes { AC_NUM_OCORRENCIA, AC_SEQ, AC_TERMINADO, AC_TIPO, AC_DATA, AC_LOCAL, AC_TIPO_CASA, AC_TIPO_ESTRADA, AC_HA_FERIDOS, AC_NUM_FERIDOS,
+		AC_NUM_VEICULOS, AC_NUM_BOMBEIROS, AC_NUM_AUTOTANQUES, AC_AREA_CHAMAS, AC_PRIMEIRA_ATRIBUICAO, AC_NUM_ATRIBUICOES, NUM_COLUNAS_ACIDENTES };
+
+	// Colunas da tabela de atribuicoes
+	enum ColunaAtribuicoes { AT_ACIDENTE = NUM_COLUNAS_ACIDENTES, AT_NUM_OCORRENCIA, AT_POSTO, AT_SOCORRISTAS, AT_VEICULOS, AT_TIPO_VEICULOS, NUM_COLUNAS };
+
+	const std::string prefixo;						/**< Prefixo dos nomes dos ficheiros exportados				*/
+	std::vector<Coluna> colunas;					/**< Colunas das duas tabelas, indexadas pelos enums acima	*/
+	unsigned long long numAcidentes;				/**< Número de linhas da tabela de acidentes				*/
+	unsigned long long numAtribuicoes;				/**< Número de linhas da tabela de atribuições				*/
+	bool concluido;									/**< Indica se a exportação já foi concluída				*/
+
+	/**
+	 * @brief Abre os ficheiros de uma coluna, lançando a exceção ErroEscrita caso não seja possível abri-los
+	 * @param tabela - Tabela da coluna
+	 * @param nome - Nome da coluna
+	 * @param tipo - Tipo dos valores da coluna
+	 */
+	void abrirColuna(const std::string &tabela, const std::string &nome, TipoColuna tipo);
+
+	/**
+	 * @brief Permite obter o nome do ficheiro de valores de uma coluna
+	 * @param coluna - Coluna
+	 * @return Retorna o nome do ficheiro
+	 */
+	std::string nomeFicheiro(const Coluna &coluna) const;
+
+	/**
+	 * @brief Acrescenta um valor inteiro (com a largura do tipo da coluna) a uma coluna
+	 * @param coluna - Índice da coluna
+	 * @param valor - Valor a acrescentar
+	 */
+	void escreverInteiro(unsigned int coluna, unsigned long long valor);
+
+	/**
+	 * @brief Acrescenta um valor a uma coluna de texto
+	 * @param coluna - Índice da coluna
+	 * @param valor - Valor a acrescentar
+	 */
+	void escreverTexto(unsigned int coluna, const std::string &valor);
+public:
+	/**
+	 * @brief Construtor da classe ExportadorColunar, abre os ficheiros de todas as colunas, lançando a exceção ErroEscrita caso não seja possível abri-los
+	 * @param prefixo - Prefixo dos nomes dos ficheiros exportados
+	 */
+	ExportadorColunar(const std::string &prefixo);
+
+	/**
+	 * @brief Acrescenta um acidente (e as suas atribuições) às colunas
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @param seq - Número de sequência (no diário) do registo do seu término, ou 0 caso esteja em decurso
+	 * @param terminado - Indica se o acidente já terminou (vem do arquivo)
+	 * @param descritor - Descrição do acidente
+	 */
+	void adicionar(unsigned int numOcorrencia, unsigned long long seq, bool terminado, const DescritorAcidente &descritor);
+
+	/**
+	 * @brief Conclui a exportação: confirma os ficheiros de todas as colunas e escreve o manifesto (o último ficheiro, para que uma exportação interrompida não seja lida), lançando a exceção ErroEscrita em caso de falha
+	 */
+	void concluir();
+
+	/**
+	 * @brief Permite obter o número de acidentes exportados
+	 * @return Retorna o número de linhas da tabela de acidentes
+	 */
+	unsigned long long getNumAcidentes() const;
+
+	/**
+	 * @brief Permite obter o número de atribuições exportadas
+	 * @return Retorna o número de linhas da tabela de atribuições
+	 */
+	unsigned long long getNumAtribuicoes() const;
+};
+
+#endif /* EXPORTADORCOLUNAR_H_ */
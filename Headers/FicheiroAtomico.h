@@ -0,0 +1,54 @@
+#ifndef FICHEIROATOMICO_H_
+#define FICHEIROATOMICO_H_
+#include <string>
+#include <fstream>
+#include "Erro.h"
+
+/**
+ * Escrita atómica de um ficheiro: o conteúdo é escrito num ficheiro temporário, sincronizado com o disco (fsync) e só depois renomeado para o nome final.
+ * Caso o programa termine a meio da escrita, o ficheiro de destino mantém o conteúdo anterior, completo.
+ */
+class FicheiroAtomico {
+private:
+	const std::string destino;			/**< Nome do ficheiro de destino							*/
+	const std::string temporario;		/**< Nome do ficheiro temporário onde é feita a escrita	*/
+	std::ofstream ostr;					/**< Stream de escrita no ficheiro temporário				*/
+	bool confirmado;					/**< Indica se a escrita já foi confirmada (renomeada)		*/
+public:
+	/**
+	 * @brief Construtor da classe FicheiroAtomico, abre o ficheiro temporário, lançando a exceção ErroEscrita caso não seja possível abri-lo
+	 * @param destino - Nome do ficheiro a escrever
+	 */
+	FicheiroAtomico(const std::string &destino);
+
+	/**
+	 * @brief Destrutor da classe FicheiroAtomico. Caso a escrita não tenha sido confirmada, o ficheiro temporário é apagado e o destino fica intacto
+	 */
+	~FicheiroAtomico();
+
+	/**
+	 * @brief Permite obter a stream de escrita no ficheiro temporário
+	 * @return Retorna a stream de escrita
+	 */
+	std::ostream & getStream();
+
+	/**
+	 * @brief Confirma a escrita: fecha e sincroniza o ficheiro temporário e renomeia-o para o nome final, lançando a exceção ErroEscrita em caso de falha
+	 */
+	void confirmar();
+
+	/**
+	 * @brief Sincroniza com o disco um ficheiro já escrito e fechado
+	 * @param ficheiro - Nome do ficheiro
+	 * @return Retorna true em caso de sucesso e false caso contrário
+	 */
+	static bool sincronizar(const std::string &ficheiro);
+
+	/**
+	 * @brief Sincroniza com o disco o diretório de um ficheiro, tornando persistentes as criações, renomeações e remoções nesse diretório
+	 * @param ficheiro - Nome de um ficheiro do diretório
+	 */
+	static void sincronizarDiretorio(const std::string &ficheiro);
+};
+
+#endif /* FICHEIROATOMICO_H_ */
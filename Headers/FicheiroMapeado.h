@@ -0,0 +1,55 @@
+#ifndef FICHEIROMAPEADO_H_
+#define FICHEIROMAPEADO_H_
+#include <string>
+
+/**
+ * Mapeamento de um ficheiro em memória, só de leitura (mmap). Os bytes são lidos diretamente das páginas do ficheiro, sem abrir o ficheiro nem copiar para um buffer a cada leitura.
+ * O mapeamento cobre o tamanho que o ficheiro tinha quando foi mapeado: depois de o ficheiro crescer ou ser truncado, tem de ser mapeado de novo.
+ */
+class FicheiroMapeado {
+private:
+	const char* dados;				/**< Início do mapeamento (NULL caso o ficheiro esteja vazio ou não tenha sido mapeado)	*/
+	unsigned long long tamanho;		/**< Número de bytes mapeados															*/
+
+	/**
+	 * O mapeamento não pode ser copiado (seria libertado duas vezes)
+	 */
+	FicheiroMapeado(const FicheiroMapeado &);
+	FicheiroMapeado & operator=(const FicheiroMapeado &);
+public:
+	/**
+	 * @brief Construtor da classe FicheiroMapeado, sem nenhum ficheiro mapeado
+	 */
+	FicheiroMapeado();
+
+	/**
+	 * @brief Destrutor da classe FicheiroMapeado, liberta o mapeamento
+	 */
+	~FicheiroMapeado();
+
+	/**
+	 * @brief Mapeia o conteúdo atual de um ficheiro, libertando o mapeamento anterior
+	 * @param ficheiro - Nome do ficheiro
+	 * @return Retorna true em caso de sucesso (um ficheiro vazio fica com um mapeamento vazio) e false caso não seja possível abrir ou mapear o ficheiro
+	 */
+	bool mapear(const std::string &ficheiro);
+
+	/**
+	 * @brief Liberta o mapeamento (fica vazio)
+	 */
+	void libertar();
+
+	/**
+	 * @brief Permite obter os bytes mapeados
+	 * @return Retorna o início do mapeamento (NULL caso esteja vazio)
+	 */
+	const char* getDados() const;
+
+	/**
+	 * @brief Permite obter o número de bytes mapeados
+	 * @return Retorna o tamanho do mapeamento
+	 */
+	unsigned long long getTamanho() const;
+};
+
+#endif /* FICHEIROMAPEADO_H_ */
@@ -0,0 +1,138 @@
+#ifndef FILAPENDENTES_H_
+#define FILAPENDENTES_H_
+#include <vector>
+#include <map>
+#include <set>
+#include "Acidente.h"
+#include "Date.h"
+#include "ResultadoDespacho.h"
+
+/**
+ * Fila de prioridade dos acidentes em decurso com necessidades por suprir (aceites com meios insuficientes), ordenada por gravidade (mais graves primeiro) e antiguidade (mais antigos primeiro).
+ * Cada acidente entra na fila de cada tipo de recurso que lhe falta (autotanques, equipas policiais, equipas médicas), para que o retorno de meios a um posto
+ * só percorra os acidentes à espera dos recursos que esse posto pode enviar.
+ */
+class FilaPendentes {
+private:
+	/**
+	 * Chave de ordenação de um acidente na fila
+	 */
+	struct Chave {
+		unsigned int gravidade;			/**< Gravidade do acidente (ver getGravidade)			*/
+		Date data;						/**< Data do acidente									*/
+		unsigned int numOcorrencia;		/**< Número de ocorrência (desempate)					*/
+
+		Chave(unsigned int gravidade, const Date &data, unsigned int numOcorrencia) : gravidade(gravidade), data(data), numOcorrencia(numOcorrencia) {}
+
+		/**
+		 * @brief Ordem de prioridade: maior gravidade, depois data mais antiga, depois menor número de ocorrência
+		 */
+		bool operator<(const Chave &outra) const;
+	};
+
+	/**
+	 * Acidente na fila, com o que lhe falta de cada tipo de recurso
+	 */
+	struct Entrada {
+		Acidente* acidente;										/**< Acidente à espera de meios							*/
+		Chave chave;											/**< Chave de ordenação do acidente						*/
+		unsigned int falta[ResultadoDespacho::NUM_RECURSOS];	/**< Unidades em falta de cada tipo de recurso			*/
+
+		Entrada(Acidente* acidente, const Chave &chave) : acidente(acidente), chave(chave) {}
+	};
+
+	std::map<unsigned int, Entrada> entradas;								/**< Acidentes na fila, por número de ocorrência						*/
+	std::set<Chave> porRecurso[ResultadoDespacho::NUM_RECURSOS];			/**< Acidentes à espera de cada tipo de recurso, por ordem de prioridade	*/
+
+	/**
+	 * @brief Retira um acidente das filas dos recursos de que estava à espera
+	 * @param entrada - Entrada do acidente
+	 */
+	void retirarDasFilas(const Entrada &entrada);
+public:
+	/**
+	 * @brief Construtor da classe FilaPendentes, cria uma fila vazia
+	 */
+	FilaPendentes();
+
+	/**
+	 * @brief Permite obter a gravidade de um acidente: 3 para incêndios, 2 para acidentes de viação, 1 para assaltos com feridos e 0 para os restantes assaltos
+	 * @param acidente - Acidente
+	 * @return Retorna a gravidade do acidente
+	 */
+	static unsigned int getGravidade(const Acidente* acidente);
+
+	/**
+	 * @brief Coloca um acidente na fila ou atualiza o que lhe falta; caso já não lhe falte nada, é retirado da fila
+	 * @param acidente - Acidente
+	 * @param resultado - Resultado com o que falta ao acidente de cada tipo de recurso (ver ProtecaoCivil::calcularFalta)
+	 */
+	void atualizar(Acidente* acidente, const ResultadoDespacho &resultado);
+
+	/**
+	 * @brief Retira um acidente da fila
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @return Retorna true caso o acidente estivesse na fila e false caso contrário
+	 */
+	bool remover(unsigned int numOcorrencia);
+
+	/**
+	 * @brief Permite obter o número de unidades de um recurso (veículos com a respetiva equipa) que faltam a um acidente
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @return Retorna o número de unidades em falta, ou 0 caso o acidente não esteja na fila
+	 */
+	unsigned int getUnidadesEmFalta(unsigned int numOcorrencia, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Distribui unidades de um recurso pelos acidentes à espera dele, pela ordem da fila (gravidade e antiguidade), sem copiar nem reordenar a fila
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @param oferta - Número de unidades disponíveis
+	 * @param atribuir - Função chamada com cada acidente e as unidades que lhe cabem (no máximo as que lhe faltam); pode atualizar ou retirar esse acidente da fila
+	 * @return Retorna o número de unidades que sobraram
+	 */
+	template <class Funcao>
+	unsigned int distribuir(ResultadoDespacho::TipoRecurso recurso, unsigned int oferta, Funcao atribuir);
+
+	/**
+	 * @brief Permite obter os acidentes à espera de um tipo de recurso
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @return Retorna os acidentes por ordem de prioridade
+	 */
+	std::vector<Acidente*> getPendentes(ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Permite obter todos os acidentes da fila
+	 * @return Retorna os acidentes por ordem de prioridade
+	 */
+	std::vector<Acidente*> getPendentes() const;
+
+	/**
+	 * @brief Permite obter o número de acidentes na fila
+	 * @return Retorna o número de acidentes com necessidades por suprir
+	 */
+	unsigned int getNumPendentes() const;
+};
+
+template <class Funcao>
+unsigned int FilaPendentes::distribuir(ResultadoDespacho::TipoRecurso recurso, unsigned int oferta, Funcao atribuir){
+	std::set<Chave>::iterator it = porRecurso[recurso].begin();
+	while (it != porRecurso[recurso].end() && oferta > 0){
+		// A funcao so mexe na chave deste acidente: o iterador seguinte continua valido
+		std::set<Chave>::iterator seguinte = it;
+		seguinte++;
+
+		const Entrada &entrada = entradas.find(it->numOcorrencia)->second;
+		unsigned int unidades = entrada.falta[recurso];
+		if (unidades > oferta)
+			unidades = oferta;
+		if (unidades != 0){
+			oferta -= unidades;
+			atribuir(entrada.acidente, unidades);
+		}
+		it = seguinte;
+	}
+	return oferta;
+}
+
+#endif /* FILAPENDENTES_H_ */
@@ -0,0 +1,120 @@
+#ifndef FLUXOCUSTOMINIMO_H_
+#define FLUXOCUSTOMINIMO_H_
+#include <vector>
+
+/**
+ * Problema de fluxo de custo mínimo numa rede com ofertas (nós com excesso) e procuras (nós com défice), resolvido por caminhos mais curtos sucessivos:
+ * em cada iteração, um Dijkstra com potenciais (custos reduzidos não negativos) a partir de todos os nós com excesso encontra o nó com défice mais próximo e o fluxo é aumentado nesse caminho.
+ *
+ * A resolução pode ser retomada (arranque a quente): depois de resolver, é possível alterar capacidades e ofertas ou acrescentar nós e arestas e voltar a resolver,
+ * partindo do fluxo e dos potenciais atuais. As arestas residuais que fiquem com custo reduzido negativo são saturadas, o que cria novos excessos e défices,
+ * e só esses são reencaminhados (em vez de resolver toda a rede de novo). Os nós e arestas acrescentados por último podem ser retirados (ver recuar),
+ * o que permite manter a parte fixa da rede entre resoluções sucessivas (ver OtimizadorDespacho).
+ */
+class FluxoCustoMinimo {
+private:
+	/**
+	 * Aresta da rede residual (cada aresta da rede tem a aresta inversa a seguir: as arestas 2k e 2k+1 formam um par)
+	 */
+	struct Aresta {
+		unsigned int destino;			/**< Nó de destino da aresta								*/
+		long long residual;				/**< Capacidade residual da aresta						*/
+		long long custo;				/**< Custo por unidade de fluxo (simétrico na inversa)	*/
+	};
+
+	std::vector<Aresta> arestas;					/**< Arestas da rede e as suas inversas						*/
+	std::vector< std::vector<unsigned int> > saidas;	/**< Arestas que saem de cada nó							*/
+	std::vector<long long> excesso;					/**< Excesso (positivo) ou défice (negativo) de cada nó		*/
+	std::vector<long long> oferta;					/**< Oferta (positiva) ou procura (negativa) de cada nó		*/
+	std::vector<long long> potencial;				/**< Potencial de cada nó (mantém os custos reduzidos >= 0)	*/
+
+	/**
+	 * @brief Permite obter o custo reduzido de uma aresta
+	 * @param origem - Nó de origem da aresta
+	 * @param aresta - Índice da aresta
+	 * @return Retorna o custo da aresta corrigido pelos potenciais dos seus nós
+	 */
+	long long custoReduzido(unsigned int origem, unsigned int aresta) const;
+
+	/**
+	 * @brief Faz passar uma quantidade de fluxo numa aresta residual
+	 * @param aresta - Índice da aresta
+	 * @param quantidade - Quantidade de fluxo
+	 */
+	void empurrar(unsigned int aresta, long long quantidade);
+public:
+	/**
+	 * @brief Construtor da classe FluxoCustoMinimo, cria uma rede sem nós
+	 */
+	FluxoCustoMinimo();
+
+	/**
+	 * @brief Acrescenta um nó à rede, sem oferta nem procura
+	 * @return Retorna o índice do nó
+	 */
+	unsigned int adicionarNo();
+
+	/**
+	 * @brief Acrescenta uma aresta à rede, sem fluxo
+	 * @param origem - Nó de origem
+	 * @param destino - Nó de destino
+	 * @param capacidade - Capacidade da aresta
+	 * @param custo - Custo por unidade de fluxo (não negativo)
+	 * @return Retorna o índice da aresta
+	 */
+	unsigned int adicionarAresta(unsigned int origem, unsigned int destino, long long capacidade, long long custo);
+
+	/**
+	 * @brief Altera a capacidade de uma aresta. Caso a nova capacidade seja inferior ao fluxo atual, o fluxo em excesso é retirado (e reencaminhado na próxima resolução)
+	 * @param aresta - Índice da aresta
+	 * @param capacidade - Nova capacidade
+	 */
+	void alterarCapacidade(unsigned int aresta, long long capacidade);
+
+	/**
+	 * @brief Retira da rede os nós e as arestas acrescentados depois de um dado ponto, devolvendo o fluxo dessas arestas aos nós que ficam (como excesso ou défice, reencaminhado na próxima resolução)
+	 * @param numNos - Número de nós que ficam na rede (os primeiros acrescentados)
+	 * @param numArestas - Número de arestas que ficam na rede, tal como retornado por getNumArestas (as primeiras acrescentadas)
+	 */
+	void recuar(unsigned int numNos, unsigned int numArestas);
+
+	/**
+	 * @brief Define a oferta (positiva) ou procura (negativa) de um nó
+	 * @param no - Índice do nó
+	 * @param valor - Oferta do nó
+	 */
+	void definirOferta(unsigned int no, long long valor);
+
+	/**
+	 * @brief Encaminha todo o excesso da rede para os nós com défice, com custo mínimo, partindo do fluxo atual
+	 * @return Retorna true caso todo o excesso tenha sido encaminhado e false caso não haja caminho para algum excesso
+	 */
+	bool resolver();
+
+	/**
+	 * @brief Permite obter o fluxo numa aresta
+	 * @param aresta - Índice da aresta
+	 * @return Retorna o fluxo atual da aresta
+	 */
+	long long getFluxo(unsigned int aresta) const;
+
+	/**
+	 * @brief Permite obter o custo total do fluxo atual
+	 * @return Retorna a soma, em todas as arestas, do fluxo pelo custo
+	 */
+	long long getCustoTotal() const;
+
+	/**
+	 * @brief Permite obter o número de nós da rede
+	 * @return Retorna o número de nós
+	 */
+	unsigned int getNumNos() const;
+
+	/**
+	 * @brief Permite obter o número de arestas da rede, incluindo as inversas (ver recuar)
+	 * @return Retorna o número de arestas
+	 */
+	unsigned int getNumArestas() const;
+};
+
+#endif /* FLUXOCUSTOMINIMO_H_ */
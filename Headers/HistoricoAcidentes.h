@@ -0,0 +1,214 @@
+#ifndef HISTORICOACIDENTES_H_
+#define HISTORICOACIDENTES_H_
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include "Acidente.h"
+
+/**
+ * Dicionário que associa a cada texto distinto (nome de local, tipo de veículo, ...) um código inteiro pequeno
+ */
+class Dicionario {
+private:
+	std::vector<std::string> textos;				/**< Textos do dicionário, indexados pelo seu código 	*/
+	std::map<std::string, uint16_t> codigos;		/**< Código de cada texto do dicionário					*/
+public:
+	/**
+	 * @brief Obtém o código de um texto, acrescentando-o ao dicionário caso ainda não exista
+	 * @param texto - Texto a codificar
+	 * @return Retorna o código do texto
+	 */
+	uint16_t codificar(const std::string &texto);
+
+	/**
+	 * @brief Procura o código de um texto, sem o acrescentar ao dicionário
+	 * @param texto - Texto a procurar
+	 * @return Retorna o código do texto, ou -1 caso não exista no dicionário
+	 */
+	int procurar(const std::string &texto) const;
+
+	/**
+	 * @brief Permite obter o texto associado a um código
+	 * @param codigo - Código do texto
+	 * @return Retorna o texto associado ao código
+	 */
+	const std::string & descodificar(uint16_t codigo) const;
+
+	/**
+	 * @brief Permite obter o número de textos distintos do dicionário
+	 * @return Retorna o tamanho do dicionário
+	 */
+	unsigned int size() const;
+};
+
+
+
+/**
+ * Coluna esparsa: guarda valores apenas para as linhas em que o campo existe (campos específicos de um tipo de acidente)
+ */
+template <typename T>
+class ColunaEsparsa {
+private:
+	std::vector<unsigned int> linhas;	/**< Linhas que têm valor, por ordem crescente 	*/
+	std::vector<T> valores;				/**< Valor de cada uma dessas linhas			*/
+public:
+	/**
+	 * @brief Acrescenta o valor de uma linha à coluna (as linhas são acrescentadas por ordem crescente)
+	 */
+	void adicionar(unsigned int linha, const T &valor) { linhas.push_back(linha); valores.push_back(valor); }
+
+	/**
+	 * @brief Procura o valor de uma linha
+	 * @param linha - Linha a procurar
+	 * @param valor - Variável onde é colocado o valor, caso a linha o tenha
+	 * @return Retorna true se a linha tiver valor nesta coluna e false caso contrário
+	 */
+	bool obter(unsigned int linha, T &valor) const {
+		std::vector<unsigned int>::const_iterator it = std::lower_bound(linhas.begin(), linhas.end(), linha);
+		if (it == linhas.end() || *it != linha)
+			return false;
+		valor = valores[it - linhas.begin()];
+		return true;
+	}
+
+	/**
+	 * @brief Permite obter todos os valores da coluna, para varrimentos sequenciais
+	 */
+	const std::vector<T> & getValores() const { return valores; }
+
+	/**
+	 * @brief Permite obter as linhas com valor na coluna, para varrimentos sequenciais
+	 */
+	const std::vector<unsigned int> & getLinhas() const { return linhas; }
+};
+
+
+
+/**
+ * Armazém colunar em memória dos acidentes já terminados.
+ * Cada campo é guardado num vetor próprio: o local e o tipo são codificados por dicionário, as datas são compactadas num inteiro de 32 bits, os campos específicos de cada tipo de acidente estão em colunas esparsas e as atribuições estão todas num único conjunto de vetores, indexado por deslocamentos.
+ */
+class HistoricoAcidentes {
+public:
+	/**
+	 * Código de cada tipo de acidente na coluna de tipos
+	 */
+	enum TipoAcidente { ASSALTO = 0, VIACAO = 1, INCENDIO_DOMESTICO = 2, INCENDIO_FLORESTAL = 3, NUM_TIPOS = 4 };
+private:
+	// Colunas comuns a todos os acidentes
+	std::vector<unsigned int> numOcorrencia;		/**< Número de ocorrência de cada acidente								*/
+	std::vector<uint16_t> local;					/**< Código (dicionário de locais) do local de cada acidente			*/
+	std::vector<uint8_t> tipo;						/**< Tipo de cada acidente (TipoAcidente)								*/
+	std::vector<uint32_t> data;						/**< Data de cada acidente, compactada com compactarData				*/
+
+	// Colunas especificas de cada tipo de acidente
+	ColunaEsparsa<uint16_t> tipoCasa;				/**< Código (dicionário de textos) do tipo de casa (Assaltos e Incêndios Domésticos)	*/
+	ColunaEsparsa<bool> haFeridos;					/**< Existência de feridos (Assaltos)													*/
+	ColunaEsparsa<uint16_t> tipoEstrada;			/**< Código (dicionário de textos) do tipo de estrada (Acidentes de Viação)				*/
+	ColunaEsparsa<unsigned int> numFeridos;			/**< Número de feridos (Acidentes de Viação)											*/
+	ColunaEsparsa<unsigned int> numVeiculos;		/**< Número de veículos envolvidos (Acidentes de Viação)								*/
+	ColunaEsparsa<unsigned int> numBombeirosNecess;		/**< Número de bombeiros necessários (Incêndios)									*/
+	ColunaEsparsa<unsigned int> numAutotanquesNecess;	/**< Número de autotanques necessários (Incêndios)									*/
+	ColunaEsparsa<unsigned int> areaChamas;			/**< Área das chamas (Incêndios Florestais)												*/
+
+	// Atribuicoes de todos os acidentes, num unico conjunto de vetores
+	std::vector<unsigned int> inicioAtribuicoes;	/**< Índice da primeira atribuição de cada acidente (com uma entrada extra no fim)	*/
+	std::vector<unsigned int> atribPostoId;			/**< Posto de origem de cada atribuição												*/
+	std::vector<uint16_t> atribSocorristas;			/**< Número de socorristas de cada atribuição										*/
+	std::vector<uint16_t> atribVeiculos;			/**< Número de veículos de cada atribuição											*/
+	std::vector<uint16_t> atribTipoVeiculo;			/**< Código (dicionário de textos) do tipo de veículos de cada atribuição			*/
+
+	Dicionario locais;								/**< Dicionário dos nomes dos locais													*/
+	Dicionario textos;								/**< Dicionário dos restantes textos (tipo de casa, tipo de estrada, tipo de veículo)	*/
+public:
+	/**
+	 * @brief Construtor da classe HistoricoAcidentes, cria um armazém vazio
+	 */
+	HistoricoAcidentes();
+
+	/**
+	 * @brief Compacta uma data num inteiro de 32 bits, preservando a ordem cronológica
+	 * @param data - Data a compactar
+	 * @return Retorna a data compactada (ano << 9 | mes << 5 | dia)
+	 */
+	static uint32_t compactarData(const Date &data);
+
+	/**
+	 * @brief Acrescenta um acidente terminado ao armazém
+	 * @param acidente - Apontador para o acidente terminado
+	 */
+	void adicionar(const Acidente* acidente);
+
+	/**
+	 * @brief Permite obter o número de acidentes guardados no armazém
+	 * @return Retorna o número de acidentes no histórico
+	 */
+	unsigned int getNumAcidentes() const;
+
+	/**
+	 * @brief Conta os acidentes do histórico de cada tipo
+	 * @return Retorna um vetor com NUM_TIPOS posições, indexado por TipoAcidente
+	 */
+	std::vector<unsigned int> contarPorTipo() const;
+
+	/**
+	 * @brief Conta os acidentes do histórico que decorreram em cada local
+	 * @return Retorna um mapa do nome do local para o número de acidentes nesse local
+	 */
+	std::map<std::string, unsigned int> contarPorLocal() const;
+
+	/**
+	 * @brief Conta os acidentes do histórico que decorreram em cada ano
+	 * @return Retorna um mapa do ano para o número de acidentes nesse ano
+	 */
+	std::map<unsigned int, unsigned int> contarPorAno() const;
+
+	/**
+	 * @brief Conta os acidentes do histórico que decorreram num intervalo de datas (inclusive)
+	 * @param inicio - Primeira data do intervalo
+	 * @param fim - Última data do intervalo
+	 * @return Retorna o número de acidentes no intervalo
+	 */
+	unsigned int contarIntervalo(const Date &inicio, const Date &fim) const;
+
+	/**
+	 * @brief Soma os socorristas atribuídos por cada posto em todos os acidentes do histórico
+	 * @return Retorna um mapa do número de identificação do posto para o total de socorristas que atribuiu
+	 */
+	std::map<unsigned int, unsigned int> somarSocorristasPorPosto() const;
+
+	/**
+	 * @brief Permite obter o número de ocorrência de um acidente do histórico
+	 * @param linha - Posição do acidente no armazém
+	 */
+	unsigned int getNumOcorrencia(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter o nome do local de um acidente do histórico
+	 * @param linha - Posição do acidente no armazém
+	 */
+	const std::string & getNomeLocal(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter o tipo de um acidente do histórico
+	 * @param linha - Posição do acidente no armazém
+	 */
+	TipoAcidente getTipo(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter a data compactada de um acidente do histórico
+	 * @param linha - Posição do acidente no armazém
+	 */
+	uint32_t getDataCompactada(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter as atribuições de um acidente do histórico
+	 * @param linha - Posição do acidente no armazém
+	 * @return Retorna um vetor com as atribuições efetuadas ao acidente
+	 */
+	std::vector<Atribuicao> getAtribuicoes(unsigned int linha) const;
+};
+
+#endif /* HISTORICOACIDENTES_H_ */
@@ -50,10 +50,17 @@ public:
 	virtual void printInfoAcidente() const = 0;
 
 	/**
-	 * @brief Método puramente virtual que imprime numa stream o conteudo simplificado de um incendio. A implementação encontra-se nas classes derivadas: IncendioDomestico e IncendioFlorestal
-	 * @param os - Stream para a qual o conteúdo do incendio é impresso
+	 * @brief Método puramente virtual que escreve num buffer de escrita o conteudo simplificado de um incendio. A implementação encontra-se nas classes derivadas: IncendioDomestico e IncendioFlorestal
+	 * @param buf - Buffer para o qual o conteúdo do incendio é escrito
 	 */
-	virtual void printSimplifiedInfo(std::ostream & os) const = 0;
+	virtual void serializar(BufferEscrita & buf) const = 0;
+
+	/**
+	 * @brief Permite obter as necessidades do incêndio, comuns aos incêndios florestais e domésticos (ver NecessidadesAcidente<Incendio>)
+	 * @param necessidades - Onde são colocadas as necessidades
+	 * @return Retorna o número de necessidades colocadas
+	 */
+	unsigned int getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const;
 };
 
 #endif /* INCENDIO_H_ */
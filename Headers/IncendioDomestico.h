@@ -44,10 +44,10 @@ public:
 	void printInfoAcidente() const;
 
 	/**
-	 * @brief Imprime numa stream o conteudo simplificado de um Incêndio Doméstico
-	 * @param os - Stream para a qual o conteúdo do Incêndio Doméstico é impresso
+	 * @brief Escreve num buffer de escrita o conteudo simplificado de um Incêndio Doméstico
+	 * @param buf - Buffer para o qual o conteúdo do Incêndio Doméstico é escrito
 	 */
-	void printSimplifiedInfo(std::ostream & os) const;
+	void serializar(BufferEscrita & buf) const;
 };
 
 #endif /* INCENDIODOMESTICO_H_ */
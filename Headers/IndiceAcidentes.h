@@ -0,0 +1,170 @@
+#ifndef INDICEACIDENTES_H_
+#define INDICEACIDENTES_H_
+#include <string>
+#include <map>
+#include <vector>
+#include "Acidente.h"
+#include "BitmapComprimido.h"
+
+/**
+ * Índice secundário dos acidentes da Proteção Civil, em decurso e terminados (histórico). Cada acidente indexado recebe uma linha (0, 1, 2, ...) e, para cada valor
+ * de cada atributo (tipo, local, ano, tipo de estrada, existência de feridos), é mantido um bitmap com as linhas dos acidentes que têm esse valor.
+ * Quando um acidente termina, a sua linha mantém-se e passa apenas do bitmap dos acidentes em decurso para o dos terminados (ver terminar).
+ * Filtros combinados são calculados com operações sobre os bitmaps (&, |, -) e contagens sem que seja necessário percorrer os acidentes;
+ * as linhas de um filtro são convertidas em acidentes com getAcidente e getLinhaHistorico.
+ */
+class IndiceAcidentes {
+private:
+	std::map<std::string, BitmapComprimido> porTipo;			/**< Bitmaps por tipo de acidente ("Assalto", "Acidente de Viacao", ...) 	*/
+	std::map<std::string, BitmapComprimido> porLocal;			/**< Bitmaps por nome do local do acidente									*/
+	std::map<unsigned int, BitmapComprimido> porAno;			/**< Bitmaps por ano em que decorreu o acidente								*/
+	std::map<std::string, BitmapComprimido> porTipoEstrada;		/**< Bitmaps por tipo de estrada (apenas Acidentes de Viação)				*/
+	BitmapComprimido assaltosComFeridos;						/**< Bitmap dos Assaltos em que houve feridos								*/
+	BitmapComprimido todos;										/**< Bitmap de todos os acidentes indexados									*/
+	BitmapComprimido emDecurso;									/**< Bitmap dos acidentes em decurso										*/
+	BitmapComprimido terminados;								/**< Bitmap dos acidentes terminados (no histórico)						*/
+	std::vector<Acidente*> acidentesLinha;						/**< Acidente em decurso de cada linha (NULL caso tenha terminado ou sido removido)	*/
+	std::vector<unsigned int> linhasHistorico;					/**< Linha do histórico de cada linha (SEM_LINHA caso não tenha terminado)	*/
+	std::map<unsigned int, unsigned int> linhasEmDecurso;		/**< Linha de cada acidente em decurso, por número de ocorrência			*/
+	static const BitmapComprimido vazio;						/**< Bitmap vazio, retornado quando um valor não existe no índice			*/
+
+	/**
+	 * @brief Acrescenta uma linha com os atributos de um acidente a todos os bitmaps, exceto aos de acidentes em decurso e terminados
+	 * @param acidente - Apontador para o acidente
+	 * @return Retorna a linha do acidente
+	 */
+	unsigned int indexar(const Acidente* acidente);
+
+	/**
+	 * @brief Procura o bitmap associado a um valor de um atributo
+	 * @param mapa - Mapa de bitmaps do atributo
+	 * @param valor - Valor do atributo
+	 * @return Retorna o bitmap associado ao valor, ou um bitmap vazio caso o valor não exista no índice
+	 */
+	template <typename T>
+	static const BitmapComprimido & procurar(const std::map<T, BitmapComprimido> &mapa, const T &valor){
+		typename std::map<T, BitmapComprimido>::const_iterator it = mapa.find(valor);
+		return (it == mapa.end() ? vazio : it->second);
+	}
+
+	/**
+	 * @brief Remove um valor de um bitmap de um mapa, apagando o bitmap caso este fique vazio
+	 */
+	template <typename T>
+	static void removerDe(std::map<T, BitmapComprimido> &mapa, const T &valor, unsigned int linha){
+		typename std::map<T, BitmapComprimido>::iterator it = mapa.find(valor);
+		if (it == mapa.end())
+			return;
+		it->second.remover(linha);
+		if (it->second.vazio())
+			mapa.erase(it);
+	}
+public:
+	static const unsigned int SEM_LINHA = 0xFFFFFFFF;			/**< Linha do histórico de um acidente que não terminou					*/
+
+	/**
+	 * @brief Construtor da classe IndiceAcidentes, cria um índice vazio
+	 */
+	IndiceAcidentes();
+
+	/**
+	 * @brief Adiciona um acidente em decurso ao índice, numa nova linha
+	 * @param acidente - Apontador para o acidente a indexar (guardado até terminar ou ser removido)
+	 * @return Retorna a linha do acidente
+	 */
+	unsigned int adicionar(Acidente* acidente);
+
+	/**
+	 * @brief Adiciona um acidente já terminado ao índice, numa nova linha (ex: ao reconstruir o histórico a partir do arquivo)
+	 * @param acidente - Apontador para o acidente terminado (não é guardado)
+	 * @param linhaHistorico - Linha do acidente no histórico
+	 * @return Retorna a linha do acidente
+	 */
+	unsigned int adicionarTerminado(const Acidente* acidente, unsigned int linhaHistorico);
+
+	/**
+	 * @brief Passa um acidente em decurso para os terminados: a sua linha e os seus atributos mantêm-se no índice
+	 * @param acidente - Apontador para o acidente que terminou
+	 * @param linhaHistorico - Linha do acidente no histórico
+	 */
+	void terminar(const Acidente* acidente, unsigned int linhaHistorico);
+
+	/**
+	 * @brief Remove um acidente em decurso do índice (a sua linha deixa de pertencer a todos os bitmaps)
+	 * @param acidente - Apontador para o acidente a remover
+	 */
+	void remover(const Acidente* acidente);
+
+	/**
+	 * @brief Remove todos os acidentes do índice
+	 */
+	void limpar();
+
+	/**
+	 * @brief Permite obter o acidente em decurso de uma linha
+	 * @param linha - Linha do acidente
+	 * @return Retorna o acidente, ou NULL caso a linha não corresponda a um acidente em decurso
+	 */
+	Acidente* getAcidente(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter a linha do histórico (ver HistoricoAcidentes) de uma linha do índice
+	 * @param linha - Linha do acidente
+	 * @return Retorna a linha do histórico, ou SEM_LINHA caso a linha não corresponda a um acidente terminado
+	 */
+	unsigned int getLinhaHistorico(unsigned int linha) const;
+
+	/**
+	 * @brief Permite obter o bitmap de todos os acidentes indexados (em decurso e terminados)
+	 * @return Retorna o bitmap com as linhas de todos os acidentes
+	 */
+	const BitmapComprimido & getTodos() const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes em decurso (para restringir um filtro a estes acidentes)
+	 * @return Retorna o bitmap com as linhas dos acidentes em decurso
+	 */
+	const BitmapComprimido & getEmDecurso() const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes terminados (para restringir um filtro ao histórico)
+	 * @return Retorna o bitmap com as linhas dos acidentes terminados
+	 */
+	const BitmapComprimido & getTerminados() const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes de um certo tipo
+	 * @param tipo - Tipo de acidente ("Assalto", "Acidente de Viacao", "Incendio Domestico" ou "Incendio Florestal")
+	 * @return Retorna o bitmap com as linhas dos acidentes do tipo indicado
+	 */
+	const BitmapComprimido & getTipo(const std::string &tipo) const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes que decorreram num certo local
+	 * @param nomeLocal - Nome do local
+	 * @return Retorna o bitmap com as linhas dos acidentes do local indicado
+	 */
+	const BitmapComprimido & getLocal(const std::string &nomeLocal) const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes que decorreram num certo ano
+	 * @param ano - Ano dos acidentes
+	 * @return Retorna o bitmap com as linhas dos acidentes do ano indicado
+	 */
+	const BitmapComprimido & getAno(unsigned int ano) const;
+
+	/**
+	 * @brief Permite obter o bitmap dos acidentes de viação que decorreram num certo tipo de estrada
+	 * @param tipoEstrada - Tipo de estrada ("Estrada Nacional" ou "Auto-Estrada")
+	 * @return Retorna o bitmap com as linhas dos acidentes de viação no tipo de estrada indicado
+	 */
+	const BitmapComprimido & getTipoEstrada(const std::string &tipoEstrada) const;
+
+	/**
+	 * @brief Permite obter o bitmap dos assaltos em que houve feridos
+	 * @return Retorna o bitmap com as linhas dos assaltos com feridos
+	 */
+	const BitmapComprimido & getAssaltosComFeridos() const;
+};
+
+#endif /* INDICEACIDENTES_H_ */
@@ -36,16 +36,23 @@ public:
 	 */
 	std::string getTipoPosto() const;
 
+	/**
+	 * @brief Permite obter o tipo dos veículos que este posto envia, para qualquer tipo de recurso
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna o tipo de veículo deste posto ("Ambulancia", "Carro" ou "Moto")
+	 */
+	std::string getTipoVeiculos(ResultadoDespacho::TipoRecurso recurso) const;
+
 	/**
 	 * @brief Imprime no ecrã toda a informação sobre este posto do Inem
 	 */
 	void printInfoPosto() const;
 
 	/**
-	 * @brief Imprime numa stream o conteudo simplificado de um posto do Inem
-	 * @param os - Stream para a qual o conteúdo do posto do Inem é impresso
+	 * @brief Escreve num buffer de escrita o conteudo simplificado de um posto do Inem
+	 * @param buf - Buffer para o qual o conteúdo do posto do Inem é escrito
 	 */
-	void printSimplifiedInfo(std::ostream & os) const;
+	void serializar(BufferEscrita & buf) const;
 };
 
 #endif /* INEM_H_ */
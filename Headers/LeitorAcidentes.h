@@ -0,0 +1,55 @@
+#ifndef LEITORACIDENTES_H_
+#define LEITORACIDENTES_H_
+#include <string>
+#include <vector>
+#include "DescritorAcidente.h"
+
+/**
+ * Leitor paralelo do ficheiro de acidentes. O ficheiro é lido de uma só vez para memória e dividido em blocos nas fronteiras entre entradas (linhas que não começam por '\t'); cada bloco é lido numa thread própria.
+ */
+class LeitorAcidentes {
+private:
+	static const unsigned int TAMANHO_MINIMO_BLOCO = 1 << 16;	/**< Tamanho mínimo (em bytes) de cada bloco lido por uma thread */
+
+	/**
+	 * @brief Encontra o início da primeira entrada a partir de uma dada posição do texto
+	 * @param texto - Conteúdo do ficheiro de acidentes
+	 * @param pos - Posição a partir da qual é feita a procura
+	 * @return Retorna a posição do início da entrada seguinte (ou o tamanho do texto, caso não haja mais entradas)
+	 */
+	static unsigned int proximaEntrada(const std::string &texto, unsigned int pos);
+
+	/**
+	 * @brief Lê todas as entradas de um bloco do texto, parando na primeira entrada com erro
+	 * @param texto - Início do texto (para o número da linha com erro)
+	 * @param inicio - Início do bloco
+	 * @param fim - Fim do bloco
+	 * @param validar - Indica se as entradas lidas têm de representar acidentes válidos (ver DescritorAcidente::valido)
+	 * @param resultado - Vetor onde são colocados os descritores lidos
+	 * @param erro - Variável onde é colocada a descrição do primeiro erro, com o número da linha (fica vazia caso não haja erros)
+	 */
+	static void lerBloco(const char* texto, const char* inicio, const char* fim, bool validar, std::vector<DescritorAcidente> &resultado, std::string &erro);
+public:
+	/**
+	 * @brief Lê todas as entradas de um ficheiro de acidentes, lançando a exceção FicheiroNaoEncontrado caso não seja possível abri-lo
+	 * e a exceção InputInvalido, com o número da linha, caso uma entrada esteja mal formada (ver lerTexto)
+	 * @param ficheiro - Nome do ficheiro de acidentes
+	 * @param numThreads - Número de threads a utilizar (0 para utilizar o número de núcleos da máquina)
+	 * @param assinatura - Caso não seja NULL, variável onde é colocada a assinatura do conteúdo do ficheiro (ver SegmentoCheckpoint::calcularAssinatura)
+	 * @param validar - Indica se as entradas têm também de representar acidentes válidos (ver DescritorAcidente::valido)
+	 * @return Retorna os descritores de todos os acidentes do ficheiro, pela ordem em que aparecem no ficheiro
+	 */
+	static std::vector<DescritorAcidente> lerFicheiro(const std::string &ficheiro, unsigned int numThreads = 0, unsigned long long* assinatura = NULL, bool validar = false);
+
+	/**
+	 * @brief Lê todas as entradas de um texto no formato do ficheiro de acidentes, lançando a exceção InputInvalido, com o número da linha,
+	 * caso uma entrada esteja mal formada (ver DescritorAcidente::ler) ou, com validar, não represente um acidente válido
+	 * @param texto - Conteúdo no formato do ficheiro de acidentes
+	 * @param numThreads - Número de threads a utilizar (0 para utilizar o número de núcleos da máquina)
+	 * @param validar - Indica se as entradas têm também de representar acidentes válidos (ver DescritorAcidente::valido)
+	 * @return Retorna os descritores de todos os acidentes do texto, pela ordem em que aparecem
+	 */
+	static std::vector<DescritorAcidente> lerTexto(const std::string &texto, unsigned int numThreads = 0, bool validar = false);
+};
+
+#endif /* LEITORACIDENTES_H_ */
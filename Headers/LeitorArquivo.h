@@ -0,0 +1,74 @@
+#ifndef LEITORARQUIVO_H_
+#define LEITORARQUIVO_H_
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <memory>
+#include "ArquivoAcidentes.h"
+#include "Acidente.h"
+#include "Local.h"
+
+/**
+ * Leitor de acidentes arquivados, que os materializa apenas quando são pedidos.
+ * Em memória fica apenas um índice compacto de posições (número de ocorrência -> posição do registo mais recente), preenchido à medida que os blocos são lidos,
+ * e uma cache LRU dos últimos acidentes materializados. A memória usada ao abrir não depende do tamanho do arquivo.
+ */
+class LeitorArquivo {
+public:
+	static const unsigned int CAPACIDADE_CACHE = 64;	/**< Número máximo de acidentes materializados mantidos em cache	*/
+private:
+	/**
+	 * Acidente materializado mantido em cache
+	 */
+	struct EntradaCache {
+		unsigned int numOcorrencia;					/**< Número de ocorrência do acidente								*/
+		unsigned long long seq;						/**< Número de sequência do registo de onde foi materializado		*/
+		std::shared_ptr<const Acidente> acidente;	/**< Acidente materializado										*/
+	};
+
+	const ArquivoAcidentes &arquivo;						/**< Arquivo de onde são lidos os acidentes									*/
+	const std::vector<Local> &locais;						/**< Locais da Proteção Civil (para resolver o local dos acidentes)			*/
+	const std::map<std::string, unsigned int> &indiceLocais;	/**< Índice dos locais por nome (posição no vetor de locais)				*/
+	const unsigned int capacidade;							/**< Número máximo de acidentes em cache										*/
+	std::map<unsigned int, PosicaoRegisto> posicoes;		/**< Índice de posições: registo mais recente de cada número de ocorrência já visto	*/
+	std::map< std::pair<unsigned int, unsigned int>, unsigned int > blocosLidos;	/**< Número de registos já lidos de cada bloco (ano, posição do bloco)	*/
+	std::list<EntradaCache> cache;							/**< Acidentes em cache, do usado mais recentemente para o menos recente		*/
+	std::map<unsigned int, std::list<EntradaCache>::iterator> indiceCache;	/**< Posição de cada acidente na cache, por número de ocorrência	*/
+
+	/**
+	 * @brief Garante que o índice de posições inclui todos os blocos que podem conter um dado número de ocorrência
+	 * @param numOcorrencia - Número de ocorrência
+	 */
+	void indexarNumero(unsigned int numOcorrencia);
+public:
+	/**
+	 * @brief Construtor da classe LeitorArquivo
+	 * @param arquivo - Arquivo de onde são lidos os acidentes
+	 * @param locais - Locais da Proteção Civil
+	 * @param indiceLocais - Índice dos locais por nome
+	 * @param capacidade - Número máximo de acidentes materializados mantidos em cache
+	 */
+	LeitorArquivo(const ArquivoAcidentes &arquivo, const std::vector<Local> &locais, const std::map<std::string, unsigned int> &indiceLocais, unsigned int capacidade = CAPACIDADE_CACHE);
+
+	/**
+	 * @brief Materializa o acidente arquivado mais recente com um dado número de ocorrência (com as suas atribuições), lendo apenas o seu registo
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @return Retorna o acidente, ou um apontador nulo caso não esteja no arquivo
+	 */
+	std::shared_ptr<const Acidente> obter(unsigned int numOcorrencia);
+
+	/**
+	 * @brief Permite obter o número de acidentes em cache
+	 * @return Retorna o número de acidentes em cache
+	 */
+	unsigned int getNumEmCache() const;
+
+	/**
+	 * @brief Permite obter o número de entradas do índice de posições
+	 * @return Retorna o número de números de ocorrência cuja posição é conhecida
+	 */
+	unsigned int getNumPosicoes() const;
+};
+
+#endif /* LEITORARQUIVO_H_ */
@@ -28,7 +28,7 @@ public:
 	 * @brief Permite obter o nome do Local
 	 * @return Retorna o nome do Local
 	 */
-	const std::string getNome() const;
+	const std::string & getNome() const;
 
 	/**
 	 * @brief Permite obter a coordenada X do Local (Abcissa)
@@ -0,0 +1,115 @@
+#ifndef MAPACOBERTURA_H_
+#define MAPACOBERTURA_H_
+#include <vector>
+#include <map>
+#include <set>
+#include "Local.h"
+#include "Posto.h"
+#include "ResultadoDespacho.h"
+
+/**
+ * Mapa de cobertura: para cada local e tipo de recurso (autotanques, equipas policiais e equipas médicas), o posto mais próximo que ainda pode enviar pelo menos uma unidade
+ * desse recurso (ver OtimizadorDespacho::getOferta). Permite saber em O(1) se um local tem, por exemplo, uma ambulância disponível a menos de uma dada distância.
+ *
+ * O mapa é mantido incrementalmente a partir dos rankings de postos por local (ver ProtecaoCivil::getRankingPostos): quando os meios de um posto mudam (atualizar),
+ * só há trabalho se o posto deixar de ter ou passar a ter oferta de um recurso. No primeiro caso só os locais que o posto cobria procuram o posto disponível seguinte no seu ranking;
+ * no segundo só são vistos os locais sem nenhum posto com oferta e aqueles a que o posto está mais perto do que o maior raio de cobertura finito atual (os restantes já têm um posto mais próximo).
+ */
+class MapaCobertura {
+private:
+	/**
+	 * Cobertura de um local para um recurso
+	 */
+	struct Cobertura {
+		unsigned int posicao;		/**< Posição do posto mais próximo com oferta no ranking do local (o tamanho do ranking caso não haja nenhum)	*/
+		double distancia;			/**< Distância a esse posto (infinita caso não haja nenhum)															*/
+	};
+
+	const std::vector<Local>* locais;								/**< Locais (da Proteção Civil)																*/
+	const std::vector< std::vector<Posto*> >* rankings;				/**< Postos por ordem de distância a cada local (da Proteção Civil)							*/
+	std::map<unsigned int, unsigned int> indicesPostos;				/**< Índice interno de cada posto, pelo seu id													*/
+	std::vector< std::vector<unsigned int> > posicoes;				/**< Posição de cada posto (índice interno) no ranking de cada local							*/
+	std::vector< std::vector< std::pair<double, unsigned int> > > vizinhos;	/**< Locais de cada posto (índice interno), por ordem crescente de distância			*/
+	std::vector< std::vector<bool> > disponivel;					/**< Indica, por posto (índice interno) e recurso, se o posto tem oferta do recurso				*/
+	std::vector< std::vector< std::set<unsigned int> > > cobertos;	/**< Locais cobertos por cada posto (índice interno), por recurso								*/
+	std::vector< std::vector<Cobertura> > cobertura;				/**< Cobertura de cada local, por recurso														*/
+	std::vector< std::multiset<double> > raios;						/**< Distâncias de cobertura dos locais cobertos, por recurso (para o maior raio)				*/
+	std::vector< std::set<unsigned int> > descobertos;				/**< Locais sem nenhum posto com oferta, por recurso											*/
+
+	/**
+	 * @brief Indica se a cobertura de um recurso é mantida pelo mapa
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna true para AUTOTANQUES, EQUIPAS_POLICIAIS e EQUIPAS_MEDICAS
+	 */
+	static bool recursoCoberto(ResultadoDespacho::TipoRecurso recurso);
+
+	/**
+	 * @brief Muda o posto que cobre um local para um recurso
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso
+	 * @param posicao - Posição do novo posto no ranking do local (o tamanho do ranking caso não haja nenhum)
+	 */
+	void cobrir(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, unsigned int posicao);
+
+	/**
+	 * @brief Procura, no ranking de um local, o primeiro posto com oferta de um recurso a partir de uma posição, e passa a cobrir o local com ele
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso
+	 * @param inicio - Posição do ranking a partir da qual se procura
+	 */
+	void procurar(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, unsigned int inicio);
+public:
+	/**
+	 * @brief Construtor da classe MapaCobertura, com um mapa vazio (ver construir)
+	 */
+	MapaCobertura();
+
+	/**
+	 * @brief Constrói o mapa a partir dos meios atuais dos postos. Os vetores de locais e rankings são referenciados (não copiados) e não podem mudar depois
+	 * @param locais - Locais
+	 * @param postos - Postos
+	 * @param rankings - Para cada local (mesma posição no vetor de locais), os postos por ordem crescente de distância
+	 */
+	void construir(const std::vector<Local> &locais, const std::vector<Posto*> &postos, const std::vector< std::vector<Posto*> > &rankings);
+
+	/**
+	 * @brief Atualiza o mapa depois de os meios de um posto terem mudado (um posto que não está no mapa é ignorado)
+	 * @param posto - Posto cujos meios mudaram
+	 */
+	void atualizar(const Posto* posto);
+
+	/**
+	 * @brief Permite obter o posto mais próximo de um local com oferta de um recurso, em O(1)
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @return Retorna o posto, ou NULL caso nenhum posto tenha oferta do recurso
+	 */
+	const Posto* getMaisProximo(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Permite obter a distância de um local ao posto mais próximo com oferta de um recurso, em O(1)
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @return Retorna a distância, ou infinito caso nenhum posto tenha oferta do recurso
+	 */
+	double getDistancia(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Indica se um local tem um posto com oferta de um recurso a uma distância máxima, em O(1)
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @param distanciaMaxima - Distância máxima
+	 * @return Retorna true caso o posto mais próximo com oferta esteja a essa distância ou menos
+	 */
+	bool estaCoberto(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, double distanciaMaxima) const;
+
+	/**
+	 * @brief Permite obter os locais sem nenhum posto com oferta de um recurso a uma distância máxima
+	 * @param recurso - Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)
+	 * @param distanciaMaxima - Distância máxima
+	 * @return Retorna as posições desses locais no vetor de locais, por ordem crescente
+	 */
+	std::vector<unsigned int> getLocaisDescobertos(ResultadoDespacho::TipoRecurso recurso, double distanciaMaxima) const;
+};
+
+#endif /* MAPACOBERTURA_H_ */
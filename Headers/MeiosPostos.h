@@ -0,0 +1,55 @@
+#ifndef MEIOSPOSTOS_H_
+#define MEIOSPOSTOS_H_
+#include "Posto.h"
+#include "ResultadoDespacho.h"
+
+/**
+ * Acesso aos meios dos postos usado pelo algoritmo guloso de despacho (EmparelhadorMeios).
+ * O mesmo algoritmo corre sobre os meios reais dos postos (MeiosReais) ou sobre um instantâneo das suas capacidades (TabelaCapacidades), para planear um despacho sem o efetuar.
+ * O algoritmo é instanciado para o tipo concreto dos meios (ambas as classes são final), pelo que estes métodos só são virtuais para quem use a interface diretamente.
+ */
+class MeiosPostos {
+public:
+	/**
+	 * @brief Destrutor da classe MeiosPostos
+	 */
+	virtual ~MeiosPostos() {}
+
+	/**
+	 * @brief Permite obter o número de unidades de um recurso que um posto pode enviar (veículos que ainda têm equipa completa, ver Posto::getOferta)
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso (num posto de Bombeiros, AUTOTANQUES indica os autotanques e os restantes as ambulâncias; nos outros postos indica todos os veículos)
+	 * @return Retorna o número de unidades disponíveis
+	 */
+	virtual unsigned int getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const = 0;
+
+	/**
+	 * @brief Reserva, se possível, vários veículos de um posto juntamente com as suas equipas, numa só operação (tudo ou nada)
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso (ver getOferta)
+	 * @param veiculos - Número de veículos a reservar
+	 * @param socorristas - Número total de socorristas que tripulam os veículos
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário
+	 */
+	virtual bool reservar(Posto* posto, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas) = 0;
+};
+
+/**
+ * Meios reais dos postos: as reservas são feitas nos contadores atómicos dos postos (ver Posto::reservar), pelo que os meios saem mesmo dos postos.
+ */
+class MeiosReais final : public MeiosPostos {
+public:
+	/**
+	 * @brief Permite obter o número de unidades de um recurso que um posto pode enviar (ver MeiosPostos::getOferta)
+	 * @return Retorna o número de unidades que o posto pode enviar neste momento
+	 */
+	unsigned int getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Reserva os veículos e as suas equipas nos contadores do posto, com uma só operação atómica (ver MeiosPostos::reservar)
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário
+	 */
+	bool reservar(Posto* posto, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas);
+};
+
+#endif /* MEIOSPOSTOS_H_ */
@@ -0,0 +1,27 @@
+#ifndef MOVIMENTOMEIOS_H_
+#define MOVIMENTOMEIOS_H_
+#include "ResultadoDespacho.h"
+
+/**
+ * Transferência de veículos de um tipo de recurso, com as equipas que os tripulam, de um posto para outro do mesmo tipo (ver ProtecaoCivil::aplicarMovimentos).
+ */
+struct MovimentoMeios {
+	unsigned int origem;					/**< Número de identificação do posto de onde saem os meios				*/
+	unsigned int destino;					/**< Número de identificação do posto para onde vão os meios			*/
+	ResultadoDespacho::TipoRecurso recurso;	/**< Tipo de recurso (AUTOTANQUES, EQUIPAS_POLICIAIS ou EQUIPAS_MEDICAS)	*/
+	unsigned int veiculos;					/**< Número de veículos transferidos									*/
+	unsigned int socorristas;				/**< Número de socorristas transferidos (as equipas dos veículos)		*/
+
+	/**
+	 * @brief Construtor da struct MovimentoMeios
+	 * @param origem - Posto de onde saem os meios
+	 * @param destino - Posto para onde vão os meios
+	 * @param recurso - Tipo de recurso
+	 * @param veiculos - Número de veículos
+	 * @param socorristas - Número de socorristas
+	 */
+	MovimentoMeios(unsigned int origem, unsigned int destino, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas)
+		: origem(origem), destino(destino), recurso(recurso), veiculos(veiculos), socorristas(socorristas) {}
+};
+
+#endif /* MOVIMENTOMEIOS_H_ */
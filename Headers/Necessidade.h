@@ -0,0 +1,25 @@
+#ifndef NECESSIDADE_H_
+#define NECESSIDADE_H_
+#include "ResultadoDespacho.h"
+
+/**
+ * Necessidade de um acidente: um número de unidades de um tipo de recurso, em que cada unidade é um veículo com a sua equipa completa (ver Posto::getTripulacao).
+ */
+struct Necessidade {
+	ResultadoDespacho::TipoRecurso recurso;		/**< Tipo de recurso					*/
+	unsigned int unidades;						/**< Número de unidades necessárias		*/
+
+	/**
+	 * @brief Construtor da struct Necessidade, sem unidades
+	 */
+	Necessidade() : recurso(ResultadoDespacho::EQUIPAS_MEDICAS), unidades(0) {}
+
+	/**
+	 * @brief Construtor da struct Necessidade
+	 * @param recurso - Tipo de recurso
+	 * @param unidades - Número de unidades necessárias
+	 */
+	Necessidade(ResultadoDespacho::TipoRecurso recurso, unsigned int unidades) : recurso(recurso), unidades(unidades) {}
+};
+
+#endif /* NECESSIDADE_H_ */
@@ -0,0 +1,176 @@
+#ifndef OTIMIZADORDESPACHO_H_
+#define OTIMIZADORDESPACHO_H_
+#include <vector>
+#include "Posto.h"
+#include "Acidente.h"
+#include "ResultadoDespacho.h"
+#include "FluxoCustoMinimo.h"
+
+/**
+ * Despacho conjunto de um lote de acidentes: em vez de cada acidente ficar, por ordem, com os meios mais próximos (algoritmo guloso de ProtecaoCivil::addAcidente),
+ * a atribuição de cada tipo de recurso a todos os acidentes do lote é resolvida como um problema de fluxo de custo mínimo (FluxoCustoMinimo), em que o custo é a distância entre o posto e o acidente.
+ * Cada acidente só é ligado aos MAX_POSTOS_ACIDENTE postos mais próximos com unidades do recurso; as unidades que estes não cheguem para dar são completadas
+ * com os postos seguintes, pela ordem de distância (como no despacho guloso).
+ *
+ * Para cada recurso, é calculado também o plano guloso (cada acidente, pela ordem do lote, fica com os postos mais próximos) e só é aplicado o plano do fluxo
+ * caso sirva pelo menos as mesmas unidades com uma distância total não superior; as distâncias dos dois planos ficam acumuladas (ver getDistanciaGulosa).
+ *
+ * As redes são mantidas entre lotes sucessivos (arranque a quente): os nós dos postos, as arestas da origem para os postos e os potenciais ficam,
+ * só as capacidades destas arestas são atualizadas e só os nós e as arestas dos acidentes são trocados (ver FluxoCustoMinimo::recuar).
+ *
+ * Os recursos são resolvidos um de cada vez, por esta ordem: autotanques (incêndios), equipas policiais (assaltos) e equipas médicas (acidentes de viação e assaltos com feridos).
+ * Nos postos de Bombeiros, os socorristas são partilhados entre autotanques e ambulâncias: as ambulâncias disponíveis são calculadas depois de atribuídos os autotanques.
+ */
+class OtimizadorDespacho {
+private:
+	/**
+	 * Unidades de um recurso que saem de um posto para um acidente, num plano de atribuição
+	 */
+	struct Envio {
+		unsigned int posto;				/**< Posição do posto no vetor de postos				*/
+		unsigned int acidente;			/**< Posição do acidente no lote						*/
+		unsigned int unidades;			/**< Número de unidades (veículos com a respetiva equipa)	*/
+	};
+
+	/**
+	 * Rede de fluxo de um tipo de recurso, mantida entre lotes: os primeiros nós e arestas (origem, destino, postos e arestas da origem para os postos) são fixos,
+	 * os nós e arestas dos acidentes são acrescentados a cada lote e retirados no seguinte
+	 */
+	struct Rede {
+		FluxoCustoMinimo fluxo;					/**< Rede de fluxo de custo mínimo										*/
+		std::vector<Posto*> postos;				/**< Postos com que a rede foi construída (é reconstruída caso os postos mudem)	*/
+		unsigned int origem;					/**< Nó de onde sai a oferta (ligado a todos os postos)					*/
+		unsigned int destino;					/**< Nó onde chega a procura (ligado a todos os acidentes)				*/
+		std::vector<unsigned int> nosPostos;	/**< Nó de cada posto, pela ordem do vetor de postos					*/
+		std::vector<unsigned int> arestasPostos;	/**< Aresta da origem para cada posto, com capacidade igual à oferta	*/
+		unsigned int numNosFixos;				/**< Número de nós da parte fixa da rede								*/
+		unsigned int numArestasFixas;			/**< Número de arestas da parte fixa da rede							*/
+	};
+
+	const std::vector<Posto*> &postos;				/**< Postos de onde saem os meios						*/
+	Rede redes[ResultadoDespacho::NUM_RECURSOS];	/**< Rede de fluxo de cada tipo de recurso, mantida entre lotes	*/
+	double distanciaTotal;							/**< Distância total das atribuições efetuadas			*/
+	double distanciaGulosa;							/**< Distância total que o plano guloso teria percorrido nos mesmos lotes	*/
+
+	/**
+	 * @brief Prepara a rede de um recurso para um novo lote: retira os acidentes do lote anterior e atualiza as ofertas dos postos (ou constrói a rede, caso os postos tenham mudado)
+	 * @param recurso - Tipo de recurso
+	 * @param oferta - Unidades disponíveis em cada posto, pela ordem do vetor de postos
+	 * @return Retorna a rede do recurso
+	 */
+	Rede & prepararRede(ResultadoDespacho::TipoRecurso recurso, const std::vector<unsigned int> &oferta);
+
+	/**
+	 * @brief Completa um plano pela ordem do lote: cada acidente fica com as unidades que restam nos postos, do mais próximo para o mais afastado
+	 * @param ordem - Para cada acidente, os postos com unidades do recurso por ordem crescente de distância
+	 * @param oferta - Unidades que restam em cada posto (são descontadas as que forem atribuídas)
+	 * @param falta - Unidades em falta em cada acidente (são descontadas as que forem atribuídas)
+	 * @param plano - Plano a completar
+	 */
+	static void completarGuloso(const std::vector< std::vector<unsigned int> > &ordem, std::vector<unsigned int> &oferta, std::vector<unsigned int> &falta, std::vector<Envio> &plano);
+
+	/**
+	 * @brief Resolve a atribuição de um tipo de recurso a todos os acidentes do lote e aplica-a aos postos e acidentes
+	 * @param acidentes - Acidentes do lote
+	 * @param recurso - Tipo de recurso
+	 */
+	void resolverRecurso(const std::vector<Acidente*> &acidentes, ResultadoDespacho::TipoRecurso recurso);
+public:
+	static const long long ESCALA_CUSTO = 100;		/**< Fator pelo qual as distâncias são multiplicadas para serem custos inteiros	*/
+	static const unsigned int MAX_POSTOS_ACIDENTE = 16;	/**< Número de postos mais próximos ligados a cada acidente na rede de fluxo		*/
+
+	/**
+	 * @brief Construtor da classe OtimizadorDespacho
+	 * @param postos - Postos de onde saem os meios (as suas capacidades são alteradas pelas atribuições)
+	 */
+	OtimizadorDespacho(const std::vector<Posto*> &postos);
+
+	/**
+	 * @brief Atribui meios a todos os acidentes de um lote, retirando-os dos postos e acrescentando as atribuições aos acidentes
+	 * @param acidentes - Acidentes do lote
+	 */
+	void otimizar(const std::vector<Acidente*> &acidentes);
+
+	/**
+	 * @brief Permite obter a distância total percorrida pelos meios atribuídos (soma, por veículo, da distância entre o posto e o acidente)
+	 * @return Retorna a distância total das atribuições efetuadas por este otimizador
+	 */
+	double getDistanciaTotal() const;
+
+	/**
+	 * @brief Permite obter a distância total que o plano guloso teria percorrido nos mesmos lotes (comparável com getDistanciaTotal)
+	 * @return Retorna a distância total dos planos gulosos calculados por este otimizador
+	 */
+	double getDistanciaGulosa() const;
+
+	/**
+	 * @brief Permite obter o número de unidades de um recurso que um posto pode enviar (limitado pelos veículos e pelos socorristas que cada veículo leva, ver Posto::getOferta)
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna o número de unidades disponíveis
+	 */
+	static unsigned int getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso);
+
+	/**
+	 * @brief Permite obter o número de socorristas que cada veículo de um posto leva para um tipo de recurso
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna o número de socorristas por veículo (ver Posto::getTripulacao), ou 0 caso o posto não forneça o recurso
+	 */
+	static unsigned int getTripulacao(const Posto* posto, ResultadoDespacho::TipoRecurso recurso);
+
+	/**
+	 * @brief Permite obter o tipo dos veículos que um posto envia para um tipo de recurso, tal como aparece nas atribuições
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna "Autotanque", "Ambulancia" (bombeiros) ou o tipo de veículo do posto (ver Posto::getTipoVeiculos)
+	 */
+	static std::string getTipoVeiculos(const Posto* posto, ResultadoDespacho::TipoRecurso recurso);
+
+	/**
+	 * @brief Permite obter o número de unidades de um recurso de que um acidente precisa
+	 * @param acidente - Acidente
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna o número de unidades necessárias
+	 */
+	static unsigned int getProcura(const Acidente* acidente, ResultadoDespacho::TipoRecurso recurso);
+
+	/**
+	 * @brief Retira de um posto, de uma só vez (ver Posto::reservar), as unidades de um recurso e atribui-as a um acidente
+	 * @param posto - Posto de onde saem os meios
+	 * @param acidente - Acidente a que os meios são atribuídos
+	 * @param recurso - Tipo de recurso
+	 * @param unidades - Número de unidades (veículos com a respetiva equipa)
+	 * @return Retorna true caso as unidades tenham sido atribuídas e false caso o posto já não as tenha (o posto e o acidente ficam inalterados)
+	 */
+	static bool atribuir(Posto* posto, Acidente* acidente, ResultadoDespacho::TipoRecurso recurso, unsigned int unidades);
+
+	/**
+	 * @brief Reserva num posto, de uma só vez e sem trincos (ver Posto::reservar), até um número de unidades de um recurso e atribui as reservadas a um acidente.
+	 * Pode ser chamado por vários despachantes em simultâneo, desde que cada acidente seja tratado por um só despachante.
+	 * @param posto - Posto de onde saem os meios
+	 * @param acidente - Acidente a que os meios são atribuídos
+	 * @param recurso - Tipo de recurso
+	 * @param unidades - Número máximo de unidades a reservar
+	 * @return Retorna o número de unidades reservadas
+	 */
+	static unsigned int reservar(Posto* posto, Acidente* acidente, ResultadoDespacho::TipoRecurso recurso, unsigned int unidades);
+
+	/**
+	 * @brief Calcula a distância entre um posto e um acidente
+	 * @param posto - Posto
+	 * @param acidente - Acidente
+	 * @return Retorna a distância entre os locais do posto e do acidente
+	 */
+	static double distancia(const Posto* posto, const Acidente* acidente);
+
+	/**
+	 * @brief Calcula a distância entre um posto e um local
+	 * @param posto - Posto
+	 * @param local - Local
+	 * @return Retorna a distância entre o local do posto e o local dado
+	 */
+	static double distancia(const Posto* posto, const Local &local);
+};
+
+#endif /* OTIMIZADORDESPACHO_H_ */
@@ -0,0 +1,120 @@
+#ifndef PLANEADORCAPACIDADES_H_
+#define PLANEADORCAPACIDADES_H_
+#include <vector>
+#include <map>
+#include "ProtecaoCivil.h"
+#include "TabelaCapacidades.h"
+#include "SimuladorEventos.h"
+
+/**
+ * Planeamento de capacidades por Monte Carlo: executa muitas simulações independentes (cada uma com a sua semente de acidentes sintéticos) em paralelo,
+ * num PoolTrabalho, e agrega os resultados de todas.
+ *
+ * Cada simulação é um SimuladorEventos sobre a sua cópia privada de um instantâneo das capacidades (TabelaCapacidades), pelo que os postos reais nunca são alterados
+ * e o modelo de tempo é o do simulador (viagem pela distância, duração no local por tipo de acidente, regresso dos meios ao posto e reforço dos acidentes pendentes
+ * com os meios que regressam). Os acidentes chegam durante a duração da simulação; os que ainda estão em curso no fim são acompanhados até terminarem,
+ * para contar o que lhes ficou por enviar, mas a utilização dos postos só conta dentro da duração da simulação.
+ *
+ * Para avaliar uma alteração da frota (por exemplo, mais um autotanque num posto), basta alterar o instantâneo com TabelaCapacidades::definirCapacidade
+ * e comparar o resultado com o do instantâneo original (com as mesmas sementes).
+ */
+class PlaneadorCapacidades {
+public:
+	/**
+	 * Resumo de uma medida ao longo das simulações
+	 */
+	struct Resumo {
+		double media;		/**< Média das simulações						*/
+		double desvio;		/**< Desvio padrão (amostral) das simulações	*/
+		double minimo;		/**< Menor valor								*/
+		double maximo;		/**< Maior valor								*/
+
+		/**
+		 * @brief Construtor da struct Resumo, com tudo a 0
+		 */
+		Resumo();
+	};
+
+	/**
+	 * Resultado de uma simulação
+	 */
+	struct ResultadoSimulacao {
+		unsigned int numAcidentes;							/**< Acidentes simulados														*/
+		unsigned int numCompletos;							/**< Acidentes com todas as necessidades supridas								*/
+		unsigned int numParciais;							/**< Acidentes com apenas parte das necessidades supridas						*/
+		unsigned int numSemMeios;							/**< Acidentes sem quaisquer meios												*/
+		unsigned int unidadesAtribuidas;					/**< Unidades (veículos com equipa) enviadas, incluindo os reforços				*/
+		unsigned int unidadesEmFalta;						/**< Unidades que ficaram por enviar até ao fim de cada acidente				*/
+		double distanciaP50, distanciaP90, distanciaP99;	/**< Percentis da distância do meio mais próximo enviado a cada acidente		*/
+		std::map<unsigned int, double> utilizacaoPostos;	/**< Fração do tempo em que os veículos de cada posto estiveram fora, por id	*/
+
+		/**
+		 * @brief Construtor da struct ResultadoSimulacao, com tudo a 0
+		 */
+		ResultadoSimulacao();
+
+		/**
+		 * @brief Permite obter a taxa de procura não satisfeita
+		 * @return Retorna a fração das unidades necessárias que ficaram por enviar
+		 */
+		double getTaxaUnidadesEmFalta() const;
+
+		/**
+		 * @brief Permite obter a taxa de acidentes não completamente servidos
+		 * @return Retorna a fração dos acidentes parciais ou sem meios
+		 */
+		double getTaxaNaoCompletos() const;
+	};
+
+	/**
+	 * Resultado agregado de todas as simulações
+	 */
+	struct Resultado {
+		std::vector<ResultadoSimulacao> simulacoes;			/**< Resultado de cada simulação, pela ordem das sementes				*/
+		Resumo taxaUnidadesEmFalta;							/**< Fração das unidades necessárias que ficaram por enviar				*/
+		Resumo taxaNaoCompletos;							/**< Fração dos acidentes parciais ou sem meios							*/
+		Resumo distanciaP50, distanciaP90, distanciaP99;	/**< Percentis da distância de resposta									*/
+		std::map<unsigned int, Resumo> utilizacaoPostos;	/**< Utilização dos veículos de cada posto, por id						*/
+	};
+private:
+	const ProtecaoCivil &protecaoCivil;				/**< Proteção Civil (locais, postos e algoritmo de despacho; não é alterada)	*/
+	SimuladorEventos::Parametros parametros;		/**< Parâmetros temporais													*/
+	double duracao;									/**< Duração de cada simulação (minutos)									*/
+	double acidentesPorDia;							/**< Número médio de acidentes sintéticos por dia							*/
+
+	/**
+	 * @brief Resume os valores de uma medida ao longo das simulações
+	 * @param valores - Valor de cada simulação
+	 * @return Retorna o resumo dos valores
+	 */
+	static Resumo resumir(const std::vector<double> &valores);
+public:
+	/**
+	 * @brief Construtor da classe PlaneadorCapacidades
+	 * @param protecaoCivil - Proteção Civil (com os ficheiros já abertos)
+	 * @param parametros - Parâmetros temporais das simulações
+	 * @param duracao - Duração de cada simulação (minutos)
+	 * @param acidentesPorDia - Número médio de acidentes sintéticos por dia (ver SimuladorEventos::gerarDescritores)
+	 */
+	PlaneadorCapacidades(const ProtecaoCivil &protecaoCivil, const SimuladorEventos::Parametros &parametros, double duracao, double acidentesPorDia);
+
+	/**
+	 * @brief Executa uma simulação (ver SimuladorEventos) sobre uma cópia privada das capacidades
+	 * @param capacidades - Capacidades iniciais dos postos (não são alteradas)
+	 * @param semente - Semente dos acidentes sintéticos
+	 * @return Retorna o resultado da simulação
+	 */
+	ResultadoSimulacao simular(const TabelaCapacidades &capacidades, unsigned int semente) const;
+
+	/**
+	 * @brief Executa várias simulações em paralelo, com as sementes semente, semente+1, ..., e agrega os seus resultados
+	 * @param capacidades - Capacidades iniciais dos postos (não são alteradas)
+	 * @param numSimulacoes - Número de simulações
+	 * @param semente - Semente da primeira simulação
+	 * @param numThreads - Número de threads (0 para uma por núcleo)
+	 * @return Retorna o resultado de cada simulação e o resumo de todas (independente do número de threads)
+	 */
+	Resultado executar(const TabelaCapacidades &capacidades, unsigned int numSimulacoes, unsigned int semente, unsigned int numThreads = 0) const;
+};
+
+#endif /* PLANEADORCAPACIDADES_H_ */
@@ -0,0 +1,62 @@
+#ifndef POOLTRABALHO_H_
+#define POOLTRABALHO_H_
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * Conjunto de threads que executa tarefas independentes com roubo de trabalho: cada thread tem a sua fila de tarefas, de onde tira as mais recentes,
+ * e quando a esvazia rouba as mais antigas da fila de outra thread. Assim, threads com tarefas mais curtas ajudam as restantes sem uma fila central disputada.
+ */
+class PoolTrabalho {
+private:
+	/**
+	 * Fila de tarefas de uma thread
+	 */
+	struct Fila {
+		std::mutex trinco;							/**< Trinco da fila (só disputado em roubos)		*/
+		std::deque<unsigned int> tarefas;			/**< Índices das tarefas por executar				*/
+	};
+
+	unsigned int numThreads;						/**< Número de threads								*/
+	std::atomic<unsigned int> numRoubos;			/**< Tarefas executadas por roubo (última execução)	*/
+
+	/**
+	 * @brief Tira uma tarefa da fila de uma thread ou, se estiver vazia, rouba uma de outra fila
+	 * @param filas - Filas de todas as threads
+	 * @param propria - Índice da fila da thread
+	 * @param tarefa - Onde é colocado o índice da tarefa obtida
+	 * @return Retorna true caso tenha sido obtida uma tarefa e false caso todas as filas estejam vazias
+	 */
+	bool obterTarefa(std::vector< std::unique_ptr<Fila> > &filas, unsigned int propria, unsigned int &tarefa);
+public:
+	/**
+	 * @brief Construtor da classe PoolTrabalho
+	 * @param numThreads - Número de threads (0 para uma por núcleo)
+	 */
+	PoolTrabalho(unsigned int numThreads = 0);
+
+	/**
+	 * @brief Executa tarefas e espera que todas terminem
+	 * @param numTarefas - Número de tarefas
+	 * @param tarefa - Função chamada com o índice de cada tarefa (0 a numTarefas-1), possivelmente em simultâneo para tarefas diferentes
+	 */
+	void executar(unsigned int numTarefas, const std::function<void(unsigned int)> &tarefa);
+
+	/**
+	 * @brief Permite obter o número de threads
+	 * @return Retorna o número de threads
+	 */
+	unsigned int getNumThreads() const;
+
+	/**
+	 * @brief Permite obter o número de tarefas roubadas na última execução
+	 * @return Retorna o número de roubos
+	 */
+	unsigned int getNumRoubos() const;
+};
+
+#endif /* POOLTRABALHO_H_ */
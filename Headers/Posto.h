@@ -2,17 +2,40 @@
 #define POSTO_H_
 #include <string>
 #include <iostream>
+#include <atomic>
 #include "Local.h"
+#include "BufferEscrita.h"
+#include "ResultadoDespacho.h"
 
 /**
- * Posto da Proteção Civil
+ * Posto da Proteção Civil.
+ * Os meios do posto são contadores atómicos: vários despachantes (threads) podem reservar meios do mesmo posto em simultâneo, sem trincos (ver reservar).
  */
 class Posto {
 protected:
 	const unsigned int id;			/**< Numero de Identificação do Posto.						*/
 	const Local* local;				/**< Apontador para o local em que o posto se encontra. 	*/
-	unsigned int numSocorristas;	/**< Numero de Socorristas presentes no posto em questão.	*/
-	unsigned int numVeiculos;		/**< Numero de Veículos presentes no posto em questão.		*/
+	std::atomic<unsigned int> numSocorristas;	/**< Numero de Socorristas presentes no posto em questão.	*/
+	std::atomic<unsigned int> numVeiculos;		/**< Numero de Veículos presentes no posto em questão.		*/
+	unsigned int tripulacoes[ResultadoDespacho::NUM_RECURSOS];	/**< Socorristas que cada veículo do posto leva, por tipo de recurso (0 para os recursos que o posto não fornece). Preenchido pelas classes derivadas.	*/
+	std::atomic<unsigned int>* contadoresVeiculos[ResultadoDespacho::NUM_RECURSOS];	/**< Contador dos veículos usados para cada tipo de recurso (NULL para os recursos que o posto não fornece). Preenchido pelas classes derivadas.	*/
+
+	/**
+	 * @brief Retira atomicamente (compare-and-swap) uma quantidade de um contador, caso este tenha pelo menos essa quantidade.
+	 * @param contador - Contador de meios do posto.
+	 * @param num - Quantidade a retirar.
+	 * @return Retorna true caso a quantidade tenha sido retirada e false caso o contador tenha menos do que essa quantidade (o contador não é alterado).
+	 */
+	static bool retirar(std::atomic<unsigned int> &contador, unsigned int num);
+
+	/**
+	 * @brief Reserva em conjunto veículos de um contador e os socorristas que os tripulam: os socorristas são retirados primeiro e, caso não haja veículos suficientes, são devolvidos.
+	 * @param veiculos - Contador dos veículos a reservar.
+	 * @param quantidadeVeiculos - Número de veículos a reservar.
+	 * @param quantidadeSocorristas - Número de socorristas a reservar.
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário (o posto fica como estava).
+	 */
+	bool reservar(std::atomic<unsigned int> &veiculos, unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas);
 public:
 	/**
 	 * @brief Construtor da classe Posto.
@@ -54,6 +77,14 @@ public:
 	 */
 	bool rmSocorristas(unsigned int num);
 
+	/**
+	 * @brief Reserva, se possível, um certo número de veículos do posto juntamente com os socorristas que os tripulam (tudo ou nada, sem trincos).
+	 * @param quantidadeVeiculos - Número de veículos a reservar.
+	 * @param quantidadeSocorristas - Número de socorristas a reservar.
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário (o posto fica como estava).
+	 */
+	bool reservar(unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas);
+
 	/**
 	 * @brief Permite saber quantos veículos estão presentes no posto.
 	 * @return Retorna o número de veículos do posto.
@@ -66,6 +97,43 @@ public:
 	 */
 	unsigned int getNumSocorristas() const;
 
+	/**
+	 * @brief Permite saber quantos socorristas cada veículo do posto leva para um tipo de recurso (uma moto leva 1, um carro ou uma ambulância 2 e um autotanque 3).
+	 * @param recurso - Tipo de recurso.
+	 * @return Retorna o número de socorristas por veículo, ou 0 caso o posto não forneça esse recurso.
+	 */
+	unsigned int getTripulacao(ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Permite saber quantos veículos do posto são usados para um tipo de recurso (num posto dos Bombeiros, os autotanques ou as ambulâncias; nos restantes, todos os veículos).
+	 * @param recurso - Tipo de recurso.
+	 * @return Retorna o número de veículos, ou 0 caso o posto não forneça esse recurso.
+	 */
+	unsigned int getVeiculos(ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Permite saber quantas unidades de um recurso o posto pode enviar: veículos que ainda têm a sua equipa completa. Só lê as tabelas do posto, sem converter o seu tipo.
+	 * @param recurso - Tipo de recurso.
+	 * @return Retorna o número de unidades disponíveis, ou 0 caso o posto não forneça esse recurso.
+	 */
+	unsigned int getOferta(ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Reserva em conjunto veículos de um tipo de recurso e os socorristas que os tripulam (ver reservar).
+	 * @param recurso - Tipo de recurso.
+	 * @param quantidadeVeiculos - Número de veículos a reservar.
+	 * @param quantidadeSocorristas - Número de socorristas a reservar.
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário ou caso o posto não forneça esse recurso (o posto fica como estava).
+	 */
+	bool reservar(ResultadoDespacho::TipoRecurso recurso, unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas);
+
+	/**
+	 * @brief Permite saber a que tipo de recurso correspondem os veículos de uma atribuição deste posto (o inverso de getTipoVeiculos).
+	 * @param tipoVeiculos - Tipo dos veículos, tal como aparece nas atribuições.
+	 * @return Retorna o tipo de recurso, ou NUM_RECURSOS caso o posto não envie veículos desse tipo.
+	 */
+	ResultadoDespacho::TipoRecurso getRecurso(const std::string &tipoVeiculos) const;
+
 	/**
 	 * @brief Permite saber o local do posto.
 	 * @return Retorna um apontador para o local do posto.
@@ -84,16 +152,29 @@ public:
 	 */
 	virtual std::string getTipoPosto() const = 0;
 
+	/**
+	 * @brief Método puramente virtual que permite saber o tipo dos veículos que o posto envia para um tipo de recurso, tal como aparece nas atribuições. A implementação encontra-se nas classes derivadas: Inem, Policia e Bombeiros.
+	 * @param recurso - Tipo de recurso.
+	 * @return Retorna "Autotanque" ou "Ambulancia" num posto dos Bombeiros, ou o tipo de veículo do posto nos restantes.
+	 */
+	virtual std::string getTipoVeiculos(ResultadoDespacho::TipoRecurso recurso) const = 0;
+
 	/**
 	 * @brief Método puramente virtual que imprime no ecrã toda a informação do respetivo posto. A implementação encontra-se nas classes derivadas: Inem, Policia e Bombeiros.
 	 */
 	virtual void printInfoPosto() const = 0;
 
 	/**
-	 * @brief Método puramente virtual que imprime numa stream o conteudo simplificado de um posto. A implementação encontra-se nas classes derivadas: Inem, Policia e Bombeiros.
+	 * @brief Imprime numa stream o conteudo simplificado de um posto.
 	 * @param os - Stream para a qual o conteúdo do posto é impresso
 	 */
-	virtual void printSimplifiedInfo(std::ostream & os) const = 0;
+	void printSimplifiedInfo(std::ostream & os) const;
+
+	/**
+	 * @brief Método puramente virtual que escreve num buffer de escrita o conteudo simplificado de um posto. A implementação encontra-se nas classes derivadas: Inem, Policia e Bombeiros.
+	 * @param buf - Buffer para o qual o conteúdo do posto é escrito
+	 */
+	virtual void serializar(BufferEscrita & buf) const = 0;
 };
 
 #endif /* POSTO_H_ */
@@ -4,6 +4,16 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <map>
+#include <set>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <future>
+#include <thread>
+#include <functional>
+#include <cmath>
+#include <cstdio>
 #include "Posto.h"
 #include "Policia.h"
 #include "Inem.h"
@@ -16,6 +26,28 @@
 #include "Assalto.h"
 #include "Local.h"
 #include "Erro.h"
+#include "IndiceAcidentes.h"
+#include "HistoricoAcidentes.h"
+#include "LeitorAcidentes.h"
+#include "DescritorPosto.h"
+#include "SegmentoCheckpoint.h"
+#include "FicheiroAtomico.h"
+#include "EscritorPersistencia.h"
+#include "RegistoAlteracao.h"
+#include "ArquivoAcidentes.h"
+#include "LeitorArquivo.h"
+#include "ExportadorColunar.h"
+#include "ResultadoDespacho.h"
+#include "EmparelhadorMeios.h"
+#include "OtimizadorDespacho.h"
+#include "FilaPendentes.h"
+#include "RegioesDespacho.h"
+#include "MeiosPostos.h"
+#include "TabelaCapacidades.h"
+#include "MovimentoMeios.h"
+#include "MapaCobertura.h"
+
+class RebalanceadorFrota;
 
 /**
  * Proteção Civil que gere todos os acidentes e aciona os devidos meios de socorro
@@ -28,11 +60,185 @@ private:
 	const std::string ficheiroPostos;				/**< Ficheiro de onde é lida informação sobre todos os posto da Proteção Civil				*/
 	const std::string ficheiroAcidentes;			/**< Ficheiro de onde é lida/escrita informações sobre todos os acidentes 					*/
 	const std::string ficheiroLocais;				/**< Ficheiro de onde é lida informação sobre todos os locais ao abrigo da Proteção Civil	*/
+	const std::string ficheiroDiario;				/**< Ficheiro do diário de alterações feitas desde o último checkpoint						*/
+	const EscritorPersistencia::ModoDurabilidade modoDurabilidade;	/**< Modo de durabilidade do diário de alterações							*/
+	std::unique_ptr<EscritorPersistencia> escritor;	/**< Escritor do diário de alterações (thread dedicada), criado ao abrir os ficheiros		*/
+	IndiceAcidentes indiceAcidentes;				/**< Índice de bitmaps dos acidentes em decurso e terminados, por tipo, local, ano e outros atributos	*/
+	HistoricoAcidentes historico;					/**< Armazém colunar dos acidentes terminados												*/
+	ArquivoAcidentes arquivo;						/**< Arquivo em disco dos acidentes terminados, particionado por ano						*/
+	std::unique_ptr<LeitorArquivo> leitorArquivo;	/**< Leitor que materializa os acidentes arquivados a pedido, criado ao abrir os ficheiros	*/
+	std::map<std::string, unsigned int> indiceLocais;		/**< Índice dos locais por nome (posição no vetor de locais)								*/
+	std::map<unsigned int, Posto*> indicePostos;			/**< Índice dos postos por número de identificação											*/
+	std::vector< std::vector<Posto*> > rankingsPostos;		/**< Índice espacial: para cada local (mesma posição no vetor de locais), os postos por ordem crescente de distância	*/
+	std::unique_ptr<RegioesDespacho> regioes;				/**< Partição dos locais e postos em regiões para o despacho regional, criada ao abrir os ficheiros	*/
+	unsigned long long assinaturaBase;						/**< Assinatura do ficheiro de acidentes lido ao abrir (base dos segmentos de checkpoint)	*/
+	unsigned int numSegmentos;								/**< Número de segmentos de checkpoint já escritos sobre a base								*/
+	unsigned long long seqDiario;							/**< Número de sequência do último registo do diário já incluído num segmento				*/
+	std::set<unsigned int> postosAlterados;					/**< Números de identificação dos postos cuja capacidade mudou desde o último checkpoint		*/
+	std::map<unsigned int, const Acidente*> acidentesAbertos;	/**< Acidentes declarados desde o último checkpoint, por número de ocorrência			*/
+	std::set<unsigned int> acidentesFechados;				/**< Números de ocorrência dos acidentes (já gravados) terminados desde o último checkpoint	*/
+	FilaPendentes pendentes;								/**< Acidentes em decurso com necessidades por suprir, por gravidade e antiguidade			*/
+	MapaCobertura cobertura;								/**< Posto mais próximo com meios disponíveis de cada recurso, para cada local				*/
+	OtimizadorDespacho otimizador;							/**< Otimizador do despacho por lotes, mantido entre lotes (arranque a quente das redes de fluxo)	*/
+	RebalanceadorFrota* rebalanceador;						/**< Rebalanceador da frota associado (NULL caso não haja), que não pertence à Proteção Civil	*/
+	std::chrono::steady_clock::time_point ultimoCheckpoint;	/**< Instante do último checkpoint															*/
+
+	static const unsigned int INTERVALO_CHECKPOINT = 30;	/**< Intervalo (em segundos) a partir do qual é feito um checkpoint periódico				*/
+	static const unsigned int LADO_REGIOES = 4;				/**< Número de regiões em cada eixo da grelha de coordenadas, por omissão					*/
+	static const unsigned int LIMITE_ALTERACOES = 256;		/**< Número de alterações pendentes a partir do qual é feito um checkpoint periódico		*/
+
+	/**
+	 * @brief Lê o ficheiro de locais, lançando a exceção FicheiroNaoEncontrado caso não seja possível abri-lo
+	 * @param ficheiroLocais - Nome do ficheiro de locais
+	 * @return Retorna um vetor com todos os locais do ficheiro
+	 */
+	static std::vector<Local> lerLocais(const std::string &ficheiroLocais);
+
+	/**
+	 * @brief Lê o ficheiro de postos, sem resolver os locais dos postos, lançando a exceção FicheiroNaoEncontrado caso não seja possível abri-lo
+	 * @param ficheiroPostos - Nome do ficheiro de postos
+	 * @return Retorna um vetor com a descrição de todos os postos do ficheiro
+	 */
+	static std::vector<DescritorPosto> lerPostos(const std::string &ficheiroPostos);
+
+	/**
+	 * @brief Calcula, para cada local, a ordem dos postos por distância crescente a esse local
+	 */
+	void construirRankingsPostos();
+
+	/**
+	 * @brief Reconstrói o histórico dos acidentes terminados a partir de todos os blocos do arquivo e indexa-os (os registos com um local inexistente são ignorados)
+	 */
+	void carregarHistorico();
+
+	/**
+	 * @brief Recupera o estado após uma interrupção: aplica sobre os descritores lidos dos ficheiros (a base) os segmentos de checkpoint escritos sobre essa base e, depois, os registos do diário posteriores ao último segmento.
+	 * Os segmentos que pertençam a outra base são apagados; o diário é lido até ao primeiro registo truncado ou corrompido. As alterações vindas do diário ficam pendentes para o próximo checkpoint.
+	 * @param descritoresPostos - Descritores dos postos lidos do ficheiro de postos
+	 * @param descritoresAcidentes - Descritores dos acidentes lidos do ficheiro de acidentes
+	 * @param numerosAcidentes - Números de ocorrência dos acidentes (mesma posição no vetor de descritores)
+	 * @param abertosDiario - Conjunto onde são colocados os números de ocorrência dos acidentes declarados recuperados do diário
+	 * Os acidentes terminados no diário que ainda não estejam no arquivo são arquivados.
+	 */
+	void recuperar(std::vector<DescritorPosto> &descritoresPostos, std::vector<DescritorAcidente> &descritoresAcidentes, std::vector<unsigned int> &numerosAcidentes, std::set<unsigned int> &abertosDiario);
+
+	/**
+	 * @brief Marca como alterados os postos de onde saíram os meios das atribuições de um acidente, e atualiza o mapa de cobertura para esses postos
+	 * @param acidente - Acidente cujas atribuições foram feitas
+	 */
+	void marcarPostosAlterados(const Acidente* acidente);
 
 	/**
-	 * @brief Permite gravar toda a informação sobre postos e acidetes atuais no ficheiro de acidentes
+	 * @brief Envia para o diário o registo de uma alteração, com o estado final dos postos envolvidos
+	 * @param tipo - Tipo da alteração
+	 * @param acidente - Acidente declarado/terminado (pode ser NULL numa alteração do tipo POSTOS_ALTERADOS)
+	 * @param atribuicoes - Atribuições cujos postos mudaram de capacidade
+	 * @param aguardar - No modo POR_OPERACAO, indica se se espera que o registo esteja no disco (false quando a espera é feita uma só vez para um lote)
+	 * @return Retorna o número de sequência do registo no diário (0 caso o diário ainda não tenha sido iniciado)
 	 */
-	void gravar() const;
+	unsigned long long registarAlteracao(RegistoAlteracao::Tipo tipo, const Acidente* acidente, const std::vector<Atribuicao> &atribuicoes, bool aguardar = true);
+
+	/**
+	 * @brief Aciona os meios para um acidente, percorrendo os postos por uma dada ordem, e marca como alterados os postos de onde saíram meios
+	 * @param acidente - Apontador para o acidente
+	 * @param ordem - Postos por ordem de preferência (distância crescente ao local do acidente)
+	 * @return Retorna 0 se todas as necessidades foram supridas, 1 se apenas parte das necessidades foram supridas ou 2 caso não tenham sido acionados meios
+	 */
+	unsigned short despachar(Acidente* acidente, const std::vector<Posto*> &ordem);
+
+	/**
+	 * @brief Aciona os meios para um acidente, percorrendo os postos por uma dada ordem. Apenas altera o acidente e os contadores (atómicos) dos postos,
+	 * pelo que pode ser chamado por vários despachantes em simultâneo (ver despacharConcorrente)
+	 * @param acidente - Apontador para o acidente
+	 * @param ordem - Postos por ordem de preferência (distância crescente ao local do acidente)
+	 * @return Retorna 0 se todas as necessidades foram supridas, 1 se apenas parte das necessidades foram supridas ou 2 caso não tenham sido acionados meios
+	 */
+	unsigned short acionarMeios(Acidente* acidente, const std::vector<Posto*> &ordem);
+
+	/**
+	 * @brief Aciona os meios para um acidente, percorrendo os postos por uma dada ordem, sobre um instantâneo das capacidades dos postos (ver planearDespacho)
+	 * @param acidente - Apontador para o acidente
+	 * @param ordem - Postos por ordem de preferência (distância crescente ao local do acidente)
+	 * @param capacidades - Instantâneo de onde são reservados os veículos e as equipas (os postos não são alterados)
+	 * @return Retorna 0 se todas as necessidades foram supridas, 1 se apenas parte das necessidades foram supridas ou 2 caso não tenham sido acionados meios
+	 */
+	unsigned short acionarMeios(Acidente* acidente, const std::vector<Posto*> &ordem, TabelaCapacidades &capacidades) const;
+
+	/**
+	 * @brief Completa os meios de um acidente com postos de fora da sua região: para cada tipo de recurso em falta, reserva unidades (sem trincos) pela ordem dada.
+	 * Pode ser chamado por vários despachantes em simultâneo, desde que cada acidente seja tratado por um só despachante.
+	 * @param acidente - Apontador para o acidente, já com os meios da sua região
+	 * @param ordem - Postos das outras regiões por ordem crescente de distância ao local do acidente
+	 */
+	void reforcarDeFora(Acidente* acidente, const std::vector<Posto*> &ordem);
+
+	/**
+	 * @brief Conclui o despacho de um lote de acidentes a que já foram acionados meios: marca os postos alterados, calcula o que ficou em falta e aceita os acidentes
+	 * com meios acionados (uma só sincronização do diário no modo POR_OPERACAO)
+	 * @param acidentes - Acidentes do lote
+	 * @return Retorna o resultado de cada acidente, pela ordem recebida
+	 */
+	std::vector<ResultadoDespacho> concluirLote(const std::vector<Acidente*> &acidentes);
+
+	/**
+	 * @brief Coloca um acidente a que foram acionados meios ao encargo da Proteção Civil (vetor e índice de acidentes) e regista a sua declaração no diário
+	 * @param acidente - Apontador para o acidente
+	 * @param aguardar - No modo POR_OPERACAO, indica se se espera que o registo esteja no disco
+	 * @return Retorna o número de sequência do registo no diário (0 caso o diário ainda não tenha sido iniciado)
+	 */
+	unsigned long long aceitarAcidente(Acidente* acidente, bool aguardar);
+
+	/**
+	 * @brief Acrescenta um acidente despachado (aceite ou não) à procura recente do rebalanceador associado, caso haja
+	 * @param acidente - Acidente despachado
+	 */
+	void registarProcura(const Acidente* acidente);
+
+	/**
+	 * @brief Aplica (ver aplicarMovimentos) a proposta mais recente do rebalanceador associado, caso haja; chamado no fim de cada despacho, na thread que despacha.
+	 * Os movimentos inválidos da proposta são ignorados e contabilizados no rebalanceador (ver RebalanceadorFrota::getNumMovimentosInvalidos)
+	 */
+	void aplicarRebalanceamento();
+
+	/**
+	 * @brief Calcula, para cada tipo de recurso, o que ficou em falta para suprir as necessidades de um acidente, a partir das atribuições do resultado
+	 * @param acidente - Acidente a que foram acionados meios
+	 * @param resultado - Resultado do acionamento, com as atribuições efetuadas; é aqui colocado o que ficou em falta
+	 */
+	void calcularFalta(const Acidente* acidente, ResultadoDespacho &resultado) const;
+
+	/**
+	 * @brief Coloca na fila de pendentes um acidente em decurso a que faltam meios, ou retira-o caso já não lhe falte nada
+	 * @param acidente - Acidente em decurso
+	 */
+	void atualizarPendente(Acidente* acidente);
+
+	/**
+	 * @brief Envia os meios disponíveis num posto para os acidentes pendentes que precisam deles: em cada tipo de recurso, pela ordem da fila de pendentes
+	 * (os mais graves primeiro e, dentro da mesma gravidade, os mais antigos). Cada acidente reforçado é registado no diário (declaração que substitui a anterior).
+	 * @param posto - Posto a que foram retornados meios
+	 * @return Retorna os acidentes reforçados
+	 */
+	std::vector<Acidente*> reforcarPendentes(Posto* posto);
+
+	/**
+	 * @brief Termina um acidente (ver rmAcidente e terminarAcidente)
+	 * @param numOcorrencia - Número de identificação da ocorrência (acidente) a terminar
+	 * @param retornarMeios - Indica se os meios do acidente retornam de imediato aos seus postos
+	 * @param atribuicoes - Vetor onde são colocadas as atribuições do acidente
+	 * @return Retorna true se o acidente foi terminado e false caso não exista
+	 */
+	bool fecharAcidente(unsigned int numOcorrencia, bool retornarMeios, std::vector<Atribuicao> &atribuicoes);
+
+	/**
+	 * @brief Apaga todos os segmentos de checkpoint escritos sobre a base
+	 */
+	void apagarSegmentos();
+
+	/**
+	 * @brief Permite gravar toda a informação sobre postos e acidetes atuais nos ficheiros de postos e acidentes, de forma atómica, apagando depois os segmentos de checkpoint (já incluídos nos ficheiros)
+	 */
+	void gravar();
 
 	/**
 	 * @brief Permite obter o maior numero de identificação dos acidentes no vetor de acidentes
@@ -53,8 +259,11 @@ public:
 	 * @param ficheiroPostos - ficheiro de onde são lidos os posto
 	 * @param ficheiroAcidentes - ficheiro de onde são lidos os acidentes
 	 * @param ficheiroLocais - ficheiro de onde são lidos os locais
+	 * @param modoDurabilidade - Modo de durabilidade do diário de alterações
+	 * @param modoVerificacao - Momento em que são verificados os checksums dos blocos do arquivo (ao abrir, ou apenas quando cada bloco é lido)
 	 */
-	ProtecaoCivil(const std::string &ficheiroPostos, const std::string &ficheiroAcidentes, const std::string &ficheiroLocais);
+	ProtecaoCivil(const std::string &ficheiroPostos, const std::string &ficheiroAcidentes, const std::string &ficheiroLocais, EscritorPersistencia::ModoDurabilidade modoDurabilidade = EscritorPersistencia::POR_LOTE,
+			ArquivoAcidentes::ModoVerificacao modoVerificacao = ArquivoAcidentes::VERIFICAR_AO_LER);
 
 	/**
 	 * @brief Destrutor da classe ProtecaoCivil
@@ -62,41 +271,161 @@ public:
 	~ProtecaoCivil();
 
 	/**
-	 * @brief Adiciona um acidente ao vetor de acidentes da Proteção Civil, lançando as exceções MeiosInsuficientes ou MeiosInexistentes caso necessário.
+	 * @brief Adiciona um acidente ao vetor de acidentes da Proteção Civil, lançando as exceções MeiosInsuficientes ou MeiosInexistentes caso necessário (ver despacharAcidente).
 	 * @param acidente - Apontador para o acidente a dar entrada na Proteção Civil
 	 */
 	void addAcidente(Acidente* acidente);
 
 	/**
-	 * @brief Adiciona um acidente de viação ao vetor de acidentes da Proteção Civil
-	 * @param acidenteViacao - Apontador para o acidente de viação a dar entrada na Proteção Civil
-	 * @return Retorna 0 se a inserção tiver sucesso (todos as necessidades foram supridas) , 1 se apenas parte das necessidades forem supridas ou 2 caso não haja quaisquer meios para suprir as necessidades do acidente
+	 * @brief Aciona os meios para um acidente e, caso tenham sido acionados alguns meios, adiciona-o ao vetor de acidentes da Proteção Civil, sem lançar exceções.
+	 * Caso não sejam acionados quaisquer meios, o acidente não é adicionado e continua a pertencer a quem o criou.
+	 * @param acidente - Apontador para o acidente a dar entrada na Proteção Civil
+	 * @return Retorna o grau de sucesso, as atribuições efetuadas e o que ficou em falta de cada tipo de recurso
+	 */
+	ResultadoDespacho despacharAcidente(Acidente* acidente);
+
+	/**
+	 * @brief Dá entrada a um conjunto de acidentes de uma só vez (ex: picos de ocorrências durante tempestades). Os descritores são validados numa só passagem e os acidentes
+	 * são despachados pela ordem recebida, com os rankings de postos já calculados para cada local, sem lançar exceções por acidente.
+	 * No modo POR_OPERACAO, o diário é sincronizado uma só vez para todo o lote.
+	 * @param descritores - Descrições dos acidentes, no formato do ficheiro de acidentes
+	 * @return Retorna o resultado de cada acidente, pela ordem dos descritores (INVALIDO, com a descrição do erro, para os descritores inválidos ou com um local inexistente)
 	 */
-	unsigned short addAcidenteViacao(AcidenteViacao* acidenteViacao);
+	std::vector<ResultadoDespacho> ingerirAcidentes(const std::vector<DescritorAcidente> &descritores);
 
 	/**
-	 * @brief Adiciona um assalto ao vetor de acidentes da Proteção Civil
-	 * @param assalto - Apontador para o assalto a dar entrada na Proteção Civil
-	 * @return Retorna 0 se a inserção tiver sucesso (todos as necessidades foram supridas) , 1 se apenas parte das necessidades forem supridas ou 2 caso não haja quaisquer meios para suprir as necessidades do acidente
+	 * @brief Dá entrada a todos os acidentes de um ficheiro no formato do ficheiro de acidentes (ver ingerirAcidentes), lançando a exceção FicheiroNaoEncontrado caso não seja possível abri-lo
+	 * @param ficheiro - Nome do ficheiro
+	 * @return Retorna o resultado de cada acidente, pela ordem do ficheiro
 	 */
-	unsigned short addAssalto(Assalto* assalto);
+	std::vector<ResultadoDespacho> ingerirFicheiro(const std::string &ficheiro);
 
 	/**
-	 * @brief Adiciona um incêndio ao vetor de acidentes da Proteção Civil
-	 * @param incendio - Apontador para o incêndio a dar entrada na Proteção Civil
-	 * @return Retorna 0 se a inserção tiver sucesso (todos as necessidades foram supridas) , 1 se apenas parte das necessidades forem supridas ou 2 caso não haja quaisquer meios para suprir as necessidades do acidente
+	 * @brief Aciona os meios para um lote de acidentes em conjunto (ver OtimizadorDespacho): em vez de cada acidente ficar, por ordem, com os meios mais próximos,
+	 * as unidades de cada recurso são distribuídas por todo o lote de forma a minimizar a distância total percorrida, sem lançar exceções.
+	 * Os acidentes com meios acionados são adicionados ao vetor de acidentes da Proteção Civil; os restantes continuam a pertencer a quem os criou.
+	 * No modo POR_OPERACAO, o diário é sincronizado uma só vez para todo o lote.
+	 * @param acidentes - Apontadores para os acidentes a dar entrada na Proteção Civil
+	 * @return Retorna o resultado de cada acidente, pela ordem recebida
 	 */
-	unsigned short addIncendio(Incendio* incendio);
+	std::vector<ResultadoDespacho> despacharLote(const std::vector<Acidente*> &acidentes);
 
 	/**
-	 * @brief Remove um acidente do vetor de acidentes da Proteção Civil
+	 * @brief Aciona os meios para vários grupos de acidentes em simultâneo (ex: um grupo por região), um despachante (thread) por grupo, sem exceções por acidente.
+	 * Os despachantes reservam os meios diretamente nos contadores atómicos dos postos (ver Posto::reservar), sem trincos; depois de todos terminarem,
+	 * os acidentes com meios acionados são adicionados ao vetor de acidentes da Proteção Civil e registados no diário (uma só sincronização no modo POR_OPERACAO).
+	 * Os acidentes sem meios acionados continuam a pertencer a quem os criou. Não pode ser chamado em simultâneo com outros métodos da Proteção Civil.
+	 * @param grupos - Grupos de apontadores para os acidentes a dar entrada na Proteção Civil
+	 * @return Retorna o resultado de cada acidente, com a mesma organização dos grupos
+	 */
+	std::vector< std::vector<ResultadoDespacho> > despacharConcorrente(const std::vector< std::vector<Acidente*> > &grupos);
+
+	/**
+	 * @brief Aciona os meios para um lote de acidentes por regiões (ver RegioesDespacho), com o despachante (thread) de cada região, criado com a partição, e sem exceções por acidente.
+	 * Em primeiro lugar, cada despachante serve os acidentes da sua região apenas com os postos dessa região. Depois de todas as regiões terem terminado,
+	 * os acidentes a que ainda faltam meios são completados com os postos das outras regiões, por ordem de distância (as regiões servem primeiro os seus acidentes).
+	 * Os meios são reservados nos contadores atómicos dos postos; os acidentes com meios acionados são aceites no fim, como em despacharLote.
+	 * Não pode ser chamado em simultâneo com outros métodos da Proteção Civil.
+	 * @param acidentes - Apontadores para os acidentes a dar entrada na Proteção Civil
+	 * @return Retorna o resultado de cada acidente, pela ordem recebida
+	 */
+	std::vector<ResultadoDespacho> despacharRegioes(const std::vector<Acidente*> &acidentes);
+
+	/**
+	 * @brief Associa um rebalanceador da frota à Proteção Civil e inicia o cálculo das suas propostas em segundo plano (ver RebalanceadorFrota::iniciar).
+	 * A partir daí, cada acidente despachado conta para a procura recente do rebalanceador, e a proposta mais recente é aplicada no fim de cada despacho, na thread que despacha.
+	 * @param rebalanceador - Rebalanceador criado sobre esta Proteção Civil, que não passa a pertencer-lhe (NULL para desassociar o atual, cujo cálculo em segundo plano é terminado)
+	 */
+	void associarRebalanceador(RebalanceadorFrota* rebalanceador);
+
+	/**
+	 * @brief Divide de novo os locais e os postos em regiões, para o despacho regional
+	 * @param lado - Número de regiões em cada eixo da grelha de coordenadas
+	 */
+	void particionarRegioes(unsigned int lado);
+
+	/**
+	 * @brief Tira um instantâneo das capacidades atuais dos postos, sobre o qual se pode planear o despacho (ver planearDespacho).
+	 * Apenas lê os contadores atómicos dos postos, pelo que pode ser chamado em simultâneo com o despacho.
+	 * @return Retorna o instantâneo das capacidades
+	 */
+	TabelaCapacidades getCapacidades() const;
+
+	/**
+	 * @brief Planeia o despacho de um cenário de acidentes sem o efetuar: os acidentes são despachados pela ordem dada, com o mesmo algoritmo de addAcidente,
+	 * mas os meios são reservados no instantâneo dado, e não nos postos. Nenhum acidente é criado nem registado e os postos não são alterados.
+	 * Pode ser chamado por várias threads em simultâneo e em simultâneo com o despacho, desde que cada thread use a sua cópia do instantâneo.
+	 * @param descritores - Acidentes do cenário
+	 * @param capacidades - Instantâneo das capacidades, de onde saem os meios planeados (copiar antes o instantâneo para o manter)
+	 * @return Retorna o resultado planeado para cada acidente, pela ordem recebida
+	 */
+	std::vector<ResultadoDespacho> planearDespacho(const std::vector<DescritorAcidente> &descritores, TabelaCapacidades &capacidades) const;
+
+	/**
+	 * @brief Planeia o despacho de um acidente já criado sem o efetuar (ver planearDespacho): os meios são reservados no instantâneo dado e as atribuições planeadas
+	 * ficam no acidente, que não é registado na Proteção Civil (por exemplo, para simular a ocupação dos meios ao longo do tempo, ver SimuladorEventos)
+	 * @param acidente - Acidente, num dos locais da Proteção Civil
+	 * @param capacidades - Instantâneo das capacidades, de onde saem os meios planeados
+	 * @return Retorna os meios planeados e o que fica em falta
+	 */
+	ResultadoDespacho planearDespacho(Acidente* acidente, TabelaCapacidades &capacidades) const;
+
+	/**
+	 * @brief Planeia o regresso dos meios de uma atribuição ao seu posto, tal como regressarMeios, mas num instantâneo e com uma fila de pendentes dada:
+	 * os meios são repostos no instantâneo e seguem de imediato para os acidentes da fila que precisem deles. Nada é registado na Proteção Civil.
+	 * @param atribuicao - Atribuição cujos meios chegam ao posto
+	 * @param capacidades - Instantâneo das capacidades
+	 * @param pendentesPlaneados - Fila dos acidentes planeados com necessidades por suprir (atualizada com os reforços)
+	 * @return Retorna os acidentes da fila reforçados com esses meios
+	 */
+	std::vector<Acidente*> planearRegresso(const Atribuicao &atribuicao, TabelaCapacidades &capacidades, FilaPendentes &pendentesPlaneados) const;
+
+	/**
+	 * @brief Planeia o despacho de um acidente sem o efetuar, sobre as capacidades atuais dos postos (ver planearDespacho)
+	 * @param descritor - Acidente candidato
+	 * @return Retorna os meios que seriam enviados e o que ficaria em falta
+	 */
+	ResultadoDespacho planearDespacho(const DescritorAcidente &descritor) const;
+
+	/**
+	 * @brief Remove um acidente do vetor de acidentes da Proteção Civil, passando-o para o histórico de acidentes terminados
 	 * @param numOcorrencia - Número de identificação da ocorrência (acidente) a remover.
 	 * @return Retorna true se a remoção tiver sucesso e false caso contrário
 	 */
 	bool rmAcidente(unsigned int numOcorrencia);
 
 	/**
-	 * @brief Lê o conteúdo dos ficheiros de postos, acidentes e locais, colocando o seu conteúdo nos respetivos vetores de postos, acidentes e locais, lançando um exceção (Erro) caso a leitura de algum dos ficheiros falhe
+	 * @brief Termina um acidente, tal como rmAcidente, mas sem retornar os seus meios: os meios ficam em regresso aos postos e só voltam a estar disponíveis
+	 * quando forem retornados com regressarMeios
+	 * @param numOcorrencia - Número de identificação da ocorrência (acidente) a terminar
+	 * @param meiosEmRegresso - Vetor onde são colocadas as atribuições do acidente, cujos meios estão agora em regresso
+	 * @return Retorna true se o acidente foi terminado e false caso não exista
+	 */
+	bool terminarAcidente(unsigned int numOcorrencia, std::vector<Atribuicao> &meiosEmRegresso);
+
+	/**
+	 * @brief Retorna ao seu posto os meios de uma atribuição que estavam em regresso (ver terminarAcidente) e regista no diário o novo estado do posto
+	 * @param atribuicao - Atribuição cujos meios chegaram ao posto
+	 * @return Retorna os acidentes pendentes reforçados com esses meios (ver retornarAtribuicao)
+	 */
+	std::vector<Acidente*> regressarMeios(const Atribuicao & atribuicao);
+
+	/**
+	 * @brief Transfere meios entre postos (por exemplo, os propostos por RebalanceadorFrota), de forma atómica: ou são feitos todos os movimentos válidos ou nenhum.
+	 * Os movimentos inválidos (entre postos inexistentes, iguais ou incompatíveis) são ignorados e devolvidos em invalidos, sem afetar os restantes.
+	 * Os meios são primeiro reservados em todos os postos de origem (ver Posto::reservar), pelo que um despacho em curso noutra thread nunca os vê em dois postos;
+	 * caso algum posto de origem já não tenha os meios (a proposta foi calculada sobre um instantâneo entretanto desatualizado), as reservas feitas são desfeitas.
+	 * O novo estado de todos os postos envolvidos fica num único registo do diário, e os meios que chegam aos postos de destino seguem de imediato para os acidentes pendentes que precisem deles
+	 * @param movimentos - Movimentos a efetuar
+	 * @param invalidos - Caso não seja nulo, vetor onde são acrescentados os movimentos inválidos ignorados
+	 * @return Retorna true caso os movimentos válidos tenham sido feitos e false caso algum posto de origem não tenha os meios (os postos ficam como estavam)
+	 */
+	bool aplicarMovimentos(const std::vector<MovimentoMeios> &movimentos, std::vector<MovimentoMeios>* invalidos = NULL);
+
+	/**
+	 * @brief Lê o conteúdo dos ficheiros de postos, acidentes e locais, colocando o seu conteúdo nos respetivos vetores de postos, acidentes e locais, lançando um exceção (Erro) caso a leitura de algum dos ficheiros falhe.
+	 * Os três ficheiros são lidos em paralelo; os locais são resolvidos no fim e os índices construídos em paralelo. No fim é iniciado o escritor do diário de alterações.
+	 * Uma entrada do ficheiro de acidentes mal formada ou que não represente um acidente válido lança a exceção InputInvalido, com o número da linha
 	 */
 	void openFiles();
 
@@ -159,7 +488,7 @@ public:
 	void printAcidentesData(const std::string &data) const;
 
 	/**
-	 * @brief Imprime no ecrã o acidente declarado à proteção civil com o id passado por parâmetro
+	 * @brief Imprime no ecrã o acidente declarado à proteção civil com o id passado por parâmetro (caso já tenha terminado, é procurado no arquivo)
 	 * @param id - Número de identificação do acidente a imprimir
 	 */
 	void printAcidentesId(unsigned int id) const;
@@ -190,6 +519,26 @@ public:
 	 */
 	const Local * getLocal(const std::string &nomeLocal) const;
 
+	/**
+	 * @brief Procura um posto pelo seu número de identificação
+	 * @param id - Número de identificação do posto
+	 * @return Retorna o apontador para o posto ou NULL caso não exista
+	 */
+	const Posto * getPosto(unsigned int id) const;
+
+	/**
+	 * @brief Permite obter os locais ao abrigo da Proteção Civil
+	 * @return Retorna o vetor de locais
+	 */
+	const std::vector<Local> & getLocais() const;
+
+	/**
+	 * @brief Permite obter os postos por ordem crescente de distância a um local (índice espacial construído ao abrir os ficheiros, que não muda depois)
+	 * @param indiceLocal - Posição do local no vetor de locais (ver findLocal)
+	 * @return Retorna os postos, do mais próximo para o mais afastado
+	 */
+	const std::vector<Posto*> & getRankingPostos(unsigned int indiceLocal) const;
+
 	/**
 	 * @brief Permite obter o numero de ocorrência da ocorrência com maior número
 	 * @return Retorna o número da ocorrência com maior número de ocorrência
@@ -197,10 +546,103 @@ public:
 	unsigned int getMaxNumOcorrencia() const;
 
 	/**
-	 * @brief Retorna os meios de uma atribuicao de volta ao seu posto
+	 * @brief Retorna os meios de uma atribuicao de volta ao seu posto, que os envia de imediato para os acidentes pendentes que precisem deles (ver FilaPendentes)
 	 * @param atribuicao - Atribuicao em questão
+	 * @return Retorna os acidentes pendentes que foram reforçados com os meios retornados
+	 */
+	std::vector<Acidente*> retornarAtribuicao(const Atribuicao & atribuicao);
+
+	/**
+	 * @brief Permite obter o índice de bitmaps dos acidentes em decurso e terminados, para construir filtros combinados (ex: getTipo("Assalto") & getAno(2010) & getEmDecurso())
+	 * @return Retorna o índice dos acidentes
+	 */
+	const IndiceAcidentes & getIndiceAcidentes() const;
+
+	/**
+	 * @brief Permite obter os acidentes em decurso cujas linhas pertencem a um bitmap (resultado de um filtro sobre o índice de acidentes), percorrendo apenas as linhas do bitmap
+	 * @param filtro - Bitmap com as linhas dos acidentes pretendidos
+	 * @return Retorna um vetor com apontadores para os acidentes em decurso que pertencem ao filtro, pela ordem das linhas
+	 */
+	std::vector<Acidente*> getAcidentesFiltro(const BitmapComprimido &filtro) const;
+
+	/**
+	 * @brief Permite obter os acidentes terminados cujas linhas pertencem a um bitmap (resultado de um filtro sobre o índice de acidentes), percorrendo apenas as linhas do bitmap
+	 * @param filtro - Bitmap com as linhas dos acidentes pretendidos
+	 * @return Retorna as linhas do histórico (ver getHistorico) dos acidentes terminados que pertencem ao filtro
+	 */
+	std::vector<unsigned int> getHistoricoFiltro(const BitmapComprimido &filtro) const;
+
+	/**
+	 * @brief Permite obter o histórico (armazém colunar) dos acidentes terminados
+	 * @return Retorna o histórico dos acidentes terminados
+	 */
+	const HistoricoAcidentes & getHistorico() const;
+
+	/**
+	 * @brief Permite obter a fila dos acidentes em decurso com necessidades por suprir
+	 * @return Retorna a fila de pendentes
+	 */
+	const FilaPendentes & getPendentes() const;
+
+	/**
+	 * @brief Permite obter o mapa de cobertura, mantido a cada alteração dos meios dos postos (por exemplo, para saber que locais não têm uma ambulância disponível a uma dada distância)
+	 * @return Retorna o mapa de cobertura
+	 */
+	const MapaCobertura & getCobertura() const;
+
+	/**
+	 * @brief Permite obter o otimizador do despacho por lotes (por exemplo, para comparar a distância percorrida com a do despacho guloso, ver OtimizadorDespacho::getDistanciaGulosa)
+	 * @return Retorna o otimizador do despacho por lotes
+	 */
+	const OtimizadorDespacho & getOtimizador() const;
+
+	/**
+	 * @brief Procura no arquivo os acidentes terminados com um dado número de ocorrência
+	 * @param numOcorrencia - Número de ocorrência a procurar
+	 * @return Retorna os registos do arquivo com esse número de ocorrência
+	 */
+	std::vector<RegistoArquivo> getArquivoNumero(unsigned int numOcorrencia) const;
+
+	/**
+	 * @brief Procura no arquivo os acidentes terminados que ocorreram num intervalo de datas (lendo apenas as partições e os blocos relevantes)
+	 * @param inicio - Data inicial (inclusive)
+	 * @param fim - Data final (inclusive)
+	 * @return Retorna os registos do arquivo ocorridos no intervalo
+	 */
+	std::vector<RegistoArquivo> getArquivoIntervalo(const Date &inicio, const Date &fim) const;
+
+	/**
+	 * @brief Materializa o acidente terminado mais recente com um dado número de ocorrência, lendo do arquivo apenas o seu registo (com cache dos últimos acidentes pedidos)
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @return Retorna o acidente arquivado, ou um apontador nulo caso não exista
+	 */
+	std::shared_ptr<const Acidente> getAcidenteArquivado(unsigned int numOcorrencia) const;
+
+	/**
+	 * @brief Exporta os acidentes em decurso e todos os acidentes arquivados (com as suas atribuições) em colunas de largura fixa, para análise externa, numa única passagem pelo arquivo (bloco a bloco).
+	 * Lança a exceção ErroEscrita em caso de falha na escrita e DadosCorrompidos caso um bloco do arquivo esteja corrompido.
+	 * @param prefixo - Prefixo dos nomes dos ficheiros exportados
+	 * @return Retorna o número de acidentes exportados
+	 */
+	unsigned long long exportarColunas(const std::string &prefixo) const;
+
+	/**
+	 * @brief Grava um checkpoint incremental: escreve, num novo segmento, apenas os postos cuja capacidade mudou e os acidentes declarados ou terminados desde o último checkpoint.
+	 * A escrita é atómica (ficheiro temporário, fsync e renomeação), pelo que uma interrupção a meio não corrompe os ficheiros já gravados. Lança a exceção ErroEscrita em caso de falha.
+	 */
+	void checkpoint();
+
+	/**
+	 * @brief Grava um checkpoint incremental caso tenham passado INTERVALO_CHECKPOINT segundos desde o último ou haja pelo menos LIMITE_ALTERACOES alterações pendentes
+	 * @return Retorna true caso tenha sido gravado um checkpoint e false caso contrário
+	 */
+	bool checkpointPeriodico();
+
+	/**
+	 * @brief Permite obter o número de alterações (postos e acidentes) ainda não gravadas num checkpoint
+	 * @return Retorna o número de alterações pendentes
 	 */
-	void retornarAtribuicao(const Atribuicao & atribuicao);
+	unsigned int getNumAlteracoesPendentes() const;
 };
 
 #endif /* PROTECAOCIVIL_H_ */
@@ -0,0 +1,169 @@
+#ifndef REBALANCEADORFROTA_H_
+#define REBALANCEADORFROTA_H_
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "ProtecaoCivil.h"
+#include "TabelaCapacidades.h"
+#include "MovimentoMeios.h"
+
+/**
+ * Otimizador da distribuição da frota pelos postos: depois de uma série de acidentes, os postos perto dos focos ficam sem meios enquanto os mais afastados continuam cheios.
+ * O rebalanceador acompanha a procura recente (os últimos acidentes, por local e tipo de recurso) e propõe transferências de veículos, com as suas equipas, entre postos do mesmo tipo
+ * que reduzam a distância de resposta esperada.
+ *
+ * A distância esperada de um local para um recurso é a distância média das unidades que o despacho guloso lhe enviaria: as mais próximas, percorrendo os postos por ordem de distância,
+ * tantas quantas os acidentes recentes desse local precisaram em média (as unidades que não existem contam como uma penalização). O custo total é a soma, por local, dessa distância
+ * pesada pelas unidades pedidas. As propostas são calculadas sobre um instantâneo das capacidades (TabelaCapacidades), com movimentos de um veículo de cada vez escolhidos de forma gulosa;
+ * cada movimento candidato só recalcula os locais cujas unidades mais próximas podem mudar (aqueles para quem a origem ou o destino estão dentro do raio das unidades que usam).
+ *
+ * Em segundo plano (iniciar), as propostas são recalculadas periodicamente numa thread própria, que só lê a Proteção Civil (ver ProtecaoCivil::getCapacidades);
+ * a thread de despacho obtém a proposta mais recente com obterProposta e aplica-a de forma atómica com ProtecaoCivil::aplicarMovimentos.
+ * Associado à Proteção Civil (ver ProtecaoCivil::associarRebalanceador), o rebalanceador é iniciado e alimentado com os acidentes despachados, e as suas propostas
+ * são aplicadas no fim de cada despacho.
+ */
+class RebalanceadorFrota {
+public:
+	/**
+	 * Parâmetros do rebalanceador
+	 */
+	struct Parametros {
+		unsigned int janela;			/**< Número de acidentes recentes que formam a procura									*/
+		unsigned int maxVeiculos;		/**< Número máximo de veículos transferidos por proposta									*/
+		unsigned int reservaMinima;		/**< Unidades de cada recurso que um posto de origem mantém sempre							*/
+		double ganhoMinimo;				/**< Redução mínima do custo total (distância x unidades) para transferir mais um veículo	*/
+		unsigned int intervalo;			/**< Milissegundos entre propostas calculadas em segundo plano								*/
+
+		/**
+		 * @brief Construtor da struct Parametros, com valores por omissão
+		 */
+		Parametros();
+	};
+
+	/**
+	 * Proposta de transferências entre postos
+	 */
+	struct Proposta {
+		std::vector<MovimentoMeios> movimentos;		/**< Movimentos a aplicar (ver ProtecaoCivil::aplicarMovimentos)					*/
+		double distanciaAntes;						/**< Distância esperada por unidade pedida, com as capacidades atuais				*/
+		double distanciaDepois;						/**< Distância esperada por unidade pedida, depois de aplicados os movimentos		*/
+
+		/**
+		 * @brief Construtor da struct Proposta, sem movimentos
+		 */
+		Proposta();
+	};
+private:
+	/**
+	 * Procura recente de um recurso num local
+	 */
+	struct ProcuraLocal {
+		unsigned int unidades;			/**< Unidades pedidas pelos acidentes recentes		*/
+		unsigned int acidentes;			/**< Acidentes recentes que pediram o recurso		*/
+	};
+
+	/**
+	 * Acidente recente
+	 */
+	struct AcidenteRecente {
+		unsigned int indiceLocal;								/**< Posição do local no vetor de locais		*/
+		unsigned int unidades[ResultadoDespacho::NUM_RECURSOS];	/**< Unidades pedidas de cada recurso			*/
+	};
+
+	typedef std::vector< std::vector<ProcuraLocal> > Procura;	/**< Procura por local e por recurso */
+
+	const ProtecaoCivil &protecaoCivil;					/**< Proteção Civil (só lida)															*/
+	const Parametros parametros;						/**< Parâmetros do rebalanceador														*/
+	std::vector<const Posto*> postos;					/**< Postos da Proteção Civil															*/
+	double penalizacao;									/**< Distância atribuída a uma unidade que não existe (o dobro da maior distância)		*/
+	std::deque<AcidenteRecente> recentes;				/**< Acidentes da janela, do mais antigo para o mais recente							*/
+	Procura procura;									/**< Procura acumulada dos acidentes da janela											*/
+	std::shared_ptr<const Proposta> proposta;			/**< Proposta mais recente calculada em segundo plano (nula caso não haja nada a mover)	*/
+	unsigned int numMovimentosInvalidos;				/**< Movimentos propostos que foram ignorados por serem inválidos						*/
+	bool aTerminar;										/**< Indica que a thread de segundo plano deve terminar									*/
+	mutable std::mutex trinco;							/**< Protege a procura, a proposta, os movimentos inválidos e o pedido de terminação	*/
+	std::condition_variable acordar;					/**< Acorda a thread de segundo plano para terminar										*/
+	std::thread thread;									/**< Thread de segundo plano															*/
+
+	/**
+	 * @brief Calcula a distância esperada de um local para um recurso, pesada pelas unidades pedidas
+	 * @param capacidades - Capacidades dos postos
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @param recurso - Tipo de recurso
+	 * @param procuraLocal - Procura recente do recurso no local
+	 * @param raio - Onde é colocada a distância da última unidade usada (infinita caso faltem unidades)
+	 * @return Retorna o custo do local para o recurso
+	 */
+	double calcularCusto(const TabelaCapacidades &capacidades, unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, const ProcuraLocal &procuraLocal, double &raio) const;
+
+	/**
+	 * @brief Calcula uma proposta para uma dada procura
+	 * @param capacidades - Capacidades dos postos
+	 * @param procuraAtual - Procura recente
+	 * @return Retorna a proposta (sem movimentos caso nenhum reduza o custo o suficiente)
+	 */
+	Proposta calcularProposta(const TabelaCapacidades &capacidades, const Procura &procuraAtual) const;
+
+	/**
+	 * @brief Ciclo da thread de segundo plano: periodicamente, calcula uma proposta sobre um novo instantâneo das capacidades e publica-a
+	 */
+	void executar();
+public:
+	/**
+	 * @brief Construtor da classe RebalanceadorFrota
+	 * @param protecaoCivil - Proteção Civil (com os ficheiros já abertos)
+	 * @param parametros - Parâmetros do rebalanceador
+	 */
+	RebalanceadorFrota(const ProtecaoCivil &protecaoCivil, const Parametros &parametros = Parametros());
+
+	/**
+	 * @brief Destrutor da classe RebalanceadorFrota, termina a thread de segundo plano
+	 */
+	~RebalanceadorFrota();
+
+	/**
+	 * @brief Acrescenta um acidente à procura recente (o mais antigo da janela deixa de contar)
+	 * @param acidente - Acidente declarado
+	 */
+	void registarProcura(const Acidente* acidente);
+
+	/**
+	 * @brief Calcula uma proposta para a procura recente (na thread que a chama)
+	 * @param capacidades - Capacidades dos postos (por exemplo, ProtecaoCivil::getCapacidades)
+	 * @return Retorna a proposta (sem movimentos caso nenhum reduza o custo o suficiente)
+	 */
+	Proposta calcularProposta(const TabelaCapacidades &capacidades) const;
+
+	/**
+	 * @brief Inicia o cálculo periódico de propostas em segundo plano (não faz nada caso já tenha sido iniciado)
+	 */
+	void iniciar();
+
+	/**
+	 * @brief Termina o cálculo periódico de propostas em segundo plano
+	 */
+	void parar();
+
+	/**
+	 * @brief Retira a proposta mais recente calculada em segundo plano
+	 * @return Retorna a proposta, ou um apontador nulo caso não haja nenhuma por aplicar
+	 */
+	std::shared_ptr<const Proposta> obterProposta();
+
+	/**
+	 * @brief Contabiliza movimentos de uma proposta que foram ignorados ao aplicá-la por serem inválidos (ver ProtecaoCivil::aplicarMovimentos)
+	 * @param num - Número de movimentos inválidos
+	 */
+	void registarMovimentosInvalidos(unsigned int num);
+
+	/**
+	 * @brief Permite obter o número de movimentos propostos que foram ignorados por serem inválidos
+	 * @return Retorna o número de movimentos inválidos
+	 */
+	unsigned int getNumMovimentosInvalidos() const;
+};
+
+#endif /* REBALANCEADORFROTA_H_ */
@@ -0,0 +1,115 @@
+#ifndef REGIOESDESPACHO_H_
+#define REGIOESDESPACHO_H_
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "Local.h"
+#include "Posto.h"
+
+/**
+ * Partição do território em regiões para o despacho regional (ver ProtecaoCivil::despacharRegioes): a grelha de coordenadas dos locais é dividida em lado x lado regiões retangulares
+ * e cada região fica com os postos e os acidentes dos locais que nela se encontram.
+ * Para cada local são guardadas duas ordens de postos (derivadas dos rankings por distância): os postos da sua região, usados primeiro, e os postos das outras regiões, usados apenas
+ * quando os meios da região não chegam.
+ *
+ * Cada região com locais tem o seu despachante (thread), criado com a partição e terminado pelo destrutor: em cada fase do despacho, o despachante de cada região
+ * recebe a tarefa da sua região (ver executar), em vez de ser criada uma thread por região em cada despacho.
+ */
+class RegioesDespacho {
+private:
+	unsigned int lado;										/**< Número de regiões em cada eixo da grelha								*/
+	unsigned int minX, minY;								/**< Menores coordenadas dos locais											*/
+	unsigned int largura, altura;							/**< Dimensões da grelha (diferença entre as maiores e as menores coordenadas, mais 1)	*/
+	std::vector<unsigned int> regiaoLocal;					/**< Região de cada local (mesma posição no vetor de locais)				*/
+	std::vector< std::vector<Posto*> > postosRegiao;		/**< Postos de cada região													*/
+	std::vector< std::vector<Posto*> > ordemRegiao;			/**< Para cada local, os postos da sua região por ordem crescente de distância	*/
+	std::vector< std::vector<Posto*> > ordemFora;			/**< Para cada local, os postos das outras regiões por ordem crescente de distância	*/
+	std::vector< std::vector<unsigned int> > locaisRegiao;	/**< Posições (no vetor de locais) dos locais de cada região				*/
+	std::vector<std::thread> despachantes;					/**< Despachante de cada região (sem thread nas regiões sem locais)		*/
+	std::vector< std::function<void()> > tarefas;			/**< Tarefa por executar de cada região (vazia caso não haja)			*/
+	unsigned int porTerminar;								/**< Número de tarefas entregues e ainda não terminadas					*/
+	bool aTerminar;											/**< Indica que os despachantes devem terminar							*/
+	std::mutex trinco;										/**< Protege as tarefas e os indicadores acima							*/
+	std::condition_variable haTarefas;						/**< Sinaliza os despachantes de que há tarefas (ou de que devem terminar)	*/
+	std::condition_variable terminadas;						/**< Sinaliza quem entregou as tarefas de que mais tarefas terminaram	*/
+
+	/**
+	 * @brief Ciclo do despachante de uma região: executa as tarefas entregues à região até ser pedido que termine
+	 * @param regiao - Índice da região
+	 */
+	void executarRegiao(unsigned int regiao);
+
+	/**
+	 * @brief Calcula a região a que pertencem umas coordenadas
+	 * @param x - Coordenada x
+	 * @param y - Coordenada y
+	 * @return Retorna o índice da região
+	 */
+	unsigned int calcularRegiao(unsigned int x, unsigned int y) const;
+public:
+	/**
+	 * @brief Construtor da classe RegioesDespacho, divide os locais e os postos pelas regiões
+	 * @param locais - Locais da Proteção Civil
+	 * @param postos - Postos da Proteção Civil
+	 * @param rankingsPostos - Para cada local (mesma posição no vetor de locais), todos os postos por ordem crescente de distância
+	 * @param lado - Número de regiões em cada eixo da grelha (pelo menos 1)
+	 */
+	RegioesDespacho(const std::vector<Local> &locais, const std::vector<Posto*> &postos, const std::vector< std::vector<Posto*> > &rankingsPostos, unsigned int lado);
+
+	/**
+	 * @brief Destrutor da classe RegioesDespacho, termina os despachantes das regiões
+	 */
+	~RegioesDespacho();
+
+	/**
+	 * @brief Executa uma tarefa por região, cada uma no despachante da sua região, e espera que todas terminem. Não pode ser chamado em simultâneo
+	 * @param tarefasRegioes - Tarefa de cada região (as vazias não são executadas; as das regiões sem locais também não)
+	 */
+	void executar(const std::vector< std::function<void()> > &tarefasRegioes);
+
+	/**
+	 * @brief Permite obter o número de regiões (incluindo as que não têm locais)
+	 * @return Retorna lado x lado
+	 */
+	unsigned int getNumRegioes() const;
+
+	/**
+	 * @brief Permite obter a região de um local
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @return Retorna o índice da região
+	 */
+	unsigned int getRegiao(unsigned int indiceLocal) const;
+
+	/**
+	 * @brief Permite obter os postos de uma região
+	 * @param regiao - Índice da região
+	 * @return Retorna os postos da região
+	 */
+	const std::vector<Posto*> & getPostosRegiao(unsigned int regiao) const;
+
+	/**
+	 * @brief Permite obter os locais de uma região
+	 * @param regiao - Índice da região
+	 * @return Retorna as posições (no vetor de locais) dos locais da região
+	 */
+	const std::vector<unsigned int> & getLocaisRegiao(unsigned int regiao) const;
+
+	/**
+	 * @brief Permite obter os postos da região de um local, por ordem crescente de distância a esse local
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @return Retorna os postos da região do local
+	 */
+	const std::vector<Posto*> & getOrdemRegiao(unsigned int indiceLocal) const;
+
+	/**
+	 * @brief Permite obter os postos fora da região de um local, por ordem crescente de distância a esse local
+	 * @param indiceLocal - Posição do local no vetor de locais
+	 * @return Retorna os postos das outras regiões
+	 */
+	const std::vector<Posto*> & getOrdemFora(unsigned int indiceLocal) const;
+};
+
+#endif /* REGIOESDESPACHO_H_ */
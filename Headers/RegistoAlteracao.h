@@ -0,0 +1,143 @@
+#ifndef REGISTOALTERACAO_H_
+#define REGISTOALTERACAO_H_
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include "BufferEscrita.h"
+
+/**
+ * Registo imutável de uma alteração ao estado da Proteção Civil, enviado para o diário pelo EscritorPersistencia.
+ * Todo o conteúdo é guardado já no formato dos ficheiros (postos e acidentes), pelo que o registo não depende de objetos que possam mudar ou ser apagados depois de ser criado.
+ * Os registos são idempotentes (guardam o estado final dos postos, e não a diferença), pelo que podem ser reaplicados sobre um estado que já os inclua.
+ *
+ * O diário começa por um cabeçalho "DIARIO Vversão assinatura". Os diários da versão 1 (cabeçalho "DIARIO assinatura") usavam como checksum a assinatura FNV-1a
+ * dos segmentos (SegmentoCheckpoint::calcularAssinatura) e continuam a ser lidos, para recuperar um diário deixado por uma versão anterior do programa.
+ *
+ * Formato de um registo no diário:
+ *   R seq tamanho checksum (CRC32C do conteúdo) , seguido de 'tamanho' bytes de conteúdo:
+ *   tipo (D, T ou P) numOcorrencia numPostos , as linhas dos postos e, caso seja D ou T, a entrada do acidente
+ */
+class RegistoAlteracao {
+public:
+	static const unsigned int VERSAO_DIARIO = 2;	/**< Versão do formato do diário escrita por este programa (a versão 1 ainda é lida)	*/
+
+	/**
+	 * Tipos de alteração
+	 */
+	enum Tipo {
+		ACIDENTE_DECLARADO,		/**< Um acidente foi declarado (e foram-lhe atribuídos meios)		*/
+		ACIDENTE_TERMINADO,		/**< Um acidente foi terminado (e os seus meios retornados)			*/
+		POSTOS_ALTERADOS		/**< Apenas a capacidade de alguns postos mudou						*/
+	};
+private:
+	const Tipo tipo;							/**< Tipo da alteração															*/
+	const unsigned int numOcorrencia;			/**< Número de ocorrência do acidente declarado/terminado							*/
+	const std::string acidente;					/**< Entrada do acidente declarado no formato do ficheiro de acidentes			*/
+	const std::vector<std::string> postos;		/**< Estado final dos postos alterados, no formato do ficheiro de postos			*/
+
+	/**
+	 * @brief Lê o cabeçalho de um registo do diário ("R seq tamanho checksum")
+	 * @param pos - Posição de início do registo; no fim aponta para o início do conteúdo
+	 * @param fim - Fim do texto
+	 * @param seq - Variável onde é colocado o número de sequência do registo
+	 * @param tamanho - Variável onde é colocado o tamanho do conteúdo
+	 * @param checksum - Variável onde é colocado o checksum do conteúdo
+	 * @return Retorna true caso o cabeçalho seja válido e o conteúdo esteja completo e false caso contrário
+	 */
+	static bool lerCabecalho(const char* &pos, const char* fim, unsigned long long &seq, unsigned long long &tamanho, unsigned long long &checksum);
+
+	/**
+	 * @brief Calcula o checksum do conteúdo de um registo
+	 * @param conteudo - Início do conteúdo
+	 * @param tamanho - Tamanho do conteúdo
+	 * @param versao - Versão do diário (CRC32C a partir da versão 2, assinatura FNV-1a na versão 1)
+	 * @return Retorna o checksum do conteúdo
+	 */
+	static unsigned long long calcularChecksum(const char* conteudo, unsigned long long tamanho, unsigned int versao);
+
+	/**
+	 * @brief Indica se numa posição do diário começa um registo completo e íntegro (cabeçalho válido e checksum correto), sem o interpretar
+	 * @param pos - Posição de início do registo
+	 * @param fim - Fim do texto
+	 * @param versao - Versão do diário
+	 * @return Retorna true caso comece um registo íntegro e false caso contrário (ex: fim do diário, lixo ou zeros deixados por uma escrita interrompida)
+	 */
+	static bool registoIntegro(const char* pos, const char* fim, unsigned int versao);
+
+	/**
+	 * @brief Permite obter o conteúdo do registo (sem o cabeçalho), tal como é escrito no diário
+	 * @return Retorna o conteúdo do registo
+	 */
+	std::string getConteudo() const;
+public:
+	/**
+	 * @brief Construtor da classe RegistoAlteracao
+	 * @param tipo - Tipo da alteração
+	 * @param numOcorrencia - Número de ocorrência do acidente declarado/terminado (0 caso não se aplique)
+	 * @param acidente - Entrada do acidente declarado no formato do ficheiro de acidentes (vazia caso não se aplique)
+	 * @param postos - Estado final dos postos alterados, no formato do ficheiro de postos
+	 */
+	RegistoAlteracao(Tipo tipo, unsigned int numOcorrencia, const std::string &acidente, const std::vector<std::string> &postos);
+
+	/**
+	 * @brief Permite obter o tipo da alteração
+	 * @return Retorna o tipo da alteração
+	 */
+	Tipo getTipo() const;
+
+	/**
+	 * @brief Permite obter o número de ocorrência do acidente declarado/terminado
+	 * @return Retorna o número de ocorrência
+	 */
+	unsigned int getNumOcorrencia() const;
+
+	/**
+	 * @brief Permite obter a entrada do acidente declarado
+	 * @return Retorna a entrada do acidente no formato do ficheiro de acidentes
+	 */
+	const std::string & getAcidente() const;
+
+	/**
+	 * @brief Permite obter o estado final dos postos alterados
+	 * @return Retorna as linhas dos postos no formato do ficheiro de postos
+	 */
+	const std::vector<std::string> & getPostos() const;
+
+	/**
+	 * @brief Escreve o registo num buffer, no formato do diário
+	 * @param buf - Buffer onde é escrito o registo
+	 * @param seq - Número de sequência do registo no diário
+	 */
+	void serializar(BufferEscrita &buf, unsigned long long seq) const;
+
+	/**
+	 * @brief Lê um registo do diário, verificando o seu tamanho e checksum
+	 * @param pos - Posição de início do registo no texto; no fim aponta para o início do registo seguinte
+	 * @param fim - Fim do texto
+	 * @param seq - Variável onde é colocado o número de sequência do registo
+	 * @param registo - Variável onde é colocado o registo lido
+	 * @param versao - Versão do diário de onde o registo é lido (define o checksum)
+	 * @return Retorna true caso tenha sido lido um registo completo e íntegro e false caso o texto tenha terminado ou o último registo esteja truncado/corrompido
+	 * (um registo corrompido seguido de um registo íntegro lança a exceção DadosCorrompidos; seguido de outros bytes, é tratado como uma escrita interrompida)
+	 */
+	static bool ler(const char* &pos, const char* fim, unsigned long long &seq, std::shared_ptr<const RegistoAlteracao> &registo, unsigned int versao = VERSAO_DIARIO);
+
+	/**
+	 * @brief Permite obter o cabeçalho do diário, que identifica a base (ficheiro de acidentes) sobre a qual os registos foram escritos
+	 * @param assinaturaBase - Assinatura do ficheiro de acidentes
+	 * @return Retorna a linha de cabeçalho do diário
+	 */
+	static std::string cabecalhoDiario(unsigned long long assinaturaBase);
+
+	/**
+	 * @brief Lê todos os registos íntegros de um diário, parando no primeiro registo truncado ou corrompido (escrita interrompida)
+	 * @param ficheiro - Nome do ficheiro do diário
+	 * @param assinaturaBase - Variável onde é colocada a assinatura da base indicada no cabeçalho do diário
+	 * @param registos - Vetor onde são colocados os registos lidos, com o seu número de sequência
+	 * @return Retorna true caso o diário exista e tenha um cabeçalho válido e false caso contrário (um diário de uma versão mais recente lança a exceção DadosCorrompidos)
+	 */
+	static bool lerDiario(const std::string &ficheiro, unsigned long long &assinaturaBase, std::vector< std::pair<unsigned long long, std::shared_ptr<const RegistoAlteracao> > > &registos);
+};
+
+#endif /* REGISTOALTERACAO_H_ */
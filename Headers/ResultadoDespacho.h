@@ -0,0 +1,53 @@
+#ifndef RESULTADODESPACHO_H_
+#define RESULTADODESPACHO_H_
+#include <vector>
+#include <string>
+#include "Atribuicao.h"
+
+/**
+ * Resultado do acionamento de meios para um acidente (ver ProtecaoCivil::despacharAcidente e ProtecaoCivil::ingerirAcidentes): em vez de lançar exceções quando as necessidades
+ * não são todas supridas ou o acidente é inválido, indica o grau de sucesso, as atribuições efetuadas e o que ficou em falta de cada tipo de recurso.
+ */
+struct ResultadoDespacho {
+	/**
+	 * Grau de sucesso do acionamento de meios
+	 */
+	enum Estado {
+		COMPLETO,		/**< Todas as necessidades foram supridas (o acidente foi aceite)						*/
+		PARCIAL,		/**< Apenas parte das necessidades foram supridas (o acidente foi aceite)				*/
+		SEM_MEIOS,		/**< Não foram acionados quaisquer meios (o acidente não foi aceite)					*/
+		INVALIDO		/**< O acidente é inválido ou o local não existe (o acidente não foi criado)			*/
+	};
+
+	/**
+	 * Tipos de recurso de que um acidente pode precisar
+	 */
+	enum TipoRecurso {
+		EQUIPAS_MEDICAS,		/**< Veículos com equipa médica (motos e carros do Inem, ambulâncias) 	*/
+		EQUIPAS_POLICIAIS,		/**< Veículos com equipa policial (motos e carros da Polícia)			*/
+		AUTOTANQUES,			/**< Autotanques dos Bombeiros (cada um leva os seus bombeiros)			*/
+		NUM_RECURSOS
+	};
+
+	Estado estado;								/**< Grau de sucesso do acionamento de meios									*/
+	unsigned int numOcorrencia;					/**< Número de ocorrência do acidente aceite (0 caso não tenha sido aceite ou seja só planeado)	*/
+	std::vector<Atribuicao> atribuicoes;		/**< Atribuições efetuadas (os meios já saíram dos postos)						*/
+	unsigned int falta[NUM_RECURSOS];			/**< Unidades em falta de cada tipo de recurso (0 caso tenha sido suprido)	*/
+	std::string erro;							/**< Descrição do erro, caso o acidente seja inválido							*/
+
+	/**
+	 * @brief Construtor da struct ResultadoDespacho, sem atribuições e sem nada em falta
+	 */
+	ResultadoDespacho() : estado(COMPLETO) , numOcorrencia(0) {
+		for (unsigned int i=0 ; i<NUM_RECURSOS ; i++)
+			falta[i] = 0;
+	}
+
+	/**
+	 * @brief Indica se o acidente foi aceite pela Proteção Civil (foram acionados alguns meios)
+	 * @return Retorna true caso o estado seja COMPLETO ou PARCIAL e false caso contrário
+	 */
+	bool aceite() const { return estado == COMPLETO || estado == PARCIAL; }
+};
+
+#endif /* RESULTADODESPACHO_H_ */
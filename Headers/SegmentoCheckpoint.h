@@ -0,0 +1,66 @@
+#ifndef SEGMENTOCHECKPOINT_H_
+#define SEGMENTOCHECKPOINT_H_
+#include <string>
+#include <vector>
+#include <utility>
+#include "Posto.h"
+#include "Acidente.h"
+#include "DescritorPosto.h"
+#include "DescritorAcidente.h"
+
+/**
+ * Segmento de checkpoint incremental: contém apenas as alterações feitas desde o checkpoint anterior (postos cuja capacidade mudou, acidentes terminados e acidentes declarados).
+ * Os segmentos são aplicados, pela sua ordem, sobre os ficheiros de postos e acidentes (a base) ao abrir a Proteção Civil; só são aplicados sobre a base para a qual foram escritos.
+ *
+ * Formato do ficheiro:
+ *   SEGMENTO assinaturaBase
+ *   DIARIO seqDiario
+ *   POSTOS n , seguido de n linhas no formato do ficheiro de postos
+ *   FECHADOS n , seguido de n linhas com o número de ocorrência de cada acidente terminado
+ *   ABERTOS n , seguido, para cada acidente, de uma linha com o seu número de ocorrência e da sua entrada no formato do ficheiro de acidentes
+ *   FIM checksum , com o CRC32C de todo o conteúdo anterior
+ */
+struct SegmentoCheckpoint {
+	unsigned long long assinaturaBase;								/**< Assinatura do ficheiro de acidentes sobre o qual o segmento foi escrito		*/
+	unsigned long long seqDiario;									/**< Número de sequência do último registo do diário incluído no segmento			*/
+	std::vector<DescritorPosto> postos;								/**< Estado atual dos postos cuja capacidade mudou									*/
+	std::vector<unsigned int> acidentesFechados;					/**< Números de ocorrência dos acidentes terminados									*/
+	std::vector< std::pair<unsigned int, DescritorAcidente> > acidentesAbertos;	/**< Acidentes declarados, com o seu número de ocorrência				*/
+
+	/**
+	 * @brief Permite obter o nome do ficheiro de um segmento
+	 * @param ficheiroAcidentes - Nome do ficheiro de acidentes (base)
+	 * @param numero - Número do segmento (o primeiro é o 1)
+	 * @return Retorna o nome do ficheiro do segmento
+	 */
+	static std::string nomeFicheiro(const std::string &ficheiroAcidentes, unsigned int numero);
+
+	/**
+	 * @brief Lê um segmento de um ficheiro
+	 * @param ficheiro - Nome do ficheiro do segmento
+	 * @param segmento - Segmento onde é colocado o conteúdo do ficheiro
+	 * @return Retorna true caso o segmento tenha sido lido por completo e false caso o ficheiro não exista ou esteja incompleto (um segmento completo cujo checksum não corresponde ao conteúdo lança a exceção DadosCorrompidos)
+	 */
+	static bool ler(const std::string &ficheiro, SegmentoCheckpoint &segmento);
+
+	/**
+	 * @brief Escreve um segmento, de forma atómica (ficheiro temporário, fsync e renomeação), lançando a exceção ErroEscrita em caso de falha
+	 * @param ficheiro - Nome do ficheiro do segmento
+	 * @param assinaturaBase - Assinatura do ficheiro de acidentes sobre o qual o segmento é escrito
+	 * @param seqDiario - Número de sequência do último registo do diário incluído no segmento
+	 * @param postos - Postos cuja capacidade mudou
+	 * @param acidentesFechados - Números de ocorrência dos acidentes terminados
+	 * @param acidentesAbertos - Acidentes declarados
+	 */
+	static void escrever(const std::string &ficheiro, unsigned long long assinaturaBase, unsigned long long seqDiario, const std::vector<const Posto*> &postos, const std::vector<unsigned int> &acidentesFechados, const std::vector<const Acidente*> &acidentesAbertos);
+
+	/**
+	 * @brief Calcula a assinatura (hash FNV-1a de 64 bits) de um conteúdo, usada para identificar a base de um segmento
+	 * @param dados - Início do conteúdo
+	 * @param tamanho - Tamanho do conteúdo, em bytes
+	 * @return Retorna a assinatura do conteúdo
+	 */
+	static unsigned long long calcularAssinatura(const char* dados, unsigned long long tamanho);
+};
+
+#endif /* SEGMENTOCHECKPOINT_H_ */
@@ -0,0 +1,281 @@
+#ifndef SIMULADOREVENTOS_H_
+#define SIMULADOREVENTOS_H_
+#include <vector>
+#include <map>
+#include <queue>
+#include <functional>
+#include <memory>
+#include "ProtecaoCivil.h"
+#include "TabelaCapacidades.h"
+#include "FilaPendentes.h"
+
+/**
+ * Simulação por eventos discretos da ocupação dos meios da Proteção Civil ao longo do tempo (em minutos, a partir das 0h de 1 de janeiro de Parametros::ano).
+ * Os acidentes chegam nos instantes agendados e são despachados com o algoritmo da Proteção Civil (ver ProtecaoCivil::planearDespacho); cada meio demora a chegar ao local
+ * o tempo de viagem correspondente à distância entre o posto e o local. A duração no local (por tipo de acidente) conta a partir da chegada do último meio,
+ * e os meios regressam depois aos postos (ver ProtecaoCivil::planearRegresso), podendo seguir de imediato para acidentes simulados pendentes.
+ *
+ * A simulação corre sobre o seu próprio estado: uma cópia privada de um instantâneo das capacidades dos postos (TabelaCapacidades), a sua fila de pendentes
+ * e os seus acidentes. A Proteção Civil só é lida (locais, postos e ordem dos postos por local), pelo que nada do que é simulado chega ao diário, aos checkpoints,
+ * ao arquivo, ao histórico ou aos pendentes reais, e os postos reais nunca são alterados.
+ *
+ * O calendário é uma fila de prioridade de eventos (chegada de um acidente, fim de um acidente e regresso de meios a um posto), processados por ordem de instante
+ * e, no mesmo instante, pela ordem em que foram agendados.
+ */
+class SimuladorEventos {
+public:
+	/**
+	 * Parâmetros temporais da simulação
+	 */
+	struct Parametros {
+		double velocidade;				/**< Distância (nas unidades das coordenadas dos locais) percorrida por minuto		*/
+		double duracaoIncendio;			/**< Minutos no local de um incêndio												*/
+		double duracaoViacao;			/**< Minutos no local de um acidente de viação										*/
+		double duracaoAssalto;			/**< Minutos no local de um assalto													*/
+		unsigned int ano;				/**< Ano do instante 0 (para as datas dos acidentes)								*/
+
+		/**
+		 * @brief Construtor da struct Parametros, com valores por omissão
+		 */
+		Parametros();
+	};
+
+	/**
+	 * Estatísticas acumuladas da simulação, para dimensionar as frotas
+	 */
+	struct Estatisticas {
+		unsigned int numAcidentes;			/**< Acidentes chegados													*/
+		unsigned int numCompletos;			/**< Acidentes com todas as necessidades supridas no despacho			*/
+		unsigned int numParciais;			/**< Acidentes com apenas parte das necessidades supridas no despacho	*/
+		unsigned int numSemMeios;			/**< Acidentes sem quaisquer meios (não aceites)						*/
+		unsigned int numReforcos;			/**< Reforços de acidentes pendentes com meios que regressaram			*/
+		unsigned int unidadesAtribuidas;	/**< Unidades (veículos com equipa) enviadas, incluindo os reforços		*/
+		unsigned int unidadesEmFalta;		/**< Unidades que ficaram por enviar aos acidentes sem meios e aos que terminaram com necessidades por suprir	*/
+		std::vector<double> temposResposta;	/**< Tempo até à chegada do primeiro meio de cada acidente aceite		*/
+		double tempoRespostaTotal;			/**< Soma dos tempos até à chegada do primeiro meio (acidentes aceites)	*/
+		double tempoRespostaMaximo;			/**< Maior tempo até à chegada do primeiro meio							*/
+		double veiculosMinutos;				/**< Integral do número de veículos fora dos postos (veículos x minutos)	*/
+		unsigned int veiculosFora;			/**< Veículos atualmente fora dos postos								*/
+		unsigned int maxVeiculosFora;		/**< Maior número de veículos fora dos postos ao mesmo tempo			*/
+
+		/**
+		 * @brief Construtor da struct Estatisticas, com tudo a 0
+		 */
+		Estatisticas();
+
+		/**
+		 * @brief Permite obter o tempo médio até à chegada do primeiro meio
+		 * @return Retorna o tempo médio de resposta (em minutos) dos acidentes aceites
+		 */
+		double getTempoRespostaMedio() const;
+	};
+private:
+	/**
+	 * Tipos de evento do calendário
+	 */
+	enum TipoEvento {
+		CHEGADA_ACIDENTE,		/**< Um acidente agendado chega à Proteção Civil				*/
+		FIM_ACIDENTE,			/**< Termina o trabalho no local de um acidente					*/
+		REGRESSO_MEIOS			/**< Os meios de uma atribuição chegam de volta ao posto		*/
+	};
+
+	/**
+	 * Evento do calendário
+	 */
+	struct Evento {
+		double instante;			/**< Instante do evento (minutos)													*/
+		unsigned long long ordem;	/**< Ordem de agendamento (desempate entre eventos no mesmo instante)				*/
+		TipoEvento tipo;			/**< Tipo do evento																	*/
+		unsigned int indice;		/**< Acidente agendado, número de ocorrência ou atribuição em regresso, conforme o tipo	*/
+
+		/**
+		 * @brief Ordem do calendário: menor instante primeiro e, no mesmo instante, o agendado primeiro
+		 */
+		bool operator>(const Evento &outro) const;
+	};
+
+	/**
+	 * Ocupação dos veículos de um posto
+	 */
+	struct OcupacaoPosto {
+		unsigned int veiculosFora;		/**< Veículos atualmente fora do posto						*/
+		double veiculosMinutos;			/**< Integral dos veículos fora até ao instante desde		*/
+		double desde;					/**< Instante da última alteração dos veículos fora			*/
+
+		OcupacaoPosto() : veiculosFora(0), veiculosMinutos(0), desde(0) {}
+	};
+
+	/**
+	 * Acidente aceite que ainda não terminou
+	 */
+	struct AcidenteEmCurso {
+		std::shared_ptr<Acidente> acidente;	/**< Acidente simulado											*/
+		double fim;						/**< Instante em que termina o trabalho no local					*/
+		unsigned int numAtribuicoes;	/**< Atribuições do acidente já acompanhadas pela simulação			*/
+	};
+
+	const ProtecaoCivil &protecaoCivil;										/**< Proteção Civil simulada (só lida)							*/
+	TabelaCapacidades capacidades;												/**< Capacidades simuladas dos postos							*/
+	FilaPendentes pendentes;													/**< Acidentes simulados com necessidades por suprir			*/
+	Parametros parametros;														/**< Parâmetros temporais										*/
+	double instante;															/**< Instante atual (minutos)									*/
+	unsigned long long numAgendados;											/**< Número de eventos já agendados								*/
+	unsigned int proximoNumOcorrencia;											/**< Número de ocorrência do próximo acidente aceite			*/
+	std::priority_queue<Evento, std::vector<Evento>, std::greater<Evento> > calendario;	/**< Eventos por processar								*/
+	std::vector<DescritorAcidente> agendados;									/**< Acidentes agendados (esvaziados depois de chegarem)		*/
+	std::vector<Atribuicao> emRegresso;											/**< Atribuições cujos meios foram ou estão em regresso			*/
+	std::map<unsigned int, AcidenteEmCurso> emCurso;							/**< Acidentes em curso, por número de ocorrência				*/
+	std::map<unsigned int, OcupacaoPosto> ocupacao;								/**< Ocupação dos veículos de cada posto, por id				*/
+	Estatisticas estatisticas;													/**< Estatísticas acumuladas									*/
+
+	/**
+	 * @brief Coloca um evento no calendário
+	 * @param instanteEvento - Instante do evento
+	 * @param tipo - Tipo do evento
+	 * @param indice - Índice associado ao evento (ver Evento::indice)
+	 */
+	void agendar(double instanteEvento, TipoEvento tipo, unsigned int indice);
+
+	/**
+	 * @brief Avança o relógio da simulação, acumulando a ocupação dos veículos
+	 * @param novoInstante - Novo instante (não anterior ao atual)
+	 */
+	void avancar(double novoInstante);
+
+	/**
+	 * @brief Regista a saída ou o regresso dos veículos de uma atribuição, no total e no seu posto
+	 * @param atribuicao - Atribuição
+	 * @param saida - true caso os veículos saiam do posto e false caso regressem
+	 */
+	void registarOcupacao(const Atribuicao &atribuicao, bool saida);
+
+	/**
+	 * @brief Calcula o tempo de viagem entre o posto de uma atribuição e o local de um acidente
+	 * @param atribuicao - Atribuição
+	 * @param acidente - Acidente
+	 * @return Retorna o tempo de viagem em minutos
+	 */
+	double getTempoViagem(const Atribuicao &atribuicao, const Acidente* acidente) const;
+
+	/**
+	 * @brief Permite obter a duração do trabalho no local de um acidente
+	 * @param acidente - Acidente
+	 * @return Retorna a duração em minutos, conforme o tipo de acidente
+	 */
+	double getDuracao(const Acidente* acidente) const;
+
+	/**
+	 * @brief Acompanha as atribuições de um acidente em curso que a simulação ainda não conhece (as do despacho ou de um reforço):
+	 * os seus meios saem agora dos postos e o fim do acidente passa a contar a partir da chegada do último meio
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @param acidenteEmCurso - Acidente em curso
+	 * @return Retorna o tempo até à chegada do primeiro dos novos meios
+	 */
+	double acompanharAtribuicoes(unsigned int numOcorrencia, AcidenteEmCurso &acidenteEmCurso);
+
+	/**
+	 * @brief Processa a chegada de um acidente agendado: despacha-o e, caso seja aceite, agenda o seu fim
+	 * @param indice - Índice do acidente agendado
+	 */
+	void chegarAcidente(unsigned int indice);
+
+	/**
+	 * @brief Processa o fim de um acidente: retira-o da simulação e agenda o regresso dos seus meios
+	 * @param numOcorrencia - Número de ocorrência do acidente
+	 * @param instanteEvento - Instante do evento (o evento é ignorado caso o fim do acidente tenha sido adiado por um reforço)
+	 */
+	void terminarAcidente(unsigned int numOcorrencia, double instanteEvento);
+
+	/**
+	 * @brief Processa o regresso dos meios de uma atribuição ao seu posto, acompanhando os acidentes pendentes que sejam reforçados com eles
+	 * @param indice - Índice da atribuição em regresso
+	 */
+	void regressarMeios(unsigned int indice);
+public:
+	/**
+	 * @brief Construtor da classe SimuladorEventos, a partir das capacidades atuais dos postos (ver ProtecaoCivil::getCapacidades)
+	 * @param protecaoCivil - Proteção Civil a simular (com os ficheiros já abertos); não é alterada pela simulação
+	 * @param parametros - Parâmetros temporais da simulação
+	 */
+	SimuladorEventos(const ProtecaoCivil &protecaoCivil, const Parametros &parametros = Parametros());
+
+	/**
+	 * @brief Construtor da classe SimuladorEventos, a partir de um instantâneo dado (por exemplo, com uma frota alterada, ver TabelaCapacidades::definirCapacidade)
+	 * @param protecaoCivil - Proteção Civil a simular (com os ficheiros já abertos); não é alterada pela simulação
+	 * @param capacidades - Capacidades iniciais dos postos (a simulação usa a sua cópia)
+	 * @param parametros - Parâmetros temporais da simulação
+	 */
+	SimuladorEventos(const ProtecaoCivil &protecaoCivil, const TabelaCapacidades &capacidades, const Parametros &parametros = Parametros());
+
+	/**
+	 * @brief Agenda a chegada de um acidente
+	 * @param instanteChegada - Instante de chegada (minutos), não anterior ao instante atual
+	 * @param descritor - Acidente (a data é substituída pela do instante de chegada)
+	 */
+	void agendarAcidente(double instanteChegada, const DescritorAcidente &descritor);
+
+	/**
+	 * @brief Gera acidentes sintéticos: chegadas de Poisson, em locais escolhidos ao acaso, com 45% de assaltos (30% com feridos),
+	 * 30% de acidentes de viação (1 a 3 feridos) e 25% de incêndios (metade florestais, 1 a 3 autotanques com 3 bombeiros cada)
+	 * @param locais - Locais onde podem ocorrer os acidentes
+	 * @param inicio - Instante a partir do qual são gerados (minutos)
+	 * @param duracao - Duração do período a gerar (minutos)
+	 * @param acidentesPorDia - Número médio de acidentes por dia
+	 * @param semente - Semente do gerador aleatório (a mesma semente gera os mesmos acidentes)
+	 * @param ano - Ano do instante 0 (para as datas dos acidentes)
+	 * @return Retorna os acidentes gerados, com o respetivo instante de chegada, por ordem de chegada
+	 */
+	static std::vector< std::pair<double, DescritorAcidente> > gerarDescritores(const std::vector<Local> &locais, double inicio, double duracao, double acidentesPorDia, unsigned int semente, unsigned int ano);
+
+	/**
+	 * @brief Agenda acidentes sintéticos (ver gerarDescritores), a partir do instante atual
+	 * @param duracao - Duração do período a gerar (minutos)
+	 * @param acidentesPorDia - Número médio de acidentes por dia
+	 * @param semente - Semente do gerador aleatório (a mesma semente gera os mesmos acidentes)
+	 * @return Retorna o número de acidentes agendados
+	 */
+	unsigned int gerarAcidentes(double duracao, double acidentesPorDia, unsigned int semente);
+
+	/**
+	 * @brief Processa os eventos do calendário até um dado instante (inclusive) e avança o relógio até ele
+	 * @param instanteFinal - Instante até ao qual se simula
+	 */
+	void executar(double instanteFinal);
+
+	/**
+	 * @brief Processa todos os eventos do calendário, até todos os acidentes terem terminado e todos os meios terem regressado
+	 */
+	void executar();
+
+	/**
+	 * @brief Permite obter o instante atual da simulação
+	 * @return Retorna o instante atual (minutos)
+	 */
+	double getInstante() const;
+
+	/**
+	 * @brief Permite obter o número de acidentes em curso
+	 * @return Retorna o número de acidentes aceites que ainda não terminaram
+	 */
+	unsigned int getNumEmCurso() const;
+
+	/**
+	 * @brief Permite obter a ocupação dos veículos de cada posto desde o início da simulação
+	 * @return Retorna o integral do número de veículos fora de cada posto até ao instante atual (veículos x minutos), por id do posto
+	 */
+	std::map<unsigned int, double> getVeiculosMinutosPostos() const;
+
+	/**
+	 * @brief Permite obter as capacidades simuladas dos postos
+	 * @return Retorna o instantâneo das capacidades no instante atual da simulação
+	 */
+	const TabelaCapacidades & getCapacidades() const;
+
+	/**
+	 * @brief Permite obter as estatísticas acumuladas da simulação
+	 * @return Retorna as estatísticas
+	 */
+	const Estatisticas & getEstatisticas() const;
+};
+
+#endif /* SIMULADOREVENTOS_H_ */
@@ -0,0 +1,157 @@
+#ifndef TABELACAPACIDADES_H_
+#define TABELACAPACIDADES_H_
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include "Posto.h"
+#include "MeiosPostos.h"
+
+/**
+ * Instantâneo das capacidades dos postos (socorristas e veículos de cada tipo), sobre o qual o despacho pode ser planeado sem alterar os postos (ver ProtecaoCivil::planearDespacho).
+ * As capacidades estão guardadas em páginas de tamanho fixo partilhadas entre cópias (copy-on-write): copiar uma tabela só copia os ponteiros das páginas, e uma página
+ * só é duplicada quando uma das cópias a altera pela primeira vez. Assim, vários planeamentos podem partir do mesmo instantâneo, cada um com a sua cópia, e só pagam as páginas que tocam.
+ *
+ * Cada página tem um dono: a cópia que a criou, que a pode alterar sem a duplicar. Copiar uma tabela retira o dono a todas as suas páginas, pelo que, a partir daí,
+ * qualquer cópia (incluindo a original) duplica a página antes de a alterar. Uma página partilhada nunca é alterada, independentemente do número de cópias que ainda a usem.
+ *
+ * Cada cópia só pode ser alterada por uma thread de cada vez, e uma cópia que não esteja a ser alterada pode ser lida e copiada por várias threads ao mesmo tempo;
+ * cópias diferentes (mesmo que partilhem páginas) podem ser usadas em threads diferentes.
+ */
+class TabelaCapacidades final : public MeiosPostos {
+public:
+	static const unsigned int TAMANHO_PAGINA = 32;		/**< Número de postos em cada página		*/
+
+	/**
+	 * Capacidade de um posto
+	 */
+	struct Capacidade {
+		unsigned int socorristas;								/**< Socorristas disponíveis														*/
+		unsigned int veiculos[ResultadoDespacho::NUM_RECURSOS];	/**< Veículos disponíveis para cada tipo de recurso (ver Posto::getVeiculos)		*/
+	};
+private:
+	/**
+	 * Página de capacidades, com a cópia que a pode alterar
+	 */
+	struct Pagina {
+		std::atomic<unsigned long long> dono;		/**< Cópia que pode alterar a página sem a duplicar (0 depois de a página ser partilhada)	*/
+		std::vector<Capacidade> capacidades;		/**< Capacidades dos postos da página														*/
+
+		Pagina(unsigned long long dono) : dono(dono) {}
+		Pagina(const Pagina &outra, unsigned long long dono) : dono(dono), capacidades(outra.capacidades) {}
+	};
+
+	std::shared_ptr<const std::map<unsigned int, unsigned int> > posicoes;	/**< Posição de cada posto na tabela, pelo id do posto (partilhada por todas as cópias)	*/
+	std::vector< std::shared_ptr<Pagina> > paginas;							/**< Páginas com as capacidades, partilhadas entre cópias até serem alteradas			*/
+	unsigned long long id;													/**< Identificador desta cópia, dono das páginas que criou								*/
+
+	/**
+	 * @brief Permite obter um identificador para uma nova cópia
+	 * @return Retorna um identificador diferente de todos os anteriores (e de 0)
+	 */
+	static unsigned long long novoId();
+
+	/**
+	 * @brief Partilha as páginas de outra tabela com esta, retirando-lhes o dono
+	 * @param outra - Tabela cujas páginas são partilhadas
+	 */
+	void partilhar(const TabelaCapacidades &outra);
+
+	/**
+	 * @brief Permite obter a posição de um posto na tabela
+	 * @param posto - Posto
+	 * @return Retorna a posição do posto
+	 */
+	unsigned int getPosicao(const Posto* posto) const;
+
+	/**
+	 * @brief Permite ler a capacidade na posição indicada
+	 * @param posicao - Posição na tabela
+	 * @return Retorna a capacidade
+	 */
+	const Capacidade & ler(unsigned int posicao) const;
+
+	/**
+	 * @brief Permite alterar a capacidade na posição indicada; caso a sua página não seja desta cópia, é primeiro duplicada
+	 * @param posicao - Posição na tabela
+	 * @return Retorna a capacidade, numa página só desta cópia
+	 */
+	Capacidade & escrever(unsigned int posicao);
+public:
+	/**
+	 * @brief Construtor da classe TabelaCapacidades, tira um instantâneo dos meios atuais dos postos
+	 * Os contadores de cada posto são lidos um a um (sem trincos): com despachos a decorrer ao mesmo tempo, cada contador tem um valor que existiu, mas o conjunto pode não corresponder a um único instante.
+	 * @param postos - Postos, pelo seu id
+	 */
+	TabelaCapacidades(const std::map<unsigned int, Posto*> &postos);
+
+	/**
+	 * @brief Construtor de cópia da classe TabelaCapacidades: as páginas passam a ser partilhadas (ver partilhar)
+	 * @param outra - Tabela a copiar
+	 */
+	TabelaCapacidades(const TabelaCapacidades &outra);
+
+	/**
+	 * @brief Operador de atribuição da classe TabelaCapacidades: as páginas passam a ser partilhadas (ver partilhar)
+	 * @param outra - Tabela a copiar
+	 * @return Retorna esta tabela
+	 */
+	TabelaCapacidades & operator=(const TabelaCapacidades &outra);
+
+	/**
+	 * @brief Permite obter a capacidade de um posto
+	 * @param posto - Posto
+	 * @return Retorna a capacidade do posto neste instantâneo
+	 */
+	const Capacidade & getCapacidade(const Posto* posto) const;
+
+	/**
+	 * @brief Permite obter os postos do instantâneo
+	 * @return Retorna os números de identificação dos postos, por ordem crescente
+	 */
+	std::vector<unsigned int> getIdsPostos() const;
+
+	/**
+	 * @brief Altera a capacidade de um posto neste instantâneo (por exemplo, para saber o efeito de mais um autotanque num posto)
+	 * @param posto - Posto
+	 * @param capacidade - Nova capacidade do posto
+	 */
+	void definirCapacidade(const Posto* posto, const Capacidade &capacidade);
+
+	/**
+	 * @brief Devolve ao posto, neste instantâneo, os meios de uma atribuição planeada
+	 * @param posto - Posto da atribuição
+	 * @param atribuicao - Atribuição cujos meios regressam ao posto
+	 */
+	void repor(const Posto* posto, const Atribuicao &atribuicao);
+
+	/**
+	 * @brief Permite saber quantas páginas desta cópia são suas (já não são partilhadas com outras cópias)
+	 * @return Retorna o número de páginas de que esta cópia é dona
+	 */
+	unsigned int getNumPaginasProprias() const;
+
+	/**
+	 * @brief Permite obter o número de veículos de um posto usados para um tipo de recurso
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso (num posto de Bombeiros, AUTOTANQUES indica os autotanques e os restantes as ambulâncias; nos outros postos indica todos os veículos)
+	 * @return Retorna o número de veículos do posto neste instantâneo
+	 */
+	unsigned int getVeiculos(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Permite obter o número de unidades de um recurso que um posto pode enviar neste instantâneo (ver MeiosPostos::getOferta)
+	 * @param posto - Posto
+	 * @param recurso - Tipo de recurso
+	 * @return Retorna o número de unidades disponíveis (limitado pelos veículos e pelos socorristas que cada veículo leva)
+	 */
+	unsigned int getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const;
+
+	/**
+	 * @brief Reserva os veículos e as suas equipas neste instantâneo, sem alterar o posto (ver MeiosPostos::reservar)
+	 * @return Retorna true caso a reserva tenha sido feita e false caso contrário
+	 */
+	bool reservar(Posto* posto, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas);
+};
+
+#endif /* TABELACAPACIDADES_H_ */
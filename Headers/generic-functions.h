@@ -33,6 +33,12 @@ void infoOcorrencia(ProtecaoCivil &protecaoCivil);
  */
 void pesquisarPostos(ProtecaoCivil &protecaoCivil);
 
+/**
+ * @param protecaoCivil - O objeto protecaoCivil com o qual se está a trabalhar.
+ * @brief Permite ao utilizador exportar os acidentes em decurso e terminados (com as suas atribuições) em colunas, para análise noutras ferramentas.
+ */
+void exportarHistorico(ProtecaoCivil &protecaoCivil);
+
 /**
  * @param p1 - Apontador para um posto genérico.
  * @param p2 - Apontador para um posto genérico.
@@ -37,3 +37,8 @@ void Acidente::printAtribuicoes() const{
 std::vector<Atribuicao> Acidente::getAtribuicoes() const{
 	return atribuicoes;
 }
+
+void Acidente::printSimplifiedInfo(std::ostream & os) const{
+	BufferEscrita buf(os, 1024);
+	serializar(buf);
+}
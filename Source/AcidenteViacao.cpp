@@ -1,4 +1,5 @@
 #include "AcidenteViacao.h"
+#include "EmparelhadorMeios.h"
 
 AcidenteViacao::AcidenteViacao(const std::string &data, const Local* local, unsigned int numOcorrencia, const std::string &tipoEstrada, unsigned int numFeridos, unsigned int numVeiculos)
 	: Acidente(data,local,numOcorrencia) , tipoEstrada(tipoEstrada) , numFeridos(numFeridos) , numVeiculos(numVeiculos) {}
@@ -31,13 +32,17 @@ void AcidenteViacao::printInfoAcidente() const {
 	std::cout << "Numero Veiculos: " << numVeiculos << std::endl;
 }
 
-void AcidenteViacao::printSimplifiedInfo(std::ostream & os) const{
+void AcidenteViacao::serializar(BufferEscrita & buf) const{
 	// Imprimir os dados do assalto propriamente dito
-	os << local->getNome() << '/' << data.getData() << "/Viacao/" << numFeridos << '/' << numVeiculos << '/' << tipoEstrada << '/' << atribuicoes.size();
+	buf << local->getNome() << '/' << data << "/Viacao/" << numFeridos << '/' << numVeiculos << '/' << tipoEstrada << '/' << atribuicoes.size();
 
 	// Imprimir info sob atribuições relativas a esta ocorrência
 	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
 		// Mudar de linha, fazer um tab para indexar e imprimir informação da atribuição
-		os << "\n\t" << atribuicoes.at(i);
+		buf << "\n\t" << atribuicoes.at(i);
 	}
 }
+
+unsigned int AcidenteViacao::getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const{
+	return EmparelhadorMeios::obterNecessidades(this, necessidades);
+}
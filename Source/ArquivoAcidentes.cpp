@@ -0,0 +1,514 @@
+#include "ArquivoAcidentes.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include "BufferEscrita.h"
+#include "FicheiroAtomico.h"
+#include "HistoricoAcidentes.h"
+#include "Crc32c.h"
+#include "Erro.h"
+
+/**
+ * @brief Escreve um conjunto de bytes no fim de um ficheiro e sincroniza-o com o disco (fsync)
+ * @param ficheiro - Nome do ficheiro
+ * @param dados - Conteúdo a escrever
+ * @return Retorna true em caso de sucesso e false caso contrário
+ */
+static bool acrescentarFicheiro(const std::string &ficheiro, const std::string &dados){
+	int fd = open(ficheiro.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (fd < 0)
+		return false;
+
+	const char* pos = dados.data();
+	std::string::size_type restante = dados.size();
+	while (restante > 0){
+		ssize_t escrito = write(fd, pos, restante);
+		if (escrito < 0){
+			close(fd);
+			return false;
+		}
+		pos += escrito;
+		restante -= escrito;
+	}
+
+	bool sucesso = (fsync(fd) == 0);
+	close(fd);
+	return sucesso;
+}
+
+/**
+ * @brief Escreve a linha do índice esparso de um bloco
+ * @param ostr - Stream onde é escrita a linha
+ * @param bloco - Bloco a escrever
+ */
+static void escreverBloco(std::ostream &ostr, const BlocoArquivo &bloco){
+	ostr << bloco.inicio << ' ' << bloco.fim << ' ' << bloco.numRegistos << ' ' << bloco.minNum << ' ' << bloco.maxNum << ' ' << bloco.minData << ' ' << bloco.maxData << ' ' << bloco.maxSeq << ' ' << bloco.crc;
+	ostr << ' ' << bloco.base.numOcorrencia << ' ' << bloco.base.seq << ' ' << bloco.base.data << '\n';
+}
+
+/**
+ * @brief Permite obter os valores de referência com que foi codificado um registo de um bloco
+ * @param bloco - Bloco do registo (ou NULL, caso o registo comece um bloco novo)
+ * @param inicio - Posição do registo no ficheiro da partição
+ * @return Retorna zero para o primeiro registo do bloco e a base do bloco para os restantes
+ */
+static BaseBloco baseRegisto(const BlocoArquivo* bloco, unsigned long long inicio){
+	BaseBloco base;
+	if (bloco == NULL || inicio == bloco->inicio){
+		base.numOcorrencia = 0;
+		base.seq = 0;
+		base.data = 0;
+	}
+	else
+		base = bloco->base;
+	return base;
+}
+
+/**
+ * @brief Indica se numa posição de uma partição começa um registo completo e íntegro (não vazio e com o CRC correto)
+ * @param pos - Posição de início do registo
+ * @param fim - Fim do texto
+ * @return Retorna true caso comece um registo íntegro e false caso contrário (ex: lixo ou zeros deixados por uma escrita interrompida)
+ */
+static bool registoIntegro(const char* pos, const char* fim){
+	unsigned long long tamanho;
+	uint32_t checksum;
+	return (CodificadorArquivo::lerCabecalho(pos, fim, tamanho, checksum) && tamanho > 0 && Crc32c::calcular(pos, tamanho) == checksum);
+}
+
+ArquivoAcidentes::ArquivoAcidentes(const std::string &ficheiroAcidentes, ModoVerificacao modoVerificacao)
+	: prefixo(ficheiroAcidentes + ".arq") , modoVerificacao(modoVerificacao) , dicionario(ficheiroAcidentes + ".arq.dic") , ultimoSeq(0) , numRegistos(0) {}
+
+bool ArquivoAcidentes::lerRegisto(const char* &pos, const char* fim, const BaseBloco &base, RegistoArquivo &registo) const{
+	const char* conteudo = pos;
+	unsigned long long tamanho;
+	uint32_t checksum;
+	if (!CodificadorArquivo::lerCabecalho(conteudo, fim, tamanho, checksum))
+		return false;
+
+	if (Crc32c::calcular(conteudo, tamanho) != checksum)
+		throw DadosCorrompidos("Registo corrompido no arquivo \"" + prefixo + "\".");
+
+	if (!CodificadorArquivo::descodificar(conteudo, conteudo + tamanho, base, dicionario, registo))
+		return false;
+	pos = conteudo + tamanho;
+	return true;
+}
+
+void ArquivoAcidentes::verificarBloco(const ParticaoArquivo &particao, const BlocoArquivo &bloco, const char* inicio, const char* fim){
+	if ((unsigned long long)(fim - inicio) != bloco.fim - bloco.inicio || Crc32c::calcular(inicio, fim - inicio) != bloco.crc){
+		std::ostringstream info;
+		info << "Bloco corrompido no arquivo \"" << particao.ficheiro << "\" (posicao " << bloco.inicio << ").";
+		throw DadosCorrompidos(info.str());
+	}
+}
+
+void ArquivoAcidentes::indexar(ParticaoArquivo &particao, const RegistoArquivo &registo, const char* dados, unsigned long long tamanhoRegisto){
+	uint32_t data = HistoricoAcidentes::compactarData(Date(registo.descritor.data));
+
+	// Comecar um novo bloco caso o ultimo esteja completo
+	if (particao.blocos.empty() || particao.blocos.back().numRegistos == REGISTOS_POR_BLOCO){
+		BlocoArquivo bloco;
+		bloco.inicio = particao.tamanho;
+		bloco.fim = particao.tamanho;
+		bloco.numRegistos = 0;
+		bloco.minNum = bloco.maxNum = registo.numOcorrencia;
+		bloco.minData = bloco.maxData = data;
+		bloco.maxSeq = registo.seq;
+		bloco.crc = 0;
+		bloco.base.numOcorrencia = registo.numOcorrencia;
+		bloco.base.seq = registo.seq;
+		bloco.base.data = data;
+		particao.blocos.push_back(bloco);
+	}
+
+	BlocoArquivo &bloco = particao.blocos.back();
+	bloco.numRegistos++;
+	bloco.fim += tamanhoRegisto;
+	bloco.minNum = std::min(bloco.minNum, registo.numOcorrencia);
+	bloco.maxNum = std::max(bloco.maxNum, registo.numOcorrencia);
+	bloco.minData = std::min(bloco.minData, data);
+	bloco.maxData = std::max(bloco.maxData, data);
+	bloco.maxSeq = std::max(bloco.maxSeq, registo.seq);
+	bloco.crc = Crc32c::calcular(dados, tamanhoRegisto, bloco.crc);		// O CRC do bloco e calculado por partes, registo a registo
+
+	particao.tamanho += tamanhoRegisto;
+	numRegistos++;
+	ultimoSeq = std::max(ultimoSeq, registo.seq);
+}
+
+void ArquivoAcidentes::abrir(){
+	dicionario.abrir();
+
+	std::ifstream manifesto(prefixo);
+	if (!manifesto.is_open())
+		return;		// Ainda nao ha arquivo
+
+	unsigned int ano;
+	while (manifesto >> ano){
+		abrirParticao(ano);
+	}
+}
+
+void ArquivoAcidentes::abrirParticao(unsigned int ano){
+	ParticaoArquivo &particao = particoes[ano];
+	std::ostringstream nome;
+	nome << prefixo << ano;
+	particao.ficheiro = nome.str();
+	particao.blocosIndexados = 0;
+	particao.tamanho = 0;
+	particao.nova = false;
+
+	// Dados realmente presentes no ficheiro, mapeados em memoria (um ficheiro inexistente fica com um mapeamento vazio)
+	particao.mapa = std::make_shared<FicheiroMapeado>();
+	particao.mapa->mapear(particao.ficheiro);
+	unsigned long long tamanhoFicheiro = particao.mapa->getTamanho();
+
+	// Indice esparso: aceitar apenas blocos contiguos que estejam inteiramente no ficheiro
+	std::ifstream indice(particao.ficheiro + ".idx");
+	BlocoArquivo bloco;
+	unsigned int linhasIndice = 0;
+	while (indice >> bloco.inicio >> bloco.fim >> bloco.numRegistos >> bloco.minNum >> bloco.maxNum >> bloco.minData >> bloco.maxData >> bloco.maxSeq >> bloco.crc >> bloco.base.numOcorrencia >> bloco.base.seq >> bloco.base.data){
+		linhasIndice++;
+		if (bloco.inicio != particao.tamanho || bloco.fim > tamanhoFicheiro || bloco.numRegistos != REGISTOS_POR_BLOCO)
+			break;
+
+		particao.blocos.push_back(bloco);
+		particao.tamanho = bloco.fim;
+		numRegistos += bloco.numRegistos;
+		ultimoSeq = std::max(ultimoSeq, bloco.maxSeq);
+	}
+	indice.close();
+	particao.blocosIndexados = particao.blocos.size();
+
+	// Reescrever o indice caso tenha entradas invalidas
+	if (linhasIndice != particao.blocosIndexados){
+		FicheiroAtomico novoIndice(particao.ficheiro + ".idx");
+		for (unsigned int i=0 ; i<particao.blocos.size() ; i++){
+			escreverBloco(novoIndice.getStream(), particao.blocos.at(i));
+		}
+		novoIndice.confirmar();
+	}
+
+	// Verificacao imediata: todos os blocos indexados sao lidos e o seu CRC confirmado (caso contrario, cada bloco e verificado quando for lido)
+	if (modoVerificacao == VERIFICAR_AO_ABRIR){
+		const char* dados = particao.mapa->getDados();
+		for (unsigned int i=0 ; i<particao.blocos.size() ; i++){
+			verificarBloco(particao, particao.blocos.at(i), dados + particao.blocos.at(i).inicio, dados + particao.blocos.at(i).fim);
+		}
+	}
+
+	// Registos ainda nao indexados (o ultimo bloco, incompleto): sao lidos, verificados e contabilizados no indice em memoria
+	if (tamanhoFicheiro > particao.tamanho){
+		const char* pos = particao.mapa->getDados() + particao.tamanho;
+		const char* fim = particao.mapa->getDados() + tamanhoFicheiro;
+		RegistoArquivo registo;
+		while (pos < fim){
+			const char* inicioRegisto = pos;
+			const char* conteudo = pos;
+			unsigned long long tamanho;
+			uint32_t checksum;
+			if (!CodificadorArquivo::lerCabecalho(conteudo, fim, tamanho, checksum))
+				break;
+
+			// So o ultimo registo pode ter ficado a meio de uma escrita, deixando lixo ou zeros no resto do ficheiro:
+			// so um registo integro a seguir mostra que este esta corrompido (caso contrario, a cauda e descartada)
+			if (Crc32c::calcular(conteudo, tamanho) != checksum){
+				if (registoIntegro(conteudo + tamanho, fim))
+					throw DadosCorrompidos("Registo corrompido no arquivo \"" + particao.ficheiro + "\".");
+				break;
+			}
+
+			// O registo comeca um bloco novo caso o ultimo esteja completo
+			const BlocoArquivo* bloco = (particao.blocos.empty() || particao.blocos.back().numRegistos == REGISTOS_POR_BLOCO ? NULL : &particao.blocos.back());
+			if (!lerRegisto(pos, fim, baseRegisto(bloco, particao.tamanho), registo))
+				break;
+			indexar(particao, registo, inicioRegisto, pos - inicioRegisto);
+		}
+
+		// Descartar um registo final incompleto (escrita interrompida): o mapeamento e refeito com o tamanho novo
+		if (particao.tamanho < tamanhoFicheiro){
+			particao.mapa->libertar();
+			if (truncate(particao.ficheiro.c_str(), particao.tamanho) != 0 || !particao.mapa->mapear(particao.ficheiro))
+				throw ErroEscrita("Falha ao descartar o registo incompleto do arquivo \"" + particao.ficheiro + "\".");
+		}
+	}
+}
+
+void ArquivoAcidentes::adicionar(const Acidente* acidente, unsigned long long seq){
+	std::ostringstream entrada;
+	{
+		BufferEscrita buf(entrada, 1 << 10);
+		acidente->serializar(buf);
+	}
+	adicionar(acidente->getNumOcorrencia(), entrada.str(), seq);
+}
+
+void ArquivoAcidentes::adicionar(unsigned int numOcorrencia, const std::string &entrada, unsigned long long seq){
+	RegistoArquivo registo;
+	registo.numOcorrencia = numOcorrencia;
+	registo.seq = seq;
+	const char* pos = entrada.data();
+	if (!DescritorAcidente::ler(pos, pos + entrada.size(), registo.descritor))
+		return;		// Entrada vazia
+
+	// Particao do ano do acidente (criada caso ainda nao exista)
+	unsigned int ano = Date(registo.descritor.data).getAno();
+	std::map<unsigned int, ParticaoArquivo>::iterator it = particoes.find(ano);
+	if (it == particoes.end()){
+		ParticaoArquivo particao;
+		std::ostringstream nome;
+		nome << prefixo << ano;
+		particao.ficheiro = nome.str();
+		particao.blocosIndexados = 0;
+		particao.tamanho = 0;
+		particao.nova = true;
+		particao.mapa = std::make_shared<FicheiroMapeado>();
+		it = particoes.insert(std::make_pair(ano, particao)).first;
+
+		// Ficheiros que nao constam do manifesto sao restos de uma escrita interrompida
+		std::remove(particao.ficheiro.c_str());
+		std::remove((particao.ficheiro + ".idx").c_str());
+	}
+
+	// Codificar o registo em relacao a base do seu bloco; fica pendente ate a proxima escrita
+	ParticaoArquivo &particao = it->second;
+	const BlocoArquivo* bloco = (particao.blocos.empty() || particao.blocos.back().numRegistos == REGISTOS_POR_BLOCO ? NULL : &particao.blocos.back());
+	std::string codificado;
+	CodificadorArquivo::codificar(registo, baseRegisto(bloco, particao.tamanho), dicionario, codificado);
+	particao.pendente += codificado;
+	indexar(particao, registo, codificado.data(), codificado.size());
+}
+
+void ArquivoAcidentes::sincronizar(){
+	// Os valores novos do dicionario tem de estar no disco antes dos registos que os usam
+	dicionario.sincronizar();
+
+	// O manifesto passa a incluir as particoes novas antes de os seus dados serem escritos: uma particao com o ficheiro vazio ou truncado e valida
+	bool manifestoAlterado = false;
+	for (std::map<unsigned int, ParticaoArquivo>::iterator it = particoes.begin() ; it != particoes.end() ; it++){
+		if (it->second.nova){
+			it->second.nova = false;
+			manifestoAlterado = true;
+		}
+	}
+	if (manifestoAlterado){
+		FicheiroAtomico manifesto(prefixo);
+		for (std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.begin() ; it != particoes.end() ; it++){
+			manifesto.getStream() << it->first << '\n';
+		}
+		manifesto.confirmar();
+	}
+
+	for (std::map<unsigned int, ParticaoArquivo>::iterator it = particoes.begin() ; it != particoes.end() ; it++){
+		ParticaoArquivo &particao = it->second;
+		if (particao.pendente.empty())
+			continue;
+
+		// Escrever os registos pendentes
+		if (!acrescentarFicheiro(particao.ficheiro, particao.pendente))
+			throw ErroEscrita("Falha ao escrever no arquivo \"" + particao.ficheiro + "\".");
+		particao.pendente.clear();
+
+		// O ficheiro cresceu: os registos escritos passam a ser lidos do mapeamento
+		if (!particao.mapa->mapear(particao.ficheiro))
+			throw ErroEscrita("Falha ao mapear o arquivo \"" + particao.ficheiro + "\".");
+
+		// Indexar os blocos completos (ja sincronizados com o disco)
+		unsigned int blocosCompletos = particao.blocos.size();
+		if (particao.blocos.back().numRegistos < REGISTOS_POR_BLOCO)
+			blocosCompletos--;
+
+		if (blocosCompletos > particao.blocosIndexados){
+			std::ostringstream linhas;
+			for (unsigned int i=particao.blocosIndexados ; i<blocosCompletos ; i++){
+				escreverBloco(linhas, particao.blocos.at(i));
+			}
+			if (!acrescentarFicheiro(particao.ficheiro + ".idx", linhas.str()))
+				throw ErroEscrita("Falha ao escrever o indice do arquivo \"" + particao.ficheiro + "\".");
+			particao.blocosIndexados = blocosCompletos;
+		}
+	}
+}
+
+void ArquivoAcidentes::lerTexto(const ParticaoArquivo &particao, unsigned long long inicio, unsigned long long fim, std::string &copia, const char* &inicioTexto, const char* &fimTexto) const{
+	// Parte que ja esta no ficheiro (o mapeamento so e mais curto caso o ficheiro tenha sido truncado por fora)
+	unsigned long long escrito = particao.tamanho - particao.pendente.size();
+	unsigned long long mapeado = std::min(escrito, particao.mapa->getTamanho());
+	if (fim <= escrito || (inicio < escrito && mapeado < escrito)){
+		// Lido diretamente do mapeamento, sem copia (um ficheiro truncado da um intervalo mais curto)
+		inicioTexto = particao.mapa->getDados() + std::min(inicio, mapeado);
+		fimTexto = particao.mapa->getDados() + std::min(fim, mapeado);
+		return;
+	}
+
+	// O intervalo inclui registos que ainda so estao em memoria (o ultimo bloco, incompleto)
+	copia.clear();
+	if (inicio < escrito)
+		copia.assign(particao.mapa->getDados() + inicio, escrito - inicio);
+	unsigned long long inicioPendente = (inicio > escrito ? inicio - escrito : 0);
+	copia.append(particao.pendente, inicioPendente, fim - escrito - inicioPendente);
+	inicioTexto = copia.data();
+	fimTexto = inicioTexto + copia.size();
+}
+
+std::vector<RegistoArquivo> ArquivoAcidentes::lerBloco(const ParticaoArquivo &particao, const BlocoArquivo &bloco) const{
+	std::vector<RegistoArquivo> registos;
+	std::string copia;
+	const char* inicio;
+	const char* fim;
+	lerTexto(particao, bloco.inicio, bloco.fim, copia, inicio, fim);
+	verificarBloco(particao, bloco, inicio, fim);
+
+	// Descodificar os registos um a um (o primeiro e codificado em relacao a zero e os restantes em relacao a base do bloco)
+	const char* pos = inicio;
+	RegistoArquivo registo;
+	while (pos < fim && lerRegisto(pos, fim, baseRegisto(&bloco, bloco.inicio + (pos - inicio)), registo)){
+		registos.push_back(registo);
+	}
+
+	return registos;
+}
+
+std::vector<RegistoArquivo> ArquivoAcidentes::procurarNumero(unsigned int numOcorrencia) const{
+	std::vector<RegistoArquivo> resultado;
+	for (std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.begin() ; it != particoes.end() ; it++){
+		for (unsigned int i=0 ; i<it->second.blocos.size() ; i++){
+			const BlocoArquivo &bloco = it->second.blocos.at(i);
+			if (numOcorrencia < bloco.minNum || numOcorrencia > bloco.maxNum)
+				continue;	// O indice esparso exclui este bloco
+
+			std::vector<RegistoArquivo> registos = lerBloco(it->second, bloco);
+			for (unsigned int j=0 ; j<registos.size() ; j++){
+				if (registos.at(j).numOcorrencia == numOcorrencia)
+					resultado.push_back(registos.at(j));
+			}
+		}
+	}
+
+	return resultado;
+}
+
+std::vector<RegistoArquivo> ArquivoAcidentes::procurarIntervalo(const Date &inicio, const Date &fim) const{
+	uint32_t dataInicio = HistoricoAcidentes::compactarData(inicio);
+	uint32_t dataFim = HistoricoAcidentes::compactarData(fim);
+
+	// Apenas as particoes dos anos do intervalo
+	std::vector<RegistoArquivo> resultado;
+	std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.lower_bound(inicio.getAno());
+	std::map<unsigned int, ParticaoArquivo>::const_iterator itFim = particoes.upper_bound(fim.getAno());
+	for ( ; it != itFim ; it++){
+		for (unsigned int i=0 ; i<it->second.blocos.size() ; i++){
+			const BlocoArquivo &bloco = it->second.blocos.at(i);
+			if (bloco.maxData < dataInicio || bloco.minData > dataFim)
+				continue;	// O indice esparso exclui este bloco
+
+			std::vector<RegistoArquivo> registos = lerBloco(it->second, bloco);
+			for (unsigned int j=0 ; j<registos.size() ; j++){
+				uint32_t data = HistoricoAcidentes::compactarData(Date(registos.at(j).descritor.data));
+				if (data >= dataInicio && data <= dataFim)
+					resultado.push_back(registos.at(j));
+			}
+		}
+	}
+
+	return resultado;
+}
+
+std::vector<ReferenciaBloco> ArquivoAcidentes::procurarBlocos(unsigned int numOcorrencia) const{
+	std::vector<ReferenciaBloco> resultado;
+	for (std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.begin() ; it != particoes.end() ; it++){
+		for (unsigned int i=0 ; i<it->second.blocos.size() ; i++){
+			const BlocoArquivo &bloco = it->second.blocos.at(i);
+			if (numOcorrencia >= bloco.minNum && numOcorrencia <= bloco.maxNum){
+				ReferenciaBloco referencia;
+				referencia.ano = it->first;
+				referencia.indice = i;
+				referencia.numRegistos = bloco.numRegistos;
+				resultado.push_back(referencia);
+			}
+		}
+	}
+
+	return resultado;
+}
+
+std::vector<ReferenciaBloco> ArquivoAcidentes::getBlocos() const{
+	std::vector<ReferenciaBloco> resultado;
+	for (std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.begin() ; it != particoes.end() ; it++){
+		for (unsigned int i=0 ; i<it->second.blocos.size() ; i++){
+			ReferenciaBloco referencia;
+			referencia.ano = it->first;
+			referencia.indice = i;
+			referencia.numRegistos = it->second.blocos.at(i).numRegistos;
+			resultado.push_back(referencia);
+		}
+	}
+
+	return resultado;
+}
+
+std::vector<RegistoArquivo> ArquivoAcidentes::lerBloco(const ReferenciaBloco &referencia) const{
+	std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.find(referencia.ano);
+	if (it == particoes.end() || referencia.indice >= it->second.blocos.size())
+		return std::vector<RegistoArquivo>();
+
+	return lerBloco(it->second, it->second.blocos.at(referencia.indice));
+}
+
+std::vector<PosicaoRegisto> ArquivoAcidentes::lerPosicoes(const ReferenciaBloco &referencia) const{
+	std::vector<PosicaoRegisto> posicoes;
+
+	std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.find(referencia.ano);
+	if (it == particoes.end() || referencia.indice >= it->second.blocos.size())
+		return posicoes;
+	const BlocoArquivo &bloco = it->second.blocos.at(referencia.indice);
+
+	// Apenas a identificacao de cada registo e descodificada: o resto e saltado
+	std::string copia;
+	const char* inicio;
+	const char* fim;
+	lerTexto(it->second, bloco.inicio, bloco.fim, copia, inicio, fim);
+	verificarBloco(it->second, bloco, inicio, fim);
+	const char* pos = inicio;
+	PosicaoRegisto posicao;
+	posicao.ano = referencia.ano;
+	posicao.indiceBloco = referencia.indice;
+	unsigned long long tamanho;
+	uint32_t checksum;
+	while (pos < fim){
+		posicao.inicio = bloco.inicio + (pos - inicio);
+		if (!CodificadorArquivo::lerCabecalho(pos, fim, tamanho, checksum))
+			break;
+		if (!CodificadorArquivo::descodificarIdentificacao(pos, pos + tamanho, baseRegisto(&bloco, posicao.inicio), posicao.numOcorrencia, posicao.seq))
+			break;
+		pos += tamanho;
+		posicao.fim = bloco.inicio + (pos - inicio);
+		posicoes.push_back(posicao);
+	}
+
+	return posicoes;
+}
+
+bool ArquivoAcidentes::lerRegisto(const PosicaoRegisto &posicao, RegistoArquivo &registo) const{
+	std::map<unsigned int, ParticaoArquivo>::const_iterator it = particoes.find(posicao.ano);
+	if (it == particoes.end() || posicao.fim > it->second.tamanho || posicao.indiceBloco >= it->second.blocos.size())
+		return false;
+
+	std::string copia;
+	const char* pos;
+	const char* fim;
+	lerTexto(it->second, posicao.inicio, posicao.fim, copia, pos, fim);
+	return lerRegisto(pos, fim, baseRegisto(&it->second.blocos.at(posicao.indiceBloco), posicao.inicio), registo);
+}
+
+unsigned long long ArquivoAcidentes::getUltimoSeq() const{
+	return ultimoSeq;
+}
+
+unsigned int ArquivoAcidentes::getNumRegistos() const{
+	return numRegistos;
+}
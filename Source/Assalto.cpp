@@ -1,4 +1,5 @@
 #include "Assalto.h"
+#include "EmparelhadorMeios.h"
 
 Assalto::Assalto(const std::string &data, const Local* local, unsigned int numOcorrencia, const std::string &tipoCasa, bool haferidos)
 	: Acidente(data,local,numOcorrencia) , tipoCasa(tipoCasa) , haferidos(haferidos) {}
@@ -28,13 +29,17 @@ void Assalto::printInfoAcidente() const{
 	std::cout << "Feridos: " << ((haferidos == true) ? "Existem" : "Nao Existem") << std::endl;;
 }
 
-void Assalto::printSimplifiedInfo(std::ostream & os) const{
+void Assalto::serializar(BufferEscrita & buf) const{
 	// Imprimir os dados do assalto propriamente dito
-	os << local->getNome() << '/' << data.getData() << "/Assalto/" << tipoCasa << '/' << ((haferidos == true) ? '1' : '0') << '/' << atribuicoes.size();
+	buf << local->getNome() << '/' << data << "/Assalto/" << tipoCasa << '/' << ((haferidos == true) ? '1' : '0') << '/' << atribuicoes.size();
 
 	// Imprimir info sob atribuições relativas a esta ocorrência
 	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
 		// Mudar de linha, fazer um tab para indexar e imprimir informação da atribuição
-		os << "\n\t" << atribuicoes.at(i);
+		buf << "\n\t" << atribuicoes.at(i);
 	}
 }
+
+unsigned int Assalto::getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const{
+	return EmparelhadorMeios::obterNecessidades(this, necessidades);
+}
@@ -29,6 +29,13 @@ std::ostream & operator<<(std::ostream & os, const Atribuicao& atribuicao){
 	return os;
 }
 
+BufferEscrita & operator<<(BufferEscrita & buf, const Atribuicao& atribuicao){
+	// Escrever no buffer no formato postoId/numSocorristas/numVeiculos/tipoVeiculos
+	buf << atribuicao.postoId << '/' << atribuicao.numSocorristas << '/' << atribuicao.numVeiculos << '/' << atribuicao.tipoVeiculos;
+
+	return buf;
+}
+
 void Atribuicao::printInfo() const{
 	std::cout << "ID do Posto: " << postoId << std::endl;
 	std::cout << "Numero de Socorristas: " << numSocorristas << std::endl;
@@ -0,0 +1,333 @@
+#include "BitmapComprimido.h"
+#include <algorithm>
+#include <iterator>
+
+BitmapComprimido::BitmapComprimido() {}
+
+unsigned int BitmapComprimido::procurarContentor(uint16_t chave) const{
+	// Pesquisa binaria pelo primeiro bloco com chave >= 'chave'
+	unsigned int inicio = 0, fim = contentores.size();
+	while (inicio < fim){
+		unsigned int meio = (inicio + fim) / 2;
+		if (contentores[meio].chave < chave)
+			inicio = meio + 1;
+		else
+			fim = meio;
+	}
+	return inicio;
+}
+
+void BitmapComprimido::tornarDenso(Contentor &contentor){
+	contentor.palavras.assign(NUM_PALAVRAS, 0);
+	for (unsigned int i=0 ; i<contentor.valores.size() ; i++){
+		contentor.palavras[contentor.valores[i] >> 6] |= ((uint64_t)1 << (contentor.valores[i] & 63));
+	}
+	contentor.valores.clear();
+	contentor.valores.shrink_to_fit();
+	contentor.denso = true;
+}
+
+void BitmapComprimido::tornarEsparso(Contentor &contentor){
+	if (!contentor.denso || contentor.cardinalidade > LIMITE_ESPARSO)
+		return;	// Bloco ja esparso ou com demasiados elementos
+
+	contentor.valores.clear();
+	contentor.valores.reserve(contentor.cardinalidade);
+	for (unsigned int i=0 ; i<NUM_PALAVRAS ; i++){
+		uint64_t palavra = contentor.palavras[i];
+		while (palavra != 0){
+			unsigned int bit = __builtin_ctzll(palavra);
+			contentor.valores.push_back((uint16_t)((i << 6) + bit));
+			palavra &= palavra - 1;	// Apagar o bit menos significativo
+		}
+	}
+	contentor.palavras.clear();
+	contentor.palavras.shrink_to_fit();
+	contentor.denso = false;
+}
+
+bool BitmapComprimido::contentorContem(const Contentor &contentor, uint16_t valor){
+	if (contentor.denso)
+		return (contentor.palavras[valor >> 6] >> (valor & 63)) & 1;
+	else
+		return std::binary_search(contentor.valores.begin(), contentor.valores.end(), valor);
+}
+
+void BitmapComprimido::adicionar(unsigned int valor){
+	uint16_t chave = valor >> 16, baixo = valor & 0xFFFF;
+	unsigned int indice = procurarContentor(chave);
+
+	// Criar o bloco caso ainda nao exista
+	if (indice == contentores.size() || contentores[indice].chave != chave){
+		Contentor novo;
+		novo.chave = chave;
+		novo.denso = false;
+		novo.cardinalidade = 0;
+		contentores.insert(contentores.begin()+indice, novo);
+	}
+
+	Contentor &contentor = contentores[indice];
+	if (contentor.denso){
+		uint64_t mascara = (uint64_t)1 << (baixo & 63);
+		if (!(contentor.palavras[baixo >> 6] & mascara)){
+			contentor.palavras[baixo >> 6] |= mascara;
+			contentor.cardinalidade++;
+		}
+	}
+	else {
+		std::vector<uint16_t>::iterator it = std::lower_bound(contentor.valores.begin(), contentor.valores.end(), baixo);
+		if (it != contentor.valores.end() && *it == baixo)
+			return;	// Valor ja presente
+		contentor.valores.insert(it, baixo);
+		contentor.cardinalidade++;
+
+		// Bloco com demasiados elementos passa a ser guardado como mapa de bits
+		if (contentor.cardinalidade > LIMITE_ESPARSO)
+			tornarDenso(contentor);
+	}
+}
+
+void BitmapComprimido::remover(unsigned int valor){
+	uint16_t chave = valor >> 16, baixo = valor & 0xFFFF;
+	unsigned int indice = procurarContentor(chave);
+
+	if (indice == contentores.size() || contentores[indice].chave != chave)
+		return;	// Valor nao presente
+
+	Contentor &contentor = contentores[indice];
+	if (contentor.denso){
+		uint64_t mascara = (uint64_t)1 << (baixo & 63);
+		if (contentor.palavras[baixo >> 6] & mascara){
+			contentor.palavras[baixo >> 6] &= ~mascara;
+			contentor.cardinalidade--;
+			tornarEsparso(contentor);
+		}
+	}
+	else {
+		std::vector<uint16_t>::iterator it = std::lower_bound(contentor.valores.begin(), contentor.valores.end(), baixo);
+		if (it == contentor.valores.end() || *it != baixo)
+			return;	// Valor nao presente
+		contentor.valores.erase(it);
+		contentor.cardinalidade--;
+	}
+
+	// Apagar blocos vazios
+	if (contentor.cardinalidade == 0)
+		contentores.erase(contentores.begin()+indice);
+}
+
+bool BitmapComprimido::contem(unsigned int valor) const{
+	uint16_t chave = valor >> 16;
+	unsigned int indice = procurarContentor(chave);
+
+	if (indice == contentores.size() || contentores[indice].chave != chave)
+		return false;
+
+	return contentorContem(contentores[indice], valor & 0xFFFF);
+}
+
+unsigned int BitmapComprimido::cardinalidade() const{
+	unsigned int total = 0;
+	for (unsigned int i=0 ; i<contentores.size() ; i++){
+		total += contentores[i].cardinalidade;
+	}
+	return total;
+}
+
+bool BitmapComprimido::vazio() const{
+	return contentores.empty();
+}
+
+std::vector<unsigned int> BitmapComprimido::getValores() const{
+	std::vector<unsigned int> resultado;
+	resultado.reserve(cardinalidade());
+	percorrer([&resultado](unsigned int valor){ resultado.push_back(valor); });
+	return resultado;
+}
+
+BitmapComprimido::Contentor BitmapComprimido::interseccao(const Contentor &c1, const Contentor &c2){
+	Contentor resultado;
+	resultado.chave = c1.chave;
+	resultado.denso = false;
+	resultado.cardinalidade = 0;
+
+	if (c1.denso && c2.denso){
+		// Dois mapas de bits: AND palavra a palavra
+		resultado.palavras.resize(NUM_PALAVRAS);
+		for (unsigned int i=0 ; i<NUM_PALAVRAS ; i++){
+			resultado.palavras[i] = c1.palavras[i] & c2.palavras[i];
+			resultado.cardinalidade += __builtin_popcountll(resultado.palavras[i]);
+		}
+		resultado.denso = true;
+		tornarEsparso(resultado);
+	}
+	else if (!c1.denso && !c2.denso){
+		// Dois vetores ordenados: intersecao por fusao
+		std::set_intersection(c1.valores.begin(), c1.valores.end(), c2.valores.begin(), c2.valores.end(), std::back_inserter(resultado.valores));
+		resultado.cardinalidade = resultado.valores.size();
+	}
+	else {
+		// Um vetor e um mapa de bits: testar cada elemento do vetor no mapa
+		const Contentor &esparso = (c1.denso ? c2 : c1);
+		const Contentor &denso = (c1.denso ? c1 : c2);
+		for (unsigned int i=0 ; i<esparso.valores.size() ; i++){
+			if (contentorContem(denso, esparso.valores[i]))
+				resultado.valores.push_back(esparso.valores[i]);
+		}
+		resultado.cardinalidade = resultado.valores.size();
+	}
+
+	return resultado;
+}
+
+BitmapComprimido::Contentor BitmapComprimido::uniao(const Contentor &c1, const Contentor &c2){
+	Contentor resultado;
+	resultado.chave = c1.chave;
+	resultado.cardinalidade = 0;
+
+	if (!c1.denso && !c2.denso && (c1.cardinalidade + c2.cardinalidade <= LIMITE_ESPARSO)){
+		// Dois vetores pequenos: uniao por fusao
+		resultado.denso = false;
+		std::set_union(c1.valores.begin(), c1.valores.end(), c2.valores.begin(), c2.valores.end(), std::back_inserter(resultado.valores));
+		resultado.cardinalidade = resultado.valores.size();
+		return resultado;
+	}
+
+	// Caso geral: OR palavra a palavra sobre mapas de bits
+	Contentor d1 = c1, d2 = c2;
+	if (!d1.denso) tornarDenso(d1);
+	if (!d2.denso) tornarDenso(d2);
+
+	resultado.denso = true;
+	resultado.palavras.resize(NUM_PALAVRAS);
+	for (unsigned int i=0 ; i<NUM_PALAVRAS ; i++){
+		resultado.palavras[i] = d1.palavras[i] | d2.palavras[i];
+		resultado.cardinalidade += __builtin_popcountll(resultado.palavras[i]);
+	}
+	tornarEsparso(resultado);
+	return resultado;
+}
+
+BitmapComprimido::Contentor BitmapComprimido::diferenca(const Contentor &c1, const Contentor &c2){
+	Contentor resultado;
+	resultado.chave = c1.chave;
+	resultado.denso = false;
+	resultado.cardinalidade = 0;
+
+	if (c1.denso){
+		// AND NOT palavra a palavra
+		Contentor d2 = c2;
+		if (!d2.denso) tornarDenso(d2);
+
+		resultado.denso = true;
+		resultado.palavras.resize(NUM_PALAVRAS);
+		for (unsigned int i=0 ; i<NUM_PALAVRAS ; i++){
+			resultado.palavras[i] = c1.palavras[i] & ~d2.palavras[i];
+			resultado.cardinalidade += __builtin_popcountll(resultado.palavras[i]);
+		}
+		tornarEsparso(resultado);
+	}
+	else {
+		// Manter os elementos do vetor que nao pertencem ao outro bloco
+		for (unsigned int i=0 ; i<c1.valores.size() ; i++){
+			if (!contentorContem(c2, c1.valores[i]))
+				resultado.valores.push_back(c1.valores[i]);
+		}
+		resultado.cardinalidade = resultado.valores.size();
+	}
+
+	return resultado;
+}
+
+unsigned int BitmapComprimido::contarInterseccao(const Contentor &c1, const Contentor &c2){
+	unsigned int total = 0;
+
+	if (c1.denso && c2.denso){
+		for (unsigned int i=0 ; i<NUM_PALAVRAS ; i++){
+			total += __builtin_popcountll(c1.palavras[i] & c2.palavras[i]);
+		}
+	}
+	else {
+		const Contentor &esparso = (c1.denso ? c2 : c1);
+		const Contentor &outro = (c1.denso ? c1 : c2);
+		for (unsigned int i=0 ; i<esparso.valores.size() ; i++){
+			if (contentorContem(outro, esparso.valores[i]))
+				total++;
+		}
+	}
+
+	return total;
+}
+
+unsigned int BitmapComprimido::contarInterseccao(const BitmapComprimido &outro) const{
+	unsigned int total = 0, i = 0, j = 0;
+
+	// Percorrer os blocos dos dois bitmaps por ordem de chave
+	while (i < contentores.size() && j < outro.contentores.size()){
+		if (contentores[i].chave < outro.contentores[j].chave)
+			i++;
+		else if (contentores[i].chave > outro.contentores[j].chave)
+			j++;
+		else
+			total += contarInterseccao(contentores[i++], outro.contentores[j++]);
+	}
+
+	return total;
+}
+
+BitmapComprimido BitmapComprimido::operator&(const BitmapComprimido &outro) const{
+	BitmapComprimido resultado;
+	unsigned int i = 0, j = 0;
+
+	while (i < contentores.size() && j < outro.contentores.size()){
+		if (contentores[i].chave < outro.contentores[j].chave)
+			i++;
+		else if (contentores[i].chave > outro.contentores[j].chave)
+			j++;
+		else {
+			Contentor contentor = interseccao(contentores[i++], outro.contentores[j++]);
+			if (contentor.cardinalidade != 0)
+				resultado.contentores.push_back(contentor);
+		}
+	}
+
+	return resultado;
+}
+
+BitmapComprimido BitmapComprimido::operator|(const BitmapComprimido &outro) const{
+	BitmapComprimido resultado;
+	unsigned int i = 0, j = 0;
+
+	while (i < contentores.size() || j < outro.contentores.size()){
+		if (j == outro.contentores.size() || (i < contentores.size() && contentores[i].chave < outro.contentores[j].chave))
+			resultado.contentores.push_back(contentores[i++]);
+		else if (i == contentores.size() || contentores[i].chave > outro.contentores[j].chave)
+			resultado.contentores.push_back(outro.contentores[j++]);
+		else
+			resultado.contentores.push_back(uniao(contentores[i++], outro.contentores[j++]));
+	}
+
+	return resultado;
+}
+
+BitmapComprimido BitmapComprimido::operator-(const BitmapComprimido &outro) const{
+	BitmapComprimido resultado;
+	unsigned int j = 0;
+
+	for (unsigned int i=0 ; i<contentores.size() ; i++){
+		// Avancar no outro bitmap ate um bloco com chave >= a deste
+		while (j < outro.contentores.size() && outro.contentores[j].chave < contentores[i].chave)
+			j++;
+
+		if (j == outro.contentores.size() || outro.contentores[j].chave != contentores[i].chave){
+			resultado.contentores.push_back(contentores[i]);
+		}
+		else {
+			Contentor contentor = diferenca(contentores[i], outro.contentores[j]);
+			if (contentor.cardinalidade != 0)
+				resultado.contentores.push_back(contentor);
+		}
+	}
+
+	return resultado;
+}
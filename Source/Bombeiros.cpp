@@ -1,7 +1,12 @@
 #include "Bombeiros.h"
 
 Bombeiros::Bombeiros(const unsigned int id, const Local* local, unsigned int numSocorristas, unsigned int numAutotanques, unsigned int numAmbulancias)
-	: Posto(id, local,numSocorristas,numAutotanques+numAmbulancias) , numAutotanques(numAutotanques) , numAmbulancias(numAmbulancias) {}
+	: Posto(id, local,numSocorristas,numAutotanques+numAmbulancias) , numAutotanques(numAutotanques) , numAmbulancias(numAmbulancias) {
+	tripulacoes[ResultadoDespacho::AUTOTANQUES] = 3;		// Cada autotanque leva 3 bombeiros
+	tripulacoes[ResultadoDespacho::EQUIPAS_MEDICAS] = 2;	// Cada ambulancia leva 2 bombeiros
+	contadoresVeiculos[ResultadoDespacho::AUTOTANQUES] = &this->numAutotanques;
+	contadoresVeiculos[ResultadoDespacho::EQUIPAS_MEDICAS] = &this->numAmbulancias;
+}
 
 
 Bombeiros::~Bombeiros() {
@@ -19,21 +24,19 @@ void Bombeiros::addAmbulancias(unsigned int num){
 }
 
 bool Bombeiros::rmAutotanques(unsigned int num){
-	if (numAutotanques >= num){	// Ha autotanques suficientes
-		numAutotanques -= num;
-		return true;
-	}
-	else						// Nao ha autotanques suficientes
-		return false;
+	return retirar(numAutotanques, num);
 }
 
 bool Bombeiros::rmAmbulancias(unsigned int num){
-	if (numAmbulancias >= num){	// Ha Ambulancias suficientes
-		numAmbulancias -= num;
-		return true;
-	}
-	else						// Nao ha Ambulancias suficientes
-		return false;
+	return retirar(numAmbulancias, num);
+}
+
+bool Bombeiros::reservarAutotanques(unsigned int quantidadeAutotanques, unsigned int quantidadeSocorristas){
+	return reservar(numAutotanques, quantidadeAutotanques, quantidadeSocorristas);
+}
+
+bool Bombeiros::reservarAmbulancias(unsigned int quantidadeAmbulancias, unsigned int quantidadeSocorristas){
+	return reservar(numAmbulancias, quantidadeAmbulancias, quantidadeSocorristas);
 }
 
 unsigned int Bombeiros::getNumAutotanques() const{
@@ -48,6 +51,10 @@ std::string Bombeiros::getTipoPosto() const{
 	return "Bombeiros";
 }
 
+std::string Bombeiros::getTipoVeiculos(ResultadoDespacho::TipoRecurso recurso) const{
+	return (recurso == ResultadoDespacho::AUTOTANQUES ? "Autotanque" : "Ambulancia");
+}
+
 void Bombeiros::printInfoPosto() const{
 	std::cout << "***  BOMBEIROS  ***" << std::endl;
 	std::cout << "Localidade: " << local->getNome() << std::endl;
@@ -57,7 +64,7 @@ void Bombeiros::printInfoPosto() const{
 	std::cout << "Numero de Ambulancias: " << numAmbulancias << std::endl;
 }
 
-void Bombeiros::printSimplifiedInfo(std::ostream & os) const{
-	os << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Bombeiros/" << numAutotanques << '/' << numAmbulancias;
+void Bombeiros::serializar(BufferEscrita & buf) const{
+	buf << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Bombeiros/" << numAutotanques << '/' << numAmbulancias;
 }
 
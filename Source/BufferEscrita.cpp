@@ -0,0 +1,51 @@
+#include "BufferEscrita.h"
+#include <cstring>
+
+BufferEscrita::BufferEscrita(std::ostream &destino, unsigned int capacidade)
+	: destino(destino) , dados(capacidade) , usado(0) {}
+
+BufferEscrita::~BufferEscrita() {
+	flush();
+}
+
+BufferEscrita & BufferEscrita::operator<<(const char* texto){
+	escrever(texto, strlen(texto));
+	return *this;
+}
+
+void BufferEscrita::escrever(const char* texto, unsigned int tamanho){
+	reservar(tamanho);
+	memcpy(&dados[usado], texto, tamanho);
+	usado += tamanho;
+}
+
+void BufferEscrita::escreverNumero(unsigned long long num, unsigned int largura){
+	// Converter os digitos do fim para o inicio, num pequeno vetor auxiliar
+	char digitos[20];
+	unsigned int numDigitos = 0;
+	do {
+		digitos[numDigitos++] = '0' + (num % 10);
+		num /= 10;
+	} while (num != 0);
+
+	unsigned int zeros = (largura > numDigitos ? largura - numDigitos : 0);
+	reservar(zeros + numDigitos);
+
+	// Zeros a esquerda
+	for (unsigned int i=0 ; i<zeros ; i++){
+		dados[usado++] = '0';
+	}
+
+	// Digitos, pela ordem correta
+	while (numDigitos > 0){
+		dados[usado++] = digitos[--numDigitos];
+	}
+}
+
+void BufferEscrita::flush(){
+	if (usado == 0)
+		return;
+
+	destino.write(&dados[0], usado);
+	usado = 0;
+}
@@ -0,0 +1,382 @@
+#include "CodificadorArquivo.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Crc32c.h"
+#include "Date.h"
+#include "HistoricoAcidentes.h"
+#include "Erro.h"
+#include "FicheiroAtomico.h"
+
+/**
+ * Tipos de acidente, tal como codificados no arquivo
+ */
+enum TipoCodificado {
+	INCENDIO_FLORESTAL = 0,
+	INCENDIO_DOMESTICO = 1,
+	ACIDENTE_VIACAO = 2,
+	ASSALTO = 3
+};
+
+/**
+ * @brief Converte um inteiro com sinal para a forma zigzag (valores pequenos, positivos ou negativos, ficam com poucos bytes em varint)
+ * @param valor - Valor a converter
+ * @return Retorna o valor em zigzag
+ */
+static unsigned long long zigzag(long long valor){
+	return ((unsigned long long) valor << 1) ^ (unsigned long long)(valor >> 63);
+}
+
+/**
+ * @brief Converte um inteiro na forma zigzag para o valor com sinal
+ * @param valor - Valor em zigzag
+ * @return Retorna o valor com sinal
+ */
+static long long dezigzag(unsigned long long valor){
+	return (long long)(valor >> 1) ^ -(long long)(valor & 1);
+}
+
+/**
+ * @brief Converte uma data compactada (ver HistoricoAcidentes::compactarData) para o formato DD-MM-AAAA
+ * @param data - Data compactada
+ * @return Retorna a data no formato do ficheiro de acidentes
+ */
+static std::string expandirData(uint32_t data){
+	char texto[16];
+	std::snprintf(texto, sizeof(texto), "%02u-%02u-%04u", data & 31, (data >> 5) & 15, data >> 9);
+	return texto;
+}
+
+/**
+ * @brief Escreve uma entrada do dicionário no formato do ficheiro: CRC32C do valor (8 dígitos hexadecimais), espaço, valor e fim de linha
+ * @param saida - Texto onde é acrescentada a entrada
+ * @param valor - Valor da entrada
+ */
+static void escreverEntrada(std::string &saida, const std::string &valor){
+	char crc[16];
+	std::snprintf(crc, sizeof(crc), "%08x ", (unsigned int) Crc32c::calcular(valor.data(), valor.size()));
+	saida += crc;
+	saida += valor;
+	saida += '\n';
+}
+
+/**
+ * @brief Lê uma entrada do dicionário (sem o fim de linha), verificando o seu CRC32C
+ * @param linha - Texto da entrada
+ * @param valor - Variável onde é colocado o valor
+ * @return Retorna true caso a entrada esteja bem formada e o CRC32C esteja certo e false caso contrário
+ */
+static bool lerEntrada(const std::string &linha, std::string &valor){
+	if (linha.size() < 9 || linha[8] != ' ')
+		return false;
+	uint32_t crc = 0;
+	for (unsigned int i=0 ; i<8 ; i++){
+		char c = linha[i];
+		unsigned int digito;
+		if (c >= '0' && c <= '9')
+			digito = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			digito = c - 'a' + 10;
+		else
+			return false;
+		crc = (crc << 4) | digito;
+	}
+	valor = linha.substr(9);
+	return Crc32c::calcular(valor.data(), valor.size()) == crc;
+}
+
+const std::string DicionarioArquivo::CABECALHO = "DICIONARIO V2";
+
+DicionarioArquivo::DicionarioArquivo(const std::string &ficheiro)
+	: ficheiro(ficheiro) , numGravados(0) , temCabecalho(false) {}
+
+void DicionarioArquivo::abrir(){
+	std::ifstream istr(ficheiro, std::ios::binary);
+	if (!istr.is_open())
+		return;		// Dicionario ainda vazio
+
+	std::ostringstream conteudo;
+	conteudo << istr.rdbuf();
+	istr.close();
+	const std::string texto = conteudo.str();
+
+	// Dicionario da versao 1 (sem cabecalho nem CRC por valor): os valores completos sao lidos e o ficheiro e reescrito no formato atual
+	if (texto.compare(0, CABECALHO.size() + 1, CABECALHO + '\n') != 0){
+		std::string::size_type inicio = 0, fimLinha;
+		while ((fimLinha = texto.find('\n', inicio)) != std::string::npos){
+			std::string valor = texto.substr(inicio, fimLinha - inicio);
+			ids[valor] = valores.size();
+			valores.push_back(valor);
+			inicio = fimLinha + 1;
+		}
+
+		FicheiroAtomico novo(ficheiro);
+		std::string entradas = CABECALHO + '\n';
+		for (unsigned int i=0 ; i<valores.size() ; i++){
+			escreverEntrada(entradas, valores.at(i));
+		}
+		novo.getStream() << entradas;
+		novo.confirmar();
+		numGravados = valores.size();
+		temCabecalho = true;
+		return;
+	}
+
+	// Um valor so conta depois de a sua linha estar completa e com o CRC certo
+	std::string::size_type inicio = CABECALHO.size() + 1, fimLinha;
+	std::string valor;
+	while ((fimLinha = texto.find('\n', inicio)) != std::string::npos){
+		if (!lerEntrada(texto.substr(inicio, fimLinha - inicio), valor)){
+			// Apenas a ultima entrada pode ter ficado a meio de uma escrita; uma entrada errada seguida de outras esta corrompida
+			if (texto.find('\n', fimLinha + 1) != std::string::npos)
+				throw DadosCorrompidos("Valor corrompido no dicionario \"" + ficheiro + "\" (identificador " + std::to_string(valores.size()) + ").");
+			break;
+		}
+		ids[valor] = valores.size();
+		valores.push_back(valor);
+		inicio = fimLinha + 1;
+	}
+	numGravados = valores.size();
+	temCabecalho = true;
+
+	if (inicio < texto.size() && truncate(ficheiro.c_str(), inicio) != 0)
+		throw ErroEscrita("Falha ao descartar o valor incompleto do dicionario \"" + ficheiro + "\".");
+}
+
+unsigned int DicionarioArquivo::obterId(const std::string &valor){
+	std::map<std::string, unsigned int>::const_iterator it = ids.find(valor);
+	if (it != ids.end())
+		return it->second;
+
+	ids[valor] = valores.size();
+	valores.push_back(valor);
+	return valores.size() - 1;
+}
+
+const std::string & DicionarioArquivo::getValor(unsigned long long id) const{
+	if (id >= valores.size())
+		throw DadosCorrompidos("Identificador desconhecido no dicionario \"" + ficheiro + "\".");
+	return valores.at(id);
+}
+
+void DicionarioArquivo::sincronizar(){
+	if (numGravados == valores.size())
+		return;
+
+	// Um ficheiro novo comeca pelo cabecalho, escrito juntamente com os primeiros valores
+	std::string novos;
+	if (!temCabecalho)
+		novos = CABECALHO + '\n';
+	for (unsigned int i=numGravados ; i<valores.size() ; i++){
+		escreverEntrada(novos, valores.at(i));
+	}
+
+	int fd = open(ficheiro.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (fd < 0)
+		throw ErroEscrita("Falha ao abrir o dicionario \"" + ficheiro + "\".");
+
+	const char* pos = novos.data();
+	std::string::size_type restante = novos.size();
+	while (restante > 0){
+		ssize_t escrito = write(fd, pos, restante);
+		if (escrito < 0){
+			close(fd);
+			throw ErroEscrita("Falha ao escrever no dicionario \"" + ficheiro + "\".");
+		}
+		pos += escrito;
+		restante -= escrito;
+	}
+
+	// Os registos que usam os valores novos so sao escritos depois de o dicionario estar no disco
+	bool sucesso = (fsync(fd) == 0);
+	close(fd);
+	if (!sucesso)
+		throw ErroEscrita("Falha ao sincronizar o dicionario \"" + ficheiro + "\".");
+	numGravados = valores.size();
+	temCabecalho = true;
+}
+
+unsigned int DicionarioArquivo::getNumValores() const{
+	return valores.size();
+}
+
+void CodificadorArquivo::escreverVarint(std::string &saida, unsigned long long valor){
+	while (valor >= 0x80){
+		saida += (char)((valor & 0x7F) | 0x80);
+		valor >>= 7;
+	}
+	saida += (char) valor;
+}
+
+bool CodificadorArquivo::lerVarint(const char* &pos, const char* fim, unsigned long long &valor){
+	valor = 0;
+	for (unsigned int deslocamento=0 ; pos < fim && deslocamento < 64 ; deslocamento += 7){
+		unsigned char byte = (unsigned char) *pos++;
+		valor |= (unsigned long long)(byte & 0x7F) << deslocamento;
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+void CodificadorArquivo::codificar(const RegistoArquivo &registo, const BaseBloco &base, DicionarioArquivo &dicionario, std::string &saida){
+	const DescritorAcidente &descritor = registo.descritor;
+	std::string conteudo;
+
+	// Identificacao e data, em relacao a base do bloco
+	escreverVarint(conteudo, zigzag((long long) registo.numOcorrencia - (long long) base.numOcorrencia));
+	escreverVarint(conteudo, zigzag((long long) registo.seq - (long long) base.seq));
+	escreverVarint(conteudo, zigzag((long long) HistoricoAcidentes::compactarData(Date(descritor.data)) - (long long) base.data));
+
+	// Campos de cada tipo de acidente
+	if (descritor.tipo == "Incendio"){
+		bool florestal = (descritor.tipoIncendio == "Florestal");
+		conteudo += (char)(florestal ? INCENDIO_FLORESTAL : INCENDIO_DOMESTICO);
+		escreverVarint(conteudo, dicionario.obterId(descritor.nomeLocal));
+		escreverVarint(conteudo, descritor.numBombeirosNecess);
+		escreverVarint(conteudo, descritor.numAutotanquesNecess);
+		if (florestal)
+			escreverVarint(conteudo, descritor.areaChamas);
+		else
+			escreverVarint(conteudo, dicionario.obterId(descritor.tipoCasa));
+	}
+	else if (descritor.tipo == "Viacao"){
+		conteudo += (char) ACIDENTE_VIACAO;
+		escreverVarint(conteudo, dicionario.obterId(descritor.nomeLocal));
+		escreverVarint(conteudo, dicionario.obterId(descritor.tipoEstrada));
+		escreverVarint(conteudo, descritor.numFeridos);
+		escreverVarint(conteudo, descritor.numVeiculos);
+	}
+	else{
+		conteudo += (char) ASSALTO;
+		escreverVarint(conteudo, dicionario.obterId(descritor.nomeLocal));
+		escreverVarint(conteudo, dicionario.obterId(descritor.tipoCasa));
+		conteudo += (char)(descritor.haFeridos ? 1 : 0);
+	}
+
+	// Atribuicoes: os postos de um acidente sao proximos entre si, pelo que se guarda a diferenca para o anterior
+	escreverVarint(conteudo, descritor.atribuicoes.size());
+	long long postoAnterior = 0;
+	for (unsigned int i=0 ; i<descritor.atribuicoes.size() ; i++){
+		const Atribuicao &atribuicao = descritor.atribuicoes.at(i);
+		escreverVarint(conteudo, zigzag((long long) atribuicao.getPostoId() - postoAnterior));
+		escreverVarint(conteudo, dicionario.obterId(atribuicao.getTipoVeiculos()));
+		escreverVarint(conteudo, atribuicao.getNumSocorristas());
+		escreverVarint(conteudo, atribuicao.getNumVeiculos());
+		postoAnterior = atribuicao.getPostoId();
+	}
+
+	// Cabecalho: tamanho e CRC32C do conteudo
+	escreverVarint(saida, conteudo.size());
+	uint32_t checksum = Crc32c::calcular(conteudo.data(), conteudo.size());
+	for (unsigned int i=0 ; i<4 ; i++){
+		saida += (char)((checksum >> (8*i)) & 0xFF);
+	}
+	saida += conteudo;
+}
+
+bool CodificadorArquivo::lerCabecalho(const char* &pos, const char* fim, unsigned long long &tamanho, uint32_t &checksum){
+	if (!lerVarint(pos, fim, tamanho) || fim - pos < 4)
+		return false;
+
+	checksum = 0;
+	for (unsigned int i=0 ; i<4 ; i++){
+		checksum |= (uint32_t)(unsigned char) *pos++ << (8*i);
+	}
+
+	// O conteudo tem de estar completo
+	return ((unsigned long long)(fim - pos) >= tamanho);
+}
+
+bool CodificadorArquivo::descodificarIdentificacao(const char* pos, const char* fim, const BaseBloco &base, unsigned int &numOcorrencia, unsigned long long &seq){
+	unsigned long long valor;
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	numOcorrencia = base.numOcorrencia + dezigzag(valor);
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	seq = base.seq + dezigzag(valor);
+	return true;
+}
+
+bool CodificadorArquivo::descodificar(const char* pos, const char* fim, const BaseBloco &base, const DicionarioArquivo &dicionario, RegistoArquivo &registo){
+	registo.descritor = DescritorAcidente();
+	DescritorAcidente &descritor = registo.descritor;
+	unsigned long long valor;
+
+	// Identificacao e data
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	registo.numOcorrencia = base.numOcorrencia + dezigzag(valor);
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	registo.seq = base.seq + dezigzag(valor);
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	descritor.data = expandirData(base.data + dezigzag(valor));
+
+	// Tipo e local
+	if (pos >= fim)
+		return false;
+	unsigned char tipo = (unsigned char) *pos++;
+	if (!lerVarint(pos, fim, valor))
+		return false;
+	descritor.nomeLocal = dicionario.getValor(valor);
+
+	// Campos de cada tipo de acidente
+	if (tipo == INCENDIO_FLORESTAL || tipo == INCENDIO_DOMESTICO){
+		descritor.tipo = "Incendio";
+		descritor.tipoIncendio = (tipo == INCENDIO_FLORESTAL ? "Florestal" : "Domestico");
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		descritor.numBombeirosNecess = valor;
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		descritor.numAutotanquesNecess = valor;
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		if (tipo == INCENDIO_FLORESTAL)
+			descritor.areaChamas = valor;
+		else
+			descritor.tipoCasa = dicionario.getValor(valor);
+	}
+	else if (tipo == ACIDENTE_VIACAO){
+		descritor.tipo = "Viacao";
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		descritor.tipoEstrada = dicionario.getValor(valor);
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		descritor.numFeridos = valor;
+		if (!lerVarint(pos, fim, valor))
+			return false;
+		descritor.numVeiculos = valor;
+	}
+	else if (tipo == ASSALTO){
+		descritor.tipo = "Assalto";
+		if (!lerVarint(pos, fim, valor) || pos >= fim)
+			return false;
+		descritor.tipoCasa = dicionario.getValor(valor);
+		descritor.haFeridos = (*pos++ != 0);
+	}
+	else{
+		return false;	// Tipo desconhecido
+	}
+
+	// Atribuicoes
+	unsigned long long numAtribuicoes;
+	if (!lerVarint(pos, fim, numAtribuicoes))
+		return false;
+	long long postoAnterior = 0;
+	for (unsigned long long i=0 ; i<numAtribuicoes ; i++){
+		unsigned long long diferencaPosto, idTipo, numSocorristas, numVeiculos;
+		if (!lerVarint(pos, fim, diferencaPosto) || !lerVarint(pos, fim, idTipo) || !lerVarint(pos, fim, numSocorristas) || !lerVarint(pos, fim, numVeiculos))
+			return false;
+		postoAnterior += dezigzag(diferencaPosto);
+		descritor.atribuicoes.push_back(Atribuicao(postoAnterior, numSocorristas, numVeiculos, dicionario.getValor(idTipo)));
+	}
+
+	return true;
+}
@@ -0,0 +1,87 @@
+#include "Crc32c.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+/**
+ * @brief Constrói a tabela do CRC32C (polinómio 0x82F63B78, na forma refletida)
+ * @param tabela - Tabela de 256 entradas a preencher
+ */
+static void construirTabela(uint32_t tabela[256]){
+	for (uint32_t i=0 ; i<256 ; i++){
+		uint32_t valor = i;
+		for (unsigned int bit=0 ; bit<8 ; bit++){
+			valor = (valor & 1) ? (valor >> 1) ^ 0x82F63B78 : (valor >> 1);
+		}
+		tabela[i] = valor;
+	}
+}
+
+uint32_t Crc32c::calcularTabela(uint32_t crc, const char* dados, unsigned long long tamanho){
+	static uint32_t tabela[256];
+	static bool construida = (construirTabela(tabela), true);
+	(void) construida;
+
+	crc = ~crc;
+	for (unsigned long long i=0 ; i<tamanho ; i++){
+		crc = tabela[(crc ^ (unsigned char) dados[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+#ifdef CRC32C_SSE42
+__attribute__((target("sse4.2")))
+uint32_t Crc32c::calcularHardware(uint32_t crc, const char* dados, unsigned long long tamanho){
+	crc = ~crc;
+
+#if defined(__x86_64__)
+	// 8 bytes por instrucao (memcpy evita leituras desalinhadas)
+	uint64_t crc64 = crc;
+	while (tamanho >= 8){
+		uint64_t palavra;
+		std::memcpy(&palavra, dados, 8);
+		crc64 = _mm_crc32_u64(crc64, palavra);
+		dados += 8;
+		tamanho -= 8;
+	}
+	crc = (uint32_t) crc64;
+#endif
+
+	while (tamanho >= 4){
+		uint32_t palavra;
+		std::memcpy(&palavra, dados, 4);
+		crc = _mm_crc32_u32(crc, palavra);
+		dados += 4;
+		tamanho -= 4;
+	}
+	while (tamanho > 0){
+		crc = _mm_crc32_u8(crc, (unsigned char) *dados);
+		dados++;
+		tamanho--;
+	}
+
+	return ~crc;
+}
+
+bool Crc32c::temSuporteHardware(){
+	static const bool suporte = __builtin_cpu_supports("sse4.2");
+	return suporte;
+}
+#else
+uint32_t Crc32c::calcularHardware(uint32_t crc, const char* dados, unsigned long long tamanho){
+	return calcularTabela(crc, dados, tamanho);
+}
+
+bool Crc32c::temSuporteHardware(){
+	return false;
+}
+#endif
+
+uint32_t Crc32c::calcular(const char* dados, unsigned long long tamanho, uint32_t crc){
+	if (temSuporteHardware())
+		return calcularHardware(crc, dados, tamanho);
+	return calcularTabela(crc, dados, tamanho);
+}
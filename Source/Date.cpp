@@ -61,3 +61,12 @@ std::string Date::getData() const {
 Date::~Date() {
 	// TODO Auto-generated destructor stub
 }
+
+BufferEscrita & operator<<(BufferEscrita & buf, const Date &data){
+	buf.escreverNumero(data.dia, 2);
+	buf << '-';
+	buf.escreverNumero(data.mes, 2);
+	buf << '-';
+	buf.escreverNumero(data.ano, 4);
+	return buf;
+}
@@ -0,0 +1,178 @@
+#include "DescritorAcidente.h"
+#include "Assalto.h"
+#include "AcidenteViacao.h"
+#include "IncendioDomestico.h"
+#include "IncendioFlorestal.h"
+#include "Erro.h"
+
+/**
+ * @brief Lê o próximo campo de uma linha, até ao próximo '/' ou ao fim da linha
+ * @param pos - Posição atual na linha; no fim aponta para o início do campo seguinte
+ * @param fimLinha - Fim da linha
+ * @return Retorna o texto do campo
+ */
+static std::string lerCampo(const char* &pos, const char* fimLinha){
+	const char* inicio = pos;
+	while (pos < fimLinha && *pos != '/')
+		pos++;
+	std::string campo(inicio, pos);
+	if (pos < fimLinha)
+		pos++;		// saltar o '/'
+	return campo;
+}
+
+/**
+ * @brief Lê o próximo campo numérico de uma linha, até ao próximo '/' ou ao fim da linha, lançando a exceção InputInvalido caso o campo não seja um número
+ * @param pos - Posição atual na linha; no fim aponta para o início do campo seguinte
+ * @param fimLinha - Fim da linha
+ * @param nomeCampo - Nome do campo (para a mensagem de erro)
+ * @return Retorna o valor do campo
+ */
+static unsigned int lerNumero(const char* &pos, const char* fimLinha, const char* nomeCampo){
+	while (pos < fimLinha && (*pos == ' ' || *pos == '\t'))
+		pos++;
+	const char* inicio = pos;
+	unsigned long long valor = 0;
+	while (pos < fimLinha && *pos >= '0' && *pos <= '9' && valor <= 0xFFFFFFFFULL)
+		valor = valor * 10 + (*pos++ - '0');
+	bool temDigitos = (pos > inicio);
+	while (pos < fimLinha && (*pos == ' ' || *pos == '\t'))
+		pos++;
+
+	// O campo tem de ser so digitos (com espacos a volta) e caber num unsigned int
+	if (!temDigitos || valor > 0xFFFFFFFFULL || (pos < fimLinha && *pos != '/')){
+		const char* fimCampo = pos;
+		while (fimCampo < fimLinha && *fimCampo != '/')
+			fimCampo++;
+		throw InputInvalido("Campo numerico invalido (" + std::string(nomeCampo) + "): \"" + std::string(inicio, fimCampo) + "\"");
+	}
+
+	if (pos < fimLinha)
+		pos++;		// saltar o '/'
+	return valor;
+}
+
+/**
+ * @brief Encontra o fim da linha que começa numa dada posição
+ * @param pos - Início da linha
+ * @param fim - Fim do texto
+ * @param proximaLinha - Variável onde é colocado o início da linha seguinte
+ * @return Retorna o fim da linha (sem '\n' nem '\r')
+ */
+static const char* fimDaLinha(const char* pos, const char* fim, const char* &proximaLinha){
+	const char* fimLinha = pos;
+	while (fimLinha < fim && *fimLinha != '\n')
+		fimLinha++;
+	proximaLinha = (fimLinha < fim ? fimLinha + 1 : fim);
+	if (fimLinha > pos && *(fimLinha-1) == '\r')
+		fimLinha--;
+	return fimLinha;
+}
+
+DescritorAcidente::DescritorAcidente()
+	: numAutotanquesNecess(0) , numBombeirosNecess(0) , areaChamas(0) , numFeridos(0) , numVeiculos(0) , haFeridos(false) {}
+
+bool DescritorAcidente::ler(const char* &pos, const char* fim, DescritorAcidente &descritor){
+	// Ignorar linhas vazias
+	while (pos < fim && (*pos == '\n' || *pos == '\r'))
+		pos++;
+	if (pos >= fim)
+		return false;
+
+	descritor = DescritorAcidente();
+
+	const char* proximaLinha;
+	const char* fimLinha = fimDaLinha(pos, fim, proximaLinha);
+
+	// Campos comuns a todos os acidentes
+	descritor.nomeLocal = lerCampo(pos, fimLinha);
+	descritor.data = lerCampo(pos, fimLinha);
+	descritor.tipo = lerCampo(pos, fimLinha);
+
+	// Incendios
+	if (descritor.tipo == "Incendio"){
+		descritor.numAutotanquesNecess = lerNumero(pos, fimLinha, "autotanques necessarios");
+		descritor.numBombeirosNecess = lerNumero(pos, fimLinha, "bombeiros necessarios");
+		descritor.tipoIncendio = lerCampo(pos, fimLinha);
+		if (descritor.tipoIncendio == "Florestal")
+			descritor.areaChamas = lerNumero(pos, fimLinha, "area das chamas");
+		else
+			descritor.tipoCasa = lerCampo(pos, fimLinha);
+	}
+
+	// Acidentes de Viacao
+	else if (descritor.tipo == "Viacao"){
+		descritor.numFeridos = lerNumero(pos, fimLinha, "numero de feridos");
+		descritor.numVeiculos = lerNumero(pos, fimLinha, "numero de veiculos");
+		descritor.tipoEstrada = lerCampo(pos, fimLinha);
+	}
+
+	// Assaltos
+	else if (descritor.tipo == "Assalto"){
+		descritor.tipoCasa = lerCampo(pos, fimLinha);
+		std::string feridos = lerCampo(pos, fimLinha);
+		if (feridos != "0" && feridos != "1")
+			throw InputInvalido("Campo invalido (existencia de feridos): \"" + feridos + "\"");
+		descritor.haFeridos = (feridos == "1");
+	}
+
+	else
+		throw InputInvalido("Tipo de acidente desconhecido: \"" + descritor.tipo + "\"");
+
+	// obter o numero de atribuicoes
+	unsigned int numAtribuicoes = lerNumero(pos, fimLinha, "numero de atribuicoes");
+	pos = proximaLinha;
+
+	// ler as atribuicoes, uma por linha
+	for (unsigned int i=0 ; i<numAtribuicoes && pos<fim ; i++){
+		fimLinha = fimDaLinha(pos, fim, proximaLinha);
+
+		unsigned int postoId = lerNumero(pos, fimLinha, "posto da atribuicao");
+		unsigned int numSocorristas = lerNumero(pos, fimLinha, "socorristas da atribuicao");
+		unsigned int numVeiculosAtribuidos = lerNumero(pos, fimLinha, "veiculos da atribuicao");
+		std::string tipoVeiculos(pos, fimLinha);
+
+		descritor.atribuicoes.push_back(Atribuicao(postoId, numSocorristas, numVeiculosAtribuidos, tipoVeiculos));
+		pos = proximaLinha;
+	}
+
+	return true;
+}
+
+bool DescritorAcidente::valido() const{
+	if (data.size() != 10)
+		return false;
+
+	if (tipo == "Incendio")
+		return ((tipoIncendio == "Florestal") || (tipoIncendio == "Domestico"));
+	else if (tipo == "Viacao")
+		return (numFeridos != 0);
+	else if (tipo == "Assalto")
+		return true;
+	else
+		return false;	// Tipo de acidente desconhecido
+}
+
+Acidente* DescritorAcidente::criarAcidente(const Local* local, unsigned int numOcorrencia) const{
+	Acidente* acidente;
+
+	if (tipo == "Incendio"){
+		if (tipoIncendio == "Florestal")
+			acidente = new IncendioFlorestal(data,local,numOcorrencia,numBombeirosNecess,numAutotanquesNecess,areaChamas);
+		else
+			acidente = new IncendioDomestico(data,local,numOcorrencia,numBombeirosNecess,numAutotanquesNecess,tipoCasa);
+	}
+	else if (tipo == "Viacao"){
+		acidente = new AcidenteViacao(data,local,numOcorrencia,tipoEstrada,numFeridos,numVeiculos);
+	}
+	else {
+		acidente = new Assalto(data,local,numOcorrencia,tipoCasa,haFeridos);
+	}
+
+	// Colocar as atribuicoes no acidente
+	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
+		acidente->addAtribuicao(atribuicoes.at(i));
+	}
+
+	return acidente;
+}
@@ -0,0 +1,62 @@
+#include "DescritorPosto.h"
+#include "Policia.h"
+#include "Inem.h"
+#include "Bombeiros.h"
+
+DescritorPosto DescritorPosto::ler(std::string line){
+	DescritorPosto descritor;
+	int dashIndex;
+
+	// obter o id do posto
+	dashIndex = line.find_first_of('/');
+	descritor.id = std::stoi(line.substr(0,dashIndex));
+	line.erase(0,dashIndex+1);
+
+	// obter nome do local
+	dashIndex = line.find_first_of('/');
+	descritor.nomeLocal = line.substr(0,dashIndex);
+	line.erase(0,dashIndex+1);
+
+	// obter num. de socorristas
+	dashIndex = line.find_first_of('/');
+	descritor.numSocorristas = std::stoi(line.substr(0,dashIndex));
+	line.erase(0,dashIndex+1);
+
+	// obter num. de veiculos
+	dashIndex = line.find_first_of('/');
+	descritor.numVeiculos = std::stoi(line.substr(0,dashIndex));
+	line.erase(0,dashIndex+1);
+
+	// obter tipo de posto
+	dashIndex = line.find_first_of('/');
+	descritor.tipoPosto = line.substr(0,dashIndex);
+	line.erase(0,dashIndex+1);
+
+	descritor.numAutotanques = 0;
+	descritor.numAmbulancias = 0;
+
+	if(descritor.tipoPosto == "Policia" || descritor.tipoPosto == "Inem"){
+		// obter tipo de veiculo
+		descritor.tipoVeiculo = line;
+	}
+	else {		// tipoPosto = Bombeiros
+		// obter num. de autotanques
+		dashIndex = line.find_first_of('/');
+		descritor.numAutotanques = std::stoi(line.substr(0,dashIndex));
+		line.erase(0,dashIndex+1);
+
+		// obter num. de ambulancias
+		descritor.numAmbulancias = std::stoi(line);
+	}
+
+	return descritor;
+}
+
+Posto* DescritorPosto::criarPosto(const Local* local) const{
+	if(tipoPosto == "Policia")
+		return new Policia(id,local,numSocorristas,numVeiculos,tipoVeiculo);
+	else if(tipoPosto == "Inem")
+		return new Inem(id,local,numSocorristas,numVeiculos,tipoVeiculo);
+	else		// tipoPosto = Bombeiros
+		return new Bombeiros(id,local,numSocorristas,numAutotanques,numAmbulancias);
+}
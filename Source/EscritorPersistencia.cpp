@@ -0,0 +1,147 @@
+#include "EscritorPersistencia.h"
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+EscritorPersistencia::EscritorPersistencia(const std::string &ficheiro, ModoDurabilidade modo, unsigned long long assinaturaBase, unsigned long long ultimoSeq, unsigned int capacidade)
+	: ficheiro(ficheiro) , modo(modo) , capacidade(capacidade > 0 ? capacidade : 1) , cabecalho(RegistoAlteracao::cabecalhoDiario(assinaturaBase)) ,
+	  ultimoSubmetido(ultimoSeq) , ultimoGravado(ultimoSeq) , aTerminar(false) , falhou(false) {
+	descritor = open(ficheiro.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+
+	if (descritor < 0)	// ficheiro nao foi aberto com sucesso
+		throw ErroEscrita("Falha ao abrir o diario \"" + ficheiro + "\".");
+
+	if (!escreverCabecalho()){
+		close(descritor);
+		throw ErroEscrita("Falha ao escrever o cabecalho do diario \"" + ficheiro + "\".");
+	}
+
+	thread = std::thread(&EscritorPersistencia::executar, this);
+}
+
+EscritorPersistencia::~EscritorPersistencia() {
+	// Pedir a thread que termine, depois de escrever o que ainda esta na fila
+	{
+		std::lock_guard<std::mutex> lock(trinco);
+		aTerminar = true;
+	}
+	haRegistos.notify_one();
+	thread.join();
+
+	close(descritor);
+}
+
+void EscritorPersistencia::executar(){
+	std::unique_lock<std::mutex> lock(trinco);
+
+	while (true){
+		haRegistos.wait(lock, [this](){ return !fila.empty() || aTerminar; });
+		if (fila.empty())
+			break;		// aTerminar e nao ha mais nada para escrever
+
+		// Retirar todos os registos acumulados: sao escritos num so lote
+		std::deque< std::pair<unsigned long long, std::shared_ptr<const RegistoAlteracao> > > lote;
+		lote.swap(fila);
+		unsigned long long ultimoLote = lote.back().first;
+		haEspaco.notify_all();
+		lock.unlock();
+
+		// Escrever o lote sem bloquear quem submete
+		bool sucesso = true;
+		if (modo == POR_OPERACAO){		// Um fsync por registo
+			for (unsigned int i=0 ; i<lote.size() && sucesso ; i++){
+				std::ostringstream texto;
+				{
+					BufferEscrita buf(texto, 1 << 10);
+					lote.at(i).second->serializar(buf, lote.at(i).first);
+				}
+				sucesso = escreverDiario(texto.str()) && (fsync(descritor) == 0);
+			}
+		}
+		else{		// Um unico write (e fsync, no modo POR_LOTE) para todo o lote
+			std::ostringstream texto;
+			{
+				BufferEscrita buf(texto, 1 << 16);
+				for (unsigned int i=0 ; i<lote.size() ; i++){
+					lote.at(i).second->serializar(buf, lote.at(i).first);
+				}
+			}
+			sucesso = escreverDiario(texto.str());
+			if (sucesso && modo == POR_LOTE)
+				sucesso = (fsync(descritor) == 0);
+		}
+
+		lock.lock();
+		if (!sucesso)
+			falhou = true;
+		ultimoGravado = ultimoLote;
+		gravado.notify_all();
+	}
+}
+
+bool EscritorPersistencia::escreverCabecalho(){
+	// O cabecalho e sempre sincronizado: um diario sem cabecalho seria ignorado ao recuperar
+	return escreverDiario(cabecalho) && (fsync(descritor) == 0);
+}
+
+bool EscritorPersistencia::escreverDiario(const std::string &dados){
+	const char* pos = dados.data();
+	std::string::size_type restante = dados.size();
+
+	// Um write pode escrever apenas parte dos dados
+	while (restante > 0){
+		ssize_t escrito = write(descritor, pos, restante);
+		if (escrito < 0)
+			return false;
+		pos += escrito;
+		restante -= escrito;
+	}
+
+	return true;
+}
+
+unsigned long long EscritorPersistencia::submeter(const std::shared_ptr<const RegistoAlteracao> &registo, bool aguardar){
+	unsigned long long seq;
+	{
+		std::unique_lock<std::mutex> lock(trinco);
+
+		// Fila cheia: esperar que a thread de escrita a esvazie
+		haEspaco.wait(lock, [this](){ return fila.size() < capacidade; });
+
+		seq = ++ultimoSubmetido;
+		fila.push_back(std::make_pair(seq, registo));
+	}
+	haRegistos.notify_one();
+
+	// No modo POR_OPERACAO cada alteracao esta no disco quando a operacao termina
+	if (modo == POR_OPERACAO && aguardar)
+		this->aguardar(seq);
+
+	return seq;
+}
+
+void EscritorPersistencia::aguardar(unsigned long long seq){
+	std::unique_lock<std::mutex> lock(trinco);
+	gravado.wait(lock, [this, seq](){ return ultimoGravado >= seq; });
+
+	if (falhou)
+		throw ErroEscrita("Falha ao escrever no diario \"" + ficheiro + "\".");
+}
+
+void EscritorPersistencia::reiniciar(){
+	std::unique_lock<std::mutex> lock(trinco);
+	gravado.wait(lock, [this](){ return ultimoGravado >= ultimoSubmetido; });
+
+	// A fila esta vazia e a thread de escrita parada, o diario pode ser esvaziado
+	if (ftruncate(descritor, 0) != 0 || !escreverCabecalho())
+		throw ErroEscrita("Falha ao esvaziar o diario \"" + ficheiro + "\".");
+}
+
+EscritorPersistencia::ModoDurabilidade EscritorPersistencia::getModo() const{
+	return modo;
+}
+
+unsigned long long EscritorPersistencia::getUltimoSubmetido(){
+	std::lock_guard<std::mutex> lock(trinco);
+	return ultimoSubmetido;
+}
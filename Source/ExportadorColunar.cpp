@@ -0,0 +1,217 @@
+#include "ExportadorColunar.h"
+#include <cstdio>
+#include "HistoricoAcidentes.h"
+#include "Date.h"
+
+/**
+ * @brief Permite obter o nome de um tipo de coluna, tal como aparece no manifesto
+ * @param tipo - Tipo da coluna
+ * @return Retorna o nome do tipo
+ */
+static const char* nomeTipo(ExportadorColunar::TipoColuna tipo){
+	switch (tipo){
+	case ExportadorColunar::U8:
+		return "u8";
+	case ExportadorColunar::U32:
+		return "u32";
+	case ExportadorColunar::U64:
+		return "u64";
+	default:
+		return "texto";
+	}
+}
+
+/**
+ * @brief Permite obter a largura, em bytes, dos valores de um tipo de coluna inteiro
+ * @param tipo - Tipo da coluna
+ * @return Retorna o número de bytes de cada valor
+ */
+static unsigned int larguraTipo(ExportadorColunar::TipoColuna tipo){
+	switch (tipo){
+	case ExportadorColunar::U8:
+		return 1;
+	case ExportadorColunar::U32:
+		return 4;
+	default:
+		return 8;
+	}
+}
+
+/**
+ * @brief Escreve um inteiro em little-endian, com uma dada largura
+ * @param buf - Buffer de destino
+ * @param valor - Valor a escrever
+ * @param largura - Número de bytes a escrever
+ */
+static void escreverLittleEndian(BufferEscrita &buf, unsigned long long valor, unsigned int largura){
+	char bytes[8];
+	for (unsigned int i=0 ; i<largura ; i++){
+		bytes[i] = (char) (valor >> (8*i));
+	}
+	buf.escrever(bytes, largura);
+}
+
+/**
+ * @brief Permite obter o código (HistoricoAcidentes::TipoAcidente) do tipo de um acidente descrito
+ * @param descritor - Descrição do acidente
+ * @return Retorna o código do tipo do acidente
+ */
+static HistoricoAcidentes::TipoAcidente tipoAcidente(const DescritorAcidente &descritor){
+	if (descritor.tipo == "Assalto")
+		return HistoricoAcidentes::ASSALTO;
+	else if (descritor.tipo == "Viacao")
+		return HistoricoAcidentes::VIACAO;
+	else if (descritor.tipoIncendio == "Domestico")
+		return HistoricoAcidentes::INCENDIO_DOMESTICO;
+	else
+		return HistoricoAcidentes::INCENDIO_FLORESTAL;
+}
+
+ExportadorColunar::ExportadorColunar(const std::string &prefixo)
+	: prefixo(prefixo) , numAcidentes(0) , numAtribuicoes(0) , concluido(false) {
+	colunas.reserve(NUM_COLUNAS);
+
+	// Tabela de acidentes (pela ordem de ColunaAcidentes)
+	abrirColuna("acidentes", "numOcorrencia", U32);
+	abrirColuna("acidentes", "seq", U64);
+	abrirColuna("acidentes", "terminado", U8);
+	abrirColuna("acidentes", "tipo", U8);
+	abrirColuna("acidentes", "data", U32);
+	abrirColuna("acidentes", "local", TEXTO);
+	abrirColuna("acidentes", "tipoCasa", TEXTO);
+	abrirColuna("acidentes", "tipoEstrada", TEXTO);
+	abrirColuna("acidentes", "haFeridos", U8);
+	abrirColuna("acidentes", "numFeridos", U32);
+	abrirColuna("acidentes", "numVeiculos", U32);
+	abrirColuna("acidentes", "numBombeirosNecess", U32);
+	abrirColuna("acidentes", "numAutotanquesNecess", U32);
+	abrirColuna("acidentes", "areaChamas", U32);
+	abrirColuna("acidentes", "primeiraAtribuicao", U64);
+	abrirColuna("acidentes", "numAtribuicoes", U32);
+
+	// Tabela de atribuicoes (pela ordem de ColunaAtribuicoes)
+	abrirColuna("atribuicoes", "acidente", U64);
+	abrirColuna("atribuicoes", "numOcorrencia", U32);
+	abrirColuna("atribuicoes", "posto", U32);
+	abrirColuna("atribuicoes", "socorristas", U32);
+	abrirColuna("atribuicoes", "veiculos", U32);
+	abrirColuna("atribuicoes", "tipoVeiculos", TEXTO);
+}
+
+void ExportadorColunar::abrirColuna(const std::string &tabela, const std::string &nome, TipoColuna tipo){
+	colunas.push_back(Coluna());
+	Coluna &coluna = colunas.back();
+	coluna.tabela = tabela;
+	coluna.nome = nome;
+	coluna.tipo = tipo;
+	coluna.tamanhoTexto = 0;
+
+	coluna.dados.reset(new FicheiroAtomico(nomeFicheiro(coluna)));
+	coluna.bufDados.reset(new BufferEscrita(coluna.dados->getStream(), 1 << 16));
+
+	// As colunas de texto comecam com o deslocamento 0
+	if (tipo == TEXTO){
+		coluna.deslocamentos.reset(new FicheiroAtomico(nomeFicheiro(coluna) + ".off"));
+		coluna.bufDeslocamentos.reset(new BufferEscrita(coluna.deslocamentos->getStream(), 1 << 16));
+		escreverLittleEndian(*coluna.bufDeslocamentos, 0, 8);
+	}
+}
+
+std::string ExportadorColunar::nomeFicheiro(const Coluna &coluna) const{
+	return prefixo + "." + coluna.tabela + "." + coluna.nome;
+}
+
+void ExportadorColunar::escreverInteiro(unsigned int coluna, unsigned long long valor){
+	Coluna &c = colunas[coluna];
+	escreverLittleEndian(*c.bufDados, valor, larguraTipo(c.tipo));
+}
+
+void ExportadorColunar::escreverTexto(unsigned int coluna, const std::string &valor){
+	Coluna &c = colunas[coluna];
+	c.bufDados->escrever(valor.data(), valor.size());
+	c.tamanhoTexto += valor.size();
+	escreverLittleEndian(*c.bufDeslocamentos, c.tamanhoTexto, 8);
+}
+
+void ExportadorColunar::adicionar(unsigned int numOcorrencia, unsigned long long seq, bool terminado, const DescritorAcidente &descritor){
+	HistoricoAcidentes::TipoAcidente tipo = tipoAcidente(descritor);
+
+	// Colunas comuns
+	escreverInteiro(AC_NUM_OCORRENCIA, numOcorrencia);
+	escreverInteiro(AC_SEQ, seq);
+	escreverInteiro(AC_TERMINADO, terminado ? 1 : 0);
+	escreverInteiro(AC_TIPO, tipo);
+	escreverInteiro(AC_DATA, HistoricoAcidentes::compactarData(Date(descritor.data)));
+	escreverTexto(AC_LOCAL, descritor.nomeLocal);
+
+	// Colunas especificas: os campos que nao se aplicam ao tipo do acidente ficam vazios ou a 0
+	bool incendio = (tipo == HistoricoAcidentes::INCENDIO_DOMESTICO || tipo == HistoricoAcidentes::INCENDIO_FLORESTAL);
+	escreverTexto(AC_TIPO_CASA, (tipo == HistoricoAcidentes::ASSALTO || tipo == HistoricoAcidentes::INCENDIO_DOMESTICO) ? descritor.tipoCasa : std::string());
+	escreverTexto(AC_TIPO_ESTRADA, (tipo == HistoricoAcidentes::VIACAO) ? descritor.tipoEstrada : std::string());
+	escreverInteiro(AC_HA_FERIDOS, (tipo == HistoricoAcidentes::ASSALTO && descritor.haFeridos) ? 1 : 0);
+	escreverInteiro(AC_NUM_FERIDOS, (tipo == HistoricoAcidentes::VIACAO) ? descritor.numFeridos : 0);
+	escreverInteiro(AC_NUM_VEICULOS, (tipo == HistoricoAcidentes::VIACAO) ? descritor.numVeiculos : 0);
+	escreverInteiro(AC_NUM_BOMBEIROS, incendio ? descritor.numBombeirosNecess : 0);
+	escreverInteiro(AC_NUM_AUTOTANQUES, incendio ? descritor.numAutotanquesNecess : 0);
+	escreverInteiro(AC_AREA_CHAMAS, (tipo == HistoricoAcidentes::INCENDIO_FLORESTAL) ? descritor.areaChamas : 0);
+
+	// Atribuicoes: o acidente guarda a posicao da primeira e o numero de atribuicoes, que ficam contiguas na sua tabela
+	escreverInteiro(AC_PRIMEIRA_ATRIBUICAO, numAtribuicoes);
+	escreverInteiro(AC_NUM_ATRIBUICOES, descritor.atribuicoes.size());
+	for (unsigned int i=0 ; i<descritor.atribuicoes.size() ; i++){
+		const Atribuicao &atribuicao = descritor.atribuicoes.at(i);
+		escreverInteiro(AT_ACIDENTE, numAcidentes);
+		escreverInteiro(AT_NUM_OCORRENCIA, numOcorrencia);
+		escreverInteiro(AT_POSTO, atribuicao.getPostoId());
+		escreverInteiro(AT_SOCORRISTAS, atribuicao.getNumSocorristas());
+		escreverInteiro(AT_VEICULOS, atribuicao.getNumVeiculos());
+		escreverTexto(AT_TIPO_VEICULOS, atribuicao.getTipoVeiculos());
+		numAtribuicoes++;
+	}
+
+	numAcidentes++;
+}
+
+void ExportadorColunar::concluir(){
+	if (concluido)
+		return;
+
+	// O manifesto anterior deixa de ser valido enquanto as colunas sao substituidas
+	std::remove((prefixo + ".esquema").c_str());
+
+	// Enviar o que resta nos buffers (destruindo-os) e confirmar os ficheiros de cada coluna
+	for (unsigned int i=0 ; i<colunas.size() ; i++){
+		Coluna &coluna = colunas[i];
+		coluna.bufDados.reset();
+		coluna.dados->confirmar();
+		if (coluna.tipo == TEXTO){
+			coluna.bufDeslocamentos.reset();
+			coluna.deslocamentos->confirmar();
+		}
+	}
+
+	// Manifesto, escrito por ultimo; os ficheiros sao indicados relativamente ao diretorio do manifesto
+	std::string::size_type barra = prefixo.find_last_of('/');
+	std::string::size_type inicioNome = (barra == std::string::npos ? 0 : barra + 1);
+	FicheiroAtomico manifesto(prefixo + ".esquema");
+	std::ostream &ostr = manifesto.getStream();
+	ostr << "ESQUEMA " << VERSAO_ESQUEMA << '\n';
+	ostr << "ORDEM little-endian\n";
+	for (unsigned int i=0 ; i<colunas.size() ; i++){
+		const Coluna &coluna = colunas[i];
+		if (i == 0 || coluna.tabela != colunas[i-1].tabela)
+			ostr << "TABELA " << coluna.tabela << ' ' << (i < NUM_COLUNAS_ACIDENTES ? numAcidentes : numAtribuicoes) << '\n';
+		ostr << "COLUNA " << coluna.nome << ' ' << nomeTipo(coluna.tipo) << ' ' << nomeFicheiro(coluna).substr(inicioNome) << '\n';
+	}
+	manifesto.confirmar();
+
+	concluido = true;
+}
+
+unsigned long long ExportadorColunar::getNumAcidentes() const{
+	return numAcidentes;
+}
+
+unsigned long long ExportadorColunar::getNumAtribuicoes() const{
+	return numAtribuicoes;
+}
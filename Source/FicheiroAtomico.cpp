@@ -0,0 +1,67 @@
+#include "FicheiroAtomico.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+FicheiroAtomico::FicheiroAtomico(const std::string &destino)
+	: destino(destino) , temporario(destino + ".tmp") , confirmado(false) {
+	ostr.open(temporario, std::ios::binary | std::ios::trunc);
+
+	if(!ostr.is_open())	// ficheiro nao foi aberto com sucesso
+		throw ErroEscrita("Falha ao abrir o ficheiro \"" + temporario + "\" para escrever \"" + destino + "\".");
+}
+
+FicheiroAtomico::~FicheiroAtomico() {
+	if (confirmado)
+		return;
+
+	// A escrita nao foi confirmada: descartar o ficheiro temporario, o destino fica intacto
+	if (ostr.is_open())
+		ostr.close();
+	std::remove(temporario.c_str());
+}
+
+std::ostream & FicheiroAtomico::getStream(){
+	return ostr;
+}
+
+void FicheiroAtomico::confirmar(){
+	// Garantir que todo o conteudo chegou ao ficheiro temporario
+	ostr.flush();
+	bool sucesso = ostr.good();
+	ostr.close();
+
+	if (!sucesso || !sincronizar(temporario))
+		throw ErroEscrita("Falha ao escrever o ficheiro \"" + temporario + "\".");
+
+	// Substituir o destino de forma atomica
+	if (std::rename(temporario.c_str(), destino.c_str()) != 0)
+		throw ErroEscrita("Falha ao substituir o ficheiro \"" + destino + "\".");
+	confirmado = true;
+
+	// Tornar a renomeacao persistente
+	sincronizarDiretorio(destino);
+}
+
+bool FicheiroAtomico::sincronizar(const std::string &ficheiro){
+	int fd = open(ficheiro.c_str(), O_WRONLY);
+	if (fd < 0)
+		return false;
+
+	bool sucesso = (fsync(fd) == 0);
+	close(fd);
+	return sucesso;
+}
+
+void FicheiroAtomico::sincronizarDiretorio(const std::string &ficheiro){
+	// Obter o diretorio do ficheiro (o diretorio atual, caso o nome nao tenha '/')
+	std::string::size_type barra = ficheiro.find_last_of('/');
+	std::string diretorio = (barra == std::string::npos ? "." : ficheiro.substr(0, barra + 1));
+
+	int fd = open(diretorio.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;		// Nem todos os sistemas permitem abrir diretorios; a renomeacao ja foi feita
+
+	fsync(fd);
+	close(fd);
+}
@@ -0,0 +1,55 @@
+#include "FicheiroMapeado.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+FicheiroMapeado::FicheiroMapeado() : dados(NULL) , tamanho(0) {}
+
+FicheiroMapeado::~FicheiroMapeado() {
+	libertar();
+}
+
+bool FicheiroMapeado::mapear(const std::string &ficheiro){
+	libertar();
+
+	int fd = open(ficheiro.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0){
+		close(fd);
+		return false;
+	}
+
+	// Um ficheiro vazio nao pode ser mapeado: fica com um mapeamento vazio
+	if (info.st_size > 0){
+		void* mapa = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (mapa == MAP_FAILED){
+			close(fd);
+			return false;
+		}
+		dados = (const char*) mapa;
+		tamanho = info.st_size;
+	}
+
+	// O mapeamento continua valido depois de o descritor ser fechado
+	close(fd);
+	return true;
+}
+
+void FicheiroMapeado::libertar(){
+	if (dados != NULL)
+		munmap((void*) dados, tamanho);
+	dados = NULL;
+	tamanho = 0;
+}
+
+const char* FicheiroMapeado::getDados() const{
+	return dados;
+}
+
+unsigned long long FicheiroMapeado::getTamanho() const{
+	return tamanho;
+}
@@ -0,0 +1,104 @@
+#include "FilaPendentes.h"
+#include "Assalto.h"
+
+bool FilaPendentes::Chave::operator<(const Chave &outra) const{
+	if (gravidade != outra.gravidade)
+		return gravidade > outra.gravidade;
+	if (data < outra.data)
+		return true;
+	if (outra.data < data)
+		return false;
+	return numOcorrencia < outra.numOcorrencia;
+}
+
+FilaPendentes::FilaPendentes() {}
+
+unsigned int FilaPendentes::getGravidade(const Acidente* acidente){
+	std::string tipoAcidente = acidente->getTipoAcidente();
+	if ((tipoAcidente == "Incendio Florestal") || (tipoAcidente == "Incendio Domestico"))
+		return 3;
+	if (tipoAcidente == "Acidente de Viacao")
+		return 2;
+	return (dynamic_cast<const Assalto*>(acidente)->haFeridos() ? 1 : 0);
+}
+
+void FilaPendentes::retirarDasFilas(const Entrada &entrada){
+	for (unsigned int i=0 ; i<ResultadoDespacho::NUM_RECURSOS ; i++){
+		porRecurso[i].erase(entrada.chave);
+	}
+}
+
+void FilaPendentes::atualizar(Acidente* acidente, const ResultadoDespacho &resultado){
+	unsigned int numOcorrencia = acidente->getNumOcorrencia();
+	std::map<unsigned int, Entrada>::iterator it = entradas.find(numOcorrencia);
+
+	// Apenas as filas deste acidente sao tocadas
+	if (it != entradas.end()){
+		retirarDasFilas(it->second);
+		entradas.erase(it);
+	}
+
+	bool haFalta = false;
+	for (unsigned int i=0 ; i<ResultadoDespacho::NUM_RECURSOS ; i++){
+		if (resultado.falta[i] != 0)
+			haFalta = true;
+	}
+	if (!haFalta)
+		return;
+
+	Entrada entrada(acidente, Chave(getGravidade(acidente), acidente->getData(), numOcorrencia));
+	for (unsigned int i=0 ; i<ResultadoDespacho::NUM_RECURSOS ; i++){
+		entrada.falta[i] = resultado.falta[i];
+	}
+	entradas.insert(std::make_pair(numOcorrencia, entrada));
+
+	if (entrada.falta[ResultadoDespacho::AUTOTANQUES] != 0)
+		porRecurso[ResultadoDespacho::AUTOTANQUES].insert(entrada.chave);
+	if (entrada.falta[ResultadoDespacho::EQUIPAS_POLICIAIS] != 0)
+		porRecurso[ResultadoDespacho::EQUIPAS_POLICIAIS].insert(entrada.chave);
+	if (entrada.falta[ResultadoDespacho::EQUIPAS_MEDICAS] != 0)
+		porRecurso[ResultadoDespacho::EQUIPAS_MEDICAS].insert(entrada.chave);
+}
+
+bool FilaPendentes::remover(unsigned int numOcorrencia){
+	std::map<unsigned int, Entrada>::iterator it = entradas.find(numOcorrencia);
+	if (it == entradas.end())
+		return false;
+
+	retirarDasFilas(it->second);
+	entradas.erase(it);
+	return true;
+}
+
+unsigned int FilaPendentes::getUnidadesEmFalta(unsigned int numOcorrencia, ResultadoDespacho::TipoRecurso recurso) const{
+	std::map<unsigned int, Entrada>::const_iterator it = entradas.find(numOcorrencia);
+	if (it == entradas.end())
+		return 0;
+
+	return it->second.falta[recurso];
+}
+
+std::vector<Acidente*> FilaPendentes::getPendentes(ResultadoDespacho::TipoRecurso recurso) const{
+	std::vector<Acidente*> resultado;
+	for (std::set<Chave>::const_iterator it = porRecurso[recurso].begin() ; it != porRecurso[recurso].end() ; it++){
+		resultado.push_back(entradas.find(it->numOcorrencia)->second.acidente);
+	}
+	return resultado;
+}
+
+std::vector<Acidente*> FilaPendentes::getPendentes() const{
+	std::set<Chave> ordem;
+	for (std::map<unsigned int, Entrada>::const_iterator it = entradas.begin() ; it != entradas.end() ; it++){
+		ordem.insert(it->second.chave);
+	}
+
+	std::vector<Acidente*> resultado;
+	for (std::set<Chave>::const_iterator it = ordem.begin() ; it != ordem.end() ; it++){
+		resultado.push_back(entradas.find(it->numOcorrencia)->second.acidente);
+	}
+	return resultado;
+}
+
+unsigned int FilaPendentes::getNumPendentes() const{
+	return entradas.size();
+}
@@ -0,0 +1,183 @@
+#include "FluxoCustoMinimo.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+FluxoCustoMinimo::FluxoCustoMinimo() {}
+
+unsigned int FluxoCustoMinimo::adicionarNo(){
+	saidas.push_back(std::vector<unsigned int>());
+	excesso.push_back(0);
+	oferta.push_back(0);
+	potencial.push_back(0);
+	return saidas.size() - 1;
+}
+
+unsigned int FluxoCustoMinimo::adicionarAresta(unsigned int origem, unsigned int destino, long long capacidade, long long custo){
+	unsigned int indice = arestas.size();
+
+	Aresta direta = { destino, capacidade, custo };
+	Aresta inversa = { origem, 0, -custo };
+	arestas.push_back(direta);
+	arestas.push_back(inversa);
+	saidas[origem].push_back(indice);
+	saidas[destino].push_back(indice + 1);
+
+	return indice;
+}
+
+long long FluxoCustoMinimo::custoReduzido(unsigned int origem, unsigned int aresta) const{
+	return arestas[aresta].custo + potencial[origem] - potencial[arestas[aresta].destino];
+}
+
+void FluxoCustoMinimo::empurrar(unsigned int aresta, long long quantidade){
+	unsigned int destino = arestas[aresta].destino;
+	unsigned int origem = arestas[aresta ^ 1].destino;
+
+	arestas[aresta].residual -= quantidade;
+	arestas[aresta ^ 1].residual += quantidade;
+	excesso[origem] -= quantidade;
+	excesso[destino] += quantidade;
+}
+
+void FluxoCustoMinimo::alterarCapacidade(unsigned int aresta, long long capacidade){
+	long long fluxo = getFluxo(aresta);
+	// O fluxo que deixa de caber e devolvido a origem (fica em excesso) e retirado ao destino (fica em defice)
+	if (fluxo > capacidade){
+		empurrar(aresta ^ 1, fluxo - capacidade);
+		fluxo = capacidade;
+	}
+	arestas[aresta].residual = capacidade - fluxo;
+}
+
+void FluxoCustoMinimo::recuar(unsigned int numNos, unsigned int numArestas){
+	// As arestas sao retiradas pela ordem inversa: cada uma e sempre a ultima saida dos seus dois nos
+	while (arestas.size() > numArestas){
+		unsigned int aresta = arestas.size() - 2;
+		long long fluxo = getFluxo(aresta);
+		if (fluxo > 0)
+			empurrar(aresta ^ 1, fluxo);
+
+		saidas[arestas[aresta].destino].pop_back();
+		saidas[arestas[aresta ^ 1].destino].pop_back();
+		arestas.pop_back();
+		arestas.pop_back();
+	}
+
+	saidas.resize(numNos);
+	excesso.resize(numNos);
+	oferta.resize(numNos);
+	potencial.resize(numNos);
+}
+
+void FluxoCustoMinimo::definirOferta(unsigned int no, long long valor){
+	excesso[no] += valor - oferta[no];
+	oferta[no] = valor;
+}
+
+bool FluxoCustoMinimo::resolver(){
+	const long long INFINITO = std::numeric_limits<long long>::max() / 4;
+	unsigned int numNos = saidas.size();
+
+	std::vector<long long> distancia(numNos);
+	std::vector<int> anterior(numNos);
+	std::vector<bool> fixo(numNos);
+
+	// Arranque a quente: as arestas residuais com custo reduzido negativo (capacidades alteradas ou arestas novas) sao saturadas, criando excessos e defices que sao reencaminhados abaixo
+	for (unsigned int no=0 ; no<numNos ; no++){
+		for (unsigned int i=0 ; i<saidas[no].size() ; i++){
+			unsigned int aresta = saidas[no][i];
+			if (arestas[aresta].residual > 0 && custoReduzido(no, aresta) < 0)
+				empurrar(aresta, arestas[aresta].residual);
+		}
+	}
+
+	while (true){
+		// Dijkstra (com custos reduzidos) a partir de todos os nos com excesso, ate ao primeiro no com defice
+		std::priority_queue< std::pair<long long, unsigned int>, std::vector< std::pair<long long, unsigned int> >, std::greater< std::pair<long long, unsigned int> > > fila;
+		bool haExcesso = false;
+		for (unsigned int no=0 ; no<numNos ; no++){
+			distancia[no] = INFINITO;
+			anterior[no] = -1;
+			fixo[no] = false;
+			if (excesso[no] > 0){
+				distancia[no] = 0;
+				fila.push(std::make_pair(0LL, no));
+				haExcesso = true;
+			}
+		}
+		if (!haExcesso)
+			return true;	// Todo o excesso foi encaminhado
+
+		int alvo = -1;
+		while (!fila.empty()){
+			unsigned int no = fila.top().second;
+			fila.pop();
+			if (fixo[no])
+				continue;
+			fixo[no] = true;
+
+			if (excesso[no] < 0){
+				alvo = no;
+				break;
+			}
+
+			for (unsigned int i=0 ; i<saidas[no].size() ; i++){
+				unsigned int aresta = saidas[no][i];
+				if (arestas[aresta].residual <= 0)
+					continue;
+				unsigned int destino = arestas[aresta].destino;
+				long long nova = distancia[no] + custoReduzido(no, aresta);
+				if (nova < distancia[destino]){
+					distancia[destino] = nova;
+					anterior[destino] = aresta;
+					fila.push(std::make_pair(nova, destino));
+				}
+			}
+		}
+		if (alvo == -1)
+			return false;	// Ha excesso sem caminho para nenhum defice
+
+		// Atualizar os potenciais: os custos reduzidos continuam nao negativos e os do caminho encontrado passam a 0
+		long long distanciaAlvo = distancia[alvo];
+		for (unsigned int no=0 ; no<numNos ; no++){
+			potencial[no] += std::min(distancia[no], distanciaAlvo);
+		}
+
+		// Quantidade a enviar: limitada pelo excesso da origem, pelo defice do alvo e pelas capacidades do caminho
+		long long quantidade = -excesso[alvo];
+		unsigned int no = alvo;
+		while (anterior[no] != -1){
+			quantidade = std::min(quantidade, arestas[anterior[no]].residual);
+			no = arestas[anterior[no] ^ 1].destino;
+		}
+		quantidade = std::min(quantidade, excesso[no]);
+
+		no = alvo;
+		while (anterior[no] != -1){
+			unsigned int aresta = anterior[no];
+			no = arestas[aresta ^ 1].destino;
+			empurrar(aresta, quantidade);
+		}
+	}
+}
+
+long long FluxoCustoMinimo::getFluxo(unsigned int aresta) const{
+	return arestas[aresta ^ 1].residual;
+}
+
+long long FluxoCustoMinimo::getCustoTotal() const{
+	long long total = 0;
+	for (unsigned int i=0 ; i<arestas.size() ; i+=2){
+		total += arestas[i].custo * arestas[i ^ 1].residual;
+	}
+	return total;
+}
+
+unsigned int FluxoCustoMinimo::getNumNos() const{
+	return saidas.size();
+}
+
+unsigned int FluxoCustoMinimo::getNumArestas() const{
+	return arestas.size();
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "HistoricoAcidentes.h"
+#include "Assalto.h"
+#include "AcidenteViacao.h"
+#include "IncendioDomestico.h"
+#include "IncendioFlorestal.h"
+
+uint16_t Dicionario::codificar(const std::string &texto){
+	std::map<std::string, uint16_t>::const_iterator it = codigos.find(texto);
+	if (it != codigos.end())
+		return it->second;
+
+	// Texto novo, acrescentar ao dicionario
+	uint16_t codigo = textos.size();
+	textos.push_back(texto);
+	codigos[texto] = codigo;
+	return codigo;
+}
+
+int Dicionario::procurar(const std::string &texto) const{
+	std::map<std::string, uint16_t>::const_iterator it = codigos.find(texto);
+	return (it == codigos.end() ? -1 : it->second);
+}
+
+const std::string & Dicionario::descodificar(uint16_t codigo) const{
+	return textos.at(codigo);
+}
+
+unsigned int Dicionario::size() const{
+	return textos.size();
+}
+
+
+
+HistoricoAcidentes::HistoricoAcidentes() {
+	inicioAtribuicoes.push_back(0);
+}
+
+uint32_t HistoricoAcidentes::compactarData(const Date &data){
+	return (data.getAno() << 9) | (data.getMes() << 5) | data.getDia();
+}
+
+void HistoricoAcidentes::adicionar(const Acidente* acidente){
+	unsigned int linha = numOcorrencia.size();
+
+	// Colunas comuns
+	numOcorrencia.push_back(acidente->getNumOcorrencia());
+	local.push_back(locais.codificar(acidente->getLocal()->getNome()));
+	data.push_back(compactarData(acidente->getData()));
+
+	// Colunas especificas do tipo de acidente
+	std::string tipoAcidente = acidente->getTipoAcidente();
+	if (tipoAcidente == "Assalto"){
+		const Assalto* assalto = dynamic_cast<const Assalto*>(acidente);
+		tipo.push_back(ASSALTO);
+		tipoCasa.adicionar(linha, textos.codificar(assalto->getTipoCasa()));
+		haFeridos.adicionar(linha, assalto->haFeridos());
+	}
+	else if (tipoAcidente == "Acidente de Viacao"){
+		const AcidenteViacao* acidenteViacao = dynamic_cast<const AcidenteViacao*>(acidente);
+		tipo.push_back(VIACAO);
+		tipoEstrada.adicionar(linha, textos.codificar(acidenteViacao->getTipoEstrada()));
+		numFeridos.adicionar(linha, acidenteViacao->getNumFeridos());
+		numVeiculos.adicionar(linha, acidenteViacao->getNumVeiculos());
+	}
+	else {
+		const Incendio* incendio = dynamic_cast<const Incendio*>(acidente);
+		numBombeirosNecess.adicionar(linha, incendio->getNumBombeirosNecess());
+		numAutotanquesNecess.adicionar(linha, incendio->getNumAutotanquesNecess());
+
+		if (tipoAcidente == "Incendio Domestico"){
+			tipo.push_back(INCENDIO_DOMESTICO);
+			tipoCasa.adicionar(linha, textos.codificar(dynamic_cast<const IncendioDomestico*>(acidente)->getTipoCasa()));
+		}
+		else {
+			tipo.push_back(INCENDIO_FLORESTAL);
+			areaChamas.adicionar(linha, dynamic_cast<const IncendioFlorestal*>(acidente)->getAreaChamas());
+		}
+	}
+
+	// Atribuicoes, acrescentadas ao fim dos vetores de atribuicoes
+	std::vector<Atribuicao> atribuicoes = acidente->getAtribuicoes();
+	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
+		atribPostoId.push_back(atribuicoes.at(i).getPostoId());
+		atribSocorristas.push_back(atribuicoes.at(i).getNumSocorristas());
+		atribVeiculos.push_back(atribuicoes.at(i).getNumVeiculos());
+		atribTipoVeiculo.push_back(textos.codificar(atribuicoes.at(i).getTipoVeiculos()));
+	}
+	inicioAtribuicoes.push_back(atribPostoId.size());
+}
+
+unsigned int HistoricoAcidentes::getNumAcidentes() const{
+	return numOcorrencia.size();
+}
+
+std::vector<unsigned int> HistoricoAcidentes::contarPorTipo() const{
+	std::vector<unsigned int> contagem(NUM_TIPOS, 0);
+	for (unsigned int i=0 ; i<tipo.size() ; i++){
+		contagem[tipo[i]]++;
+	}
+	return contagem;
+}
+
+std::map<std::string, unsigned int> HistoricoAcidentes::contarPorLocal() const{
+	// Contar por codigo e so no fim traduzir os codigos para nomes
+	std::vector<unsigned int> contagem(locais.size(), 0);
+	for (unsigned int i=0 ; i<local.size() ; i++){
+		contagem[local[i]]++;
+	}
+
+	std::map<std::string, unsigned int> resultado;
+	for (unsigned int i=0 ; i<contagem.size() ; i++){
+		if (contagem[i] != 0)
+			resultado[locais.descodificar(i)] = contagem[i];
+	}
+	return resultado;
+}
+
+std::map<unsigned int, unsigned int> HistoricoAcidentes::contarPorAno() const{
+	std::map<unsigned int, unsigned int> resultado;
+	for (unsigned int i=0 ; i<data.size() ; i++){
+		resultado[data[i] >> 9]++;
+	}
+	return resultado;
+}
+
+unsigned int HistoricoAcidentes::contarIntervalo(const Date &inicio, const Date &fim) const{
+	uint32_t limiteInferior = compactarData(inicio), limiteSuperior = compactarData(fim);
+	unsigned int total = 0;
+	for (unsigned int i=0 ; i<data.size() ; i++){
+		total += (data[i] >= limiteInferior) & (data[i] <= limiteSuperior);
+	}
+	return total;
+}
+
+std::map<unsigned int, unsigned int> HistoricoAcidentes::somarSocorristasPorPosto() const{
+	std::map<unsigned int, unsigned int> resultado;
+	for (unsigned int i=0 ; i<atribPostoId.size() ; i++){
+		resultado[atribPostoId[i]] += atribSocorristas[i];
+	}
+	return resultado;
+}
+
+unsigned int HistoricoAcidentes::getNumOcorrencia(unsigned int linha) const{
+	return numOcorrencia.at(linha);
+}
+
+const std::string & HistoricoAcidentes::getNomeLocal(unsigned int linha) const{
+	return locais.descodificar(local.at(linha));
+}
+
+HistoricoAcidentes::TipoAcidente HistoricoAcidentes::getTipo(unsigned int linha) const{
+	return (TipoAcidente) tipo.at(linha);
+}
+
+uint32_t HistoricoAcidentes::getDataCompactada(unsigned int linha) const{
+	return data.at(linha);
+}
+
+std::vector<Atribuicao> HistoricoAcidentes::getAtribuicoes(unsigned int linha) const{
+	std::vector<Atribuicao> resultado;
+	for (unsigned int i=inicioAtribuicoes.at(linha) ; i<inicioAtribuicoes.at(linha+1) ; i++){
+		resultado.push_back(Atribuicao(atribPostoId[i], atribSocorristas[i], atribVeiculos[i], textos.descodificar(atribTipoVeiculo[i])));
+	}
+	return resultado;
+}
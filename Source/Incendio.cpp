@@ -1,4 +1,5 @@
 #include "Incendio.h"
+#include "EmparelhadorMeios.h"
 
 Incendio::Incendio(const std::string &data, const Local* local, unsigned int numOcorrencia, unsigned int numBombeirosNecess, unsigned int numAutotanquesNecess)
 	: Acidente(data,local,numOcorrencia) , numBombeirosNecess(numBombeirosNecess) , numAutotanquesNecess(numAutotanquesNecess) {}
@@ -14,3 +15,7 @@ const unsigned int Incendio::getNumAutotanquesNecess() const{
 Incendio::~Incendio() {
 	// TODO Auto-generated destructor stub
 }
+
+unsigned int Incendio::getNecessidades(Necessidade necessidades[MAX_NECESSIDADES]) const{
+	return EmparelhadorMeios::obterNecessidades(this, necessidades);
+}
@@ -26,13 +26,13 @@ void IncendioDomestico::printInfoAcidente() const {
 	std::cout << "Tipo de Casa: " << tipoCasa << std::endl;
 }
 
-void IncendioDomestico::printSimplifiedInfo(std::ostream & os) const{
+void IncendioDomestico::serializar(BufferEscrita & buf) const{
 	// Imprimir os dados do incendio propriamente dito
-	os << local->getNome() << '/' << data.getData() << "/Incendio/" << numAutotanquesNecess << '/' << numBombeirosNecess << "/Domestico/" << tipoCasa << '/' << atribuicoes.size();
+	buf << local->getNome() << '/' << data << "/Incendio/" << numAutotanquesNecess << '/' << numBombeirosNecess << "/Domestico/" << tipoCasa << '/' << atribuicoes.size();
 
 	// Imprimir info sob atribuições relativas a esta ocorrência
 	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
 		// Mudar de linha, fazer um tab para indexar e imprimir informação da atribuição
-		os << "\n\t" << atribuicoes.at(i);
+		buf << "\n\t" << atribuicoes.at(i);
 	}
 }
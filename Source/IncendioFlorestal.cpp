@@ -26,13 +26,13 @@ void IncendioFlorestal::printInfoAcidente() const {
 	std::cout << "Área das Chamas: " << areaChamas << std::endl;
 }
 
-void IncendioFlorestal::printSimplifiedInfo(std::ostream & os) const{
+void IncendioFlorestal::serializar(BufferEscrita & buf) const{
 	// Imprimir os dados do incendio propriamente dito
-	os << local->getNome() << '/' << data.getData() << "/Incendio/" << numAutotanquesNecess << '/' << numBombeirosNecess << "/Florestal/" << areaChamas << '/' << atribuicoes.size();
+	buf << local->getNome() << '/' << data << "/Incendio/" << numAutotanquesNecess << '/' << numBombeirosNecess << "/Florestal/" << areaChamas << '/' << atribuicoes.size();
 
 	// Imprimir info sob atribuições relativas a esta ocorrência
 	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
 		// Mudar de linha, fazer um tab para indexar e imprimir informação da atribuição
-		os << "\n\t" << atribuicoes.at(i);
+		buf << "\n\t" << atribuicoes.at(i);
 	}
 }
@@ -0,0 +1,138 @@
+#include "IndiceAcidentes.h"
+#include "AcidenteViacao.h"
+#include "Assalto.h"
+
+const BitmapComprimido IndiceAcidentes::vazio;
+const unsigned int IndiceAcidentes::SEM_LINHA;
+
+IndiceAcidentes::IndiceAcidentes() {}
+
+unsigned int IndiceAcidentes::indexar(const Acidente* acidente){
+	// As linhas sao atribuidas sequencialmente: os bitmaps ficam densos mesmo com numeros de ocorrencia dispersos ou reutilizados
+	unsigned int linha = acidentesLinha.size();
+	acidentesLinha.push_back(NULL);
+	linhasHistorico.push_back(SEM_LINHA);
+
+	// Atributos comuns a todos os acidentes
+	todos.adicionar(linha);
+	porTipo[acidente->getTipoAcidente()].adicionar(linha);
+	porLocal[acidente->getLocal()->getNome()].adicionar(linha);
+	porAno[acidente->getData().getAno()].adicionar(linha);
+
+	// Atributos especificos de Acidentes de Viacao
+	const AcidenteViacao* acidenteViacao = dynamic_cast<const AcidenteViacao*>(acidente);
+	if (acidenteViacao != NULL)
+		porTipoEstrada[acidenteViacao->getTipoEstrada()].adicionar(linha);
+
+	// Atributos especificos de Assaltos
+	const Assalto* assalto = dynamic_cast<const Assalto*>(acidente);
+	if (assalto != NULL && assalto->haFeridos())
+		assaltosComFeridos.adicionar(linha);
+
+	return linha;
+}
+
+unsigned int IndiceAcidentes::adicionar(Acidente* acidente){
+	unsigned int linha = indexar(acidente);
+	acidentesLinha[linha] = acidente;
+	linhasEmDecurso[acidente->getNumOcorrencia()] = linha;
+	emDecurso.adicionar(linha);
+	return linha;
+}
+
+unsigned int IndiceAcidentes::adicionarTerminado(const Acidente* acidente, unsigned int linhaHistorico){
+	unsigned int linha = indexar(acidente);
+	linhasHistorico[linha] = linhaHistorico;
+	terminados.adicionar(linha);
+	return linha;
+}
+
+void IndiceAcidentes::terminar(const Acidente* acidente, unsigned int linhaHistorico){
+	std::map<unsigned int, unsigned int>::iterator it = linhasEmDecurso.find(acidente->getNumOcorrencia());
+	if (it == linhasEmDecurso.end())
+		return;
+
+	// Os atributos nao mudam: a linha so passa dos acidentes em decurso para os terminados
+	unsigned int linha = it->second;
+	linhasEmDecurso.erase(it);
+	acidentesLinha[linha] = NULL;
+	linhasHistorico[linha] = linhaHistorico;
+	emDecurso.remover(linha);
+	terminados.adicionar(linha);
+}
+
+void IndiceAcidentes::remover(const Acidente* acidente){
+	std::map<unsigned int, unsigned int>::iterator it = linhasEmDecurso.find(acidente->getNumOcorrencia());
+	if (it == linhasEmDecurso.end())
+		return;
+
+	unsigned int linha = it->second;
+	linhasEmDecurso.erase(it);
+	acidentesLinha[linha] = NULL;
+
+	todos.remover(linha);
+	emDecurso.remover(linha);
+	removerDe(porTipo, acidente->getTipoAcidente(), linha);
+	removerDe(porLocal, acidente->getLocal()->getNome(), linha);
+	removerDe(porAno, acidente->getData().getAno(), linha);
+
+	const AcidenteViacao* acidenteViacao = dynamic_cast<const AcidenteViacao*>(acidente);
+	if (acidenteViacao != NULL)
+		removerDe(porTipoEstrada, acidenteViacao->getTipoEstrada(), linha);
+
+	assaltosComFeridos.remover(linha);
+}
+
+void IndiceAcidentes::limpar(){
+	porTipo.clear();
+	porLocal.clear();
+	porAno.clear();
+	porTipoEstrada.clear();
+	assaltosComFeridos = BitmapComprimido();
+	todos = BitmapComprimido();
+	emDecurso = BitmapComprimido();
+	terminados = BitmapComprimido();
+	acidentesLinha.clear();
+	linhasHistorico.clear();
+	linhasEmDecurso.clear();
+}
+
+Acidente* IndiceAcidentes::getAcidente(unsigned int linha) const{
+	return (linha < acidentesLinha.size() ? acidentesLinha[linha] : NULL);
+}
+
+unsigned int IndiceAcidentes::getLinhaHistorico(unsigned int linha) const{
+	return (linha < linhasHistorico.size() ? linhasHistorico[linha] : SEM_LINHA);
+}
+
+const BitmapComprimido & IndiceAcidentes::getTodos() const{
+	return todos;
+}
+
+const BitmapComprimido & IndiceAcidentes::getEmDecurso() const{
+	return emDecurso;
+}
+
+const BitmapComprimido & IndiceAcidentes::getTerminados() const{
+	return terminados;
+}
+
+const BitmapComprimido & IndiceAcidentes::getTipo(const std::string &tipo) const{
+	return procurar(porTipo, tipo);
+}
+
+const BitmapComprimido & IndiceAcidentes::getLocal(const std::string &nomeLocal) const{
+	return procurar(porLocal, nomeLocal);
+}
+
+const BitmapComprimido & IndiceAcidentes::getAno(unsigned int ano) const{
+	return procurar(porAno, ano);
+}
+
+const BitmapComprimido & IndiceAcidentes::getTipoEstrada(const std::string &tipoEstrada) const{
+	return procurar(porTipoEstrada, tipoEstrada);
+}
+
+const BitmapComprimido & IndiceAcidentes::getAssaltosComFeridos() const{
+	return assaltosComFeridos;
+}
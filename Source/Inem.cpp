@@ -1,7 +1,10 @@
 #include "Inem.h"
 
 Inem::Inem(const unsigned int id, const Local* local, unsigned int numSocorristas, unsigned int numVeiculos, const std::string &tipoVeiculo)
-	: Posto(id,local,numSocorristas,numVeiculos) , tipoVeiculo(tipoVeiculo) {}
+	: Posto(id,local,numSocorristas,numVeiculos) , tipoVeiculo(tipoVeiculo) {
+	tripulacoes[ResultadoDespacho::EQUIPAS_MEDICAS] = (tipoVeiculo == "Moto" ? 1 : 2);	// Cada moto leva 1 medico, cada carro / ambulancia leva 2
+	contadoresVeiculos[ResultadoDespacho::EQUIPAS_MEDICAS] = &this->numVeiculos;
+}
 
 
 Inem::~Inem() {
@@ -16,6 +19,10 @@ std::string Inem::getTipoPosto() const{
 	return "Inem";
 }
 
+std::string Inem::getTipoVeiculos(ResultadoDespacho::TipoRecurso) const{
+	return tipoVeiculo;
+}
+
 void Inem::printInfoPosto() const{
 	std::cout << "***  INEM  ***" << std::endl;
 	std::cout << "Localidade: " << local->getNome() << std::endl;
@@ -25,6 +32,6 @@ void Inem::printInfoPosto() const{
 	std::cout << "Tipo de Veiculo usado: " << tipoVeiculo << std::endl;
 }
 
-void Inem::printSimplifiedInfo(std::ostream & os) const{
-	os << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Inem/" << tipoVeiculo;
+void Inem::serializar(BufferEscrita & buf) const{
+	buf << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Inem/" << tipoVeiculo;
 }
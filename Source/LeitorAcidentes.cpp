@@ -0,0 +1,138 @@
+#include "LeitorAcidentes.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include "Erro.h"
+#include "SegmentoCheckpoint.h"
+
+unsigned int LeitorAcidentes::proximaEntrada(const std::string &texto, unsigned int pos){
+	if (pos == 0)
+		return 0;
+
+	// Avancar ate ao inicio de uma linha que nao seja uma atribuicao (as atribuicoes comecam por '\t')
+	std::string::size_type procura = pos - 1;
+	while (true){
+		std::string::size_type fimLinha = texto.find('\n', procura);
+		if (fimLinha == std::string::npos || fimLinha + 1 >= texto.size())
+			return texto.size();
+		if (texto[fimLinha + 1] != '\t')
+			return fimLinha + 1;
+		procura = fimLinha + 1;
+	}
+}
+
+/**
+ * @brief Calcula o número da linha de uma posição do texto
+ * @param texto - Início do texto
+ * @param pos - Posição no texto
+ * @return Retorna o número da linha (a primeira linha é a 1)
+ */
+static unsigned int numeroLinha(const char* texto, const char* pos){
+	return std::count(texto, pos, '\n') + 1;
+}
+
+void LeitorAcidentes::lerBloco(const char* texto, const char* inicio, const char* fim, bool validar, std::vector<DescritorAcidente> &resultado, std::string &erro){
+	// Os erros nao podem sair da thread como excecao: sao devolvidos em "erro" e lancados por lerTexto
+	DescritorAcidente descritor;
+	while (true){
+		while (inicio < fim && (*inicio == '\n' || *inicio == '\r'))
+			inicio++;
+		const char* entrada = inicio;
+
+		try {
+			if (!DescritorAcidente::ler(inicio, fim, descritor))
+				return;
+		}
+		catch (InputInvalido &e){
+			std::ostringstream mensagem;
+			mensagem << "Linha " << numeroLinha(texto, inicio) << " do ficheiro de acidentes: " << e.getInfo();
+			erro = mensagem.str();
+			return;
+		}
+
+		if (validar && !descritor.valido()){
+			std::ostringstream mensagem;
+			mensagem << "Linha " << numeroLinha(texto, entrada) << " do ficheiro de acidentes: acidente invalido (" << descritor.tipo << ")";
+			erro = mensagem.str();
+			return;
+		}
+		resultado.push_back(std::move(descritor));
+	}
+}
+
+std::vector<DescritorAcidente> LeitorAcidentes::lerFicheiro(const std::string &ficheiro, unsigned int numThreads, unsigned long long* assinatura, bool validar){
+	std::ifstream istr(ficheiro, std::ios::binary);
+
+	if(!istr.is_open())	// ficheiro nao foi aberto com sucesso
+		throw FicheiroNaoEncontrado("Falha ao abrir o ficheiro \"" + ficheiro + "\" no construtor de ProtecaoCivil.");
+
+	// Ler o ficheiro inteiro de uma so vez
+	std::ostringstream conteudo;
+	conteudo << istr.rdbuf();
+	istr.close();
+
+	const std::string texto = conteudo.str();
+	if (assinatura != NULL)		// Identificar a base sobre a qual sao aplicados os segmentos de checkpoint
+		*assinatura = SegmentoCheckpoint::calcularAssinatura(texto.data(), texto.size());
+
+	return lerTexto(texto, numThreads, validar);
+}
+
+std::vector<DescritorAcidente> LeitorAcidentes::lerTexto(const std::string &texto, unsigned int numThreads, bool validar){
+	if (numThreads == 0)
+		numThreads = std::thread::hardware_concurrency();
+	if (numThreads == 0)
+		numThreads = 1;
+
+	// Nao vale a pena dividir textos pequenos
+	unsigned int numBlocos = texto.size() / TAMANHO_MINIMO_BLOCO + 1;
+	if (numBlocos > numThreads)
+		numBlocos = numThreads;
+
+	// Dividir o texto em blocos de tamanho semelhante, cortando apenas no inicio de entradas
+	std::vector<unsigned int> limites;
+	limites.push_back(0);
+	for (unsigned int i=1 ; i<numBlocos ; i++){
+		unsigned int limite = proximaEntrada(texto, (unsigned long long) texto.size() * i / numBlocos);
+		if (limite > limites.back())
+			limites.push_back(limite);
+	}
+	limites.push_back(texto.size());
+
+	// Ler cada bloco numa thread propria (o primeiro bloco e lido na thread atual)
+	std::vector< std::vector<DescritorAcidente> > resultados(limites.size() - 1);
+	std::vector<std::string> erros(resultados.size());
+	std::vector<std::thread> threads;
+	const char* base = texto.data();
+	for (unsigned int i=1 ; i<resultados.size() ; i++){
+		threads.push_back(std::thread(lerBloco, base, base + limites[i], base + limites[i+1], validar, std::ref(resultados[i]), std::ref(erros[i])));
+	}
+	lerBloco(base, base + limites[0], base + limites[1], validar, resultados[0], erros[0]);
+
+	for (unsigned int i=0 ; i<threads.size() ; i++){
+		threads[i].join();
+	}
+
+	// O primeiro erro pela ordem do ficheiro
+	for (unsigned int i=0 ; i<erros.size() ; i++){
+		if (!erros[i].empty())
+			throw InputInvalido(erros[i]);
+	}
+
+	// Juntar os resultados de todos os blocos, pela ordem do ficheiro
+	unsigned int total = 0;
+	for (unsigned int i=0 ; i<resultados.size() ; i++){
+		total += resultados[i].size();
+	}
+
+	std::vector<DescritorAcidente> descritores;
+	descritores.reserve(total);
+	for (unsigned int i=0 ; i<resultados.size() ; i++){
+		for (unsigned int j=0 ; j<resultados[i].size() ; j++){
+			descritores.push_back(std::move(resultados[i][j]));
+		}
+	}
+
+	return descritores;
+}
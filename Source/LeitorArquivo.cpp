@@ -0,0 +1,79 @@
+#include "LeitorArquivo.h"
+
+LeitorArquivo::LeitorArquivo(const ArquivoAcidentes &arquivo, const std::vector<Local> &locais, const std::map<std::string, unsigned int> &indiceLocais, unsigned int capacidade)
+	: arquivo(arquivo) , locais(locais) , indiceLocais(indiceLocais) , capacidade(capacidade > 0 ? capacidade : 1) {}
+
+void LeitorArquivo::indexarNumero(unsigned int numOcorrencia){
+	std::vector<ReferenciaBloco> blocos = arquivo.procurarBlocos(numOcorrencia);
+
+	for (unsigned int i=0 ; i<blocos.size() ; i++){
+		// Um bloco so e lido de novo se tiver recebido registos desde a ultima leitura (apenas o ultimo de cada particao cresce)
+		unsigned int &lidos = blocosLidos[std::make_pair(blocos.at(i).ano, blocos.at(i).indice)];
+		if (lidos == blocos.at(i).numRegistos)
+			continue;
+
+		// Guardar a posicao do registo mais recente de cada numero de ocorrencia do bloco
+		std::vector<PosicaoRegisto> posicoesBloco = arquivo.lerPosicoes(blocos.at(i));
+		for (unsigned int j=lidos ; j<posicoesBloco.size() ; j++){
+			std::map<unsigned int, PosicaoRegisto>::iterator it = posicoes.find(posicoesBloco.at(j).numOcorrencia);
+			if (it == posicoes.end())
+				posicoes[posicoesBloco.at(j).numOcorrencia] = posicoesBloco.at(j);
+			else if (it->second.seq < posicoesBloco.at(j).seq)
+				it->second = posicoesBloco.at(j);
+		}
+		lidos = posicoesBloco.size();
+	}
+}
+
+std::shared_ptr<const Acidente> LeitorArquivo::obter(unsigned int numOcorrencia){
+	indexarNumero(numOcorrencia);
+
+	std::map<unsigned int, PosicaoRegisto>::const_iterator posicao = posicoes.find(numOcorrencia);
+	if (posicao == posicoes.end())
+		return std::shared_ptr<const Acidente>();		// Nao esta no arquivo
+
+	// Em cache, e materializado a partir do registo mais recente: passa a ser o usado mais recentemente
+	std::map<unsigned int, std::list<EntradaCache>::iterator>::iterator emCache = indiceCache.find(numOcorrencia);
+	if (emCache != indiceCache.end()){
+		if (emCache->second->seq == posicao->second.seq){
+			cache.splice(cache.begin(), cache, emCache->second);
+			return emCache->second->acidente;
+		}
+
+		// O numero de ocorrencia foi reutilizado e arquivado de novo
+		cache.erase(emCache->second);
+		indiceCache.erase(emCache);
+	}
+
+	// Ler e materializar apenas o registo deste acidente
+	RegistoArquivo registo;
+	if (!arquivo.lerRegisto(posicao->second, registo))
+		return std::shared_ptr<const Acidente>();
+
+	std::map<std::string, unsigned int>::const_iterator local = indiceLocais.find(registo.descritor.nomeLocal);
+	if (local == indiceLocais.end())
+		return std::shared_ptr<const Acidente>();
+
+	EntradaCache entrada;
+	entrada.numOcorrencia = numOcorrencia;
+	entrada.seq = registo.seq;
+	entrada.acidente = std::shared_ptr<const Acidente>(registo.descritor.criarAcidente(&locais.at(local->second), numOcorrencia));
+	cache.push_front(entrada);
+	indiceCache[numOcorrencia] = cache.begin();
+
+	// Descartar o acidente usado ha mais tempo
+	if (cache.size() > capacidade){
+		indiceCache.erase(cache.back().numOcorrencia);
+		cache.pop_back();
+	}
+
+	return entrada.acidente;
+}
+
+unsigned int LeitorArquivo::getNumEmCache() const{
+	return cache.size();
+}
+
+unsigned int LeitorArquivo::getNumPosicoes() const{
+	return posicoes.size();
+}
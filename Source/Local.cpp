@@ -6,7 +6,7 @@ Local::Local(const std::string nome, unsigned int x_coord, unsigned int y_coord)
 
 Local::~Local() {}
 
-const std::string Local::getNome() const{
+const std::string & Local::getNome() const{
 	return nome;
 }
 
@@ -0,0 +1,158 @@
+#include "MapaCobertura.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "OtimizadorDespacho.h"
+
+MapaCobertura::MapaCobertura() : locais(NULL), rankings(NULL) {}
+
+bool MapaCobertura::recursoCoberto(ResultadoDespacho::TipoRecurso recurso){
+	return recurso == ResultadoDespacho::AUTOTANQUES || recurso == ResultadoDespacho::EQUIPAS_POLICIAIS || recurso == ResultadoDespacho::EQUIPAS_MEDICAS;
+}
+
+void MapaCobertura::construir(const std::vector<Local> &locais, const std::vector<Posto*> &postos, const std::vector< std::vector<Posto*> > &rankings){
+	this->locais = &locais;
+	this->rankings = &rankings;
+	indicesPostos.clear();
+	for (unsigned int p=0 ; p<postos.size() ; p++){
+		indicesPostos[postos.at(p)->getId()] = p;
+	}
+
+	// Posicao de cada posto no ranking de cada local, e locais de cada posto por distancia
+	posicoes.assign(locais.size(), std::vector<unsigned int>(postos.size(), 0));
+	vizinhos.assign(postos.size(), std::vector< std::pair<double, unsigned int> >());
+	for (unsigned int l=0 ; l<rankings.size() ; l++){
+		for (unsigned int i=0 ; i<rankings.at(l).size() ; i++){
+			unsigned int p = indicesPostos.at(rankings.at(l).at(i)->getId());
+			posicoes[l][p] = i;
+			vizinhos[p].push_back(std::make_pair(OtimizadorDespacho::distancia(rankings.at(l).at(i), locais.at(l)), l));
+		}
+	}
+	for (unsigned int p=0 ; p<vizinhos.size() ; p++){
+		std::sort(vizinhos[p].begin(), vizinhos[p].end());
+	}
+
+	disponivel.assign(postos.size(), std::vector<bool>(ResultadoDespacho::NUM_RECURSOS, false));
+	cobertos.assign(postos.size(), std::vector< std::set<unsigned int> >(ResultadoDespacho::NUM_RECURSOS));
+	for (unsigned int p=0 ; p<postos.size() ; p++){
+		for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+			disponivel[p][r] = (OtimizadorDespacho::getOferta(postos.at(p), (ResultadoDespacho::TipoRecurso)r) > 0);
+		}
+	}
+
+	// Todos os locais comecam descobertos e procuram o primeiro posto com oferta no seu ranking
+	Cobertura descoberto;
+	descoberto.posicao = 0;
+	descoberto.distancia = std::numeric_limits<double>::infinity();
+	cobertura.assign(locais.size(), std::vector<Cobertura>(ResultadoDespacho::NUM_RECURSOS, descoberto));
+	raios.assign(ResultadoDespacho::NUM_RECURSOS, std::multiset<double>());
+	descobertos.assign(ResultadoDespacho::NUM_RECURSOS, std::set<unsigned int>());
+	for (unsigned int l=0 ; l<locais.size() ; l++){
+		for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+			if (!recursoCoberto((ResultadoDespacho::TipoRecurso)r))
+				continue;
+			cobertura[l][r].posicao = rankings.at(l).size();
+			descobertos[r].insert(l);
+			procurar(l, (ResultadoDespacho::TipoRecurso)r, 0);
+		}
+	}
+}
+
+void MapaCobertura::cobrir(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, unsigned int posicao){
+	const std::vector<Posto*> &ranking = rankings->at(indiceLocal);
+	Cobertura &atual = cobertura[indiceLocal][recurso];
+	if (atual.posicao < ranking.size()){
+		cobertos[indicesPostos.at(ranking.at(atual.posicao)->getId())][recurso].erase(indiceLocal);
+		raios[recurso].erase(raios[recurso].find(atual.distancia));
+	}
+	else
+		descobertos[recurso].erase(indiceLocal);
+
+	atual.posicao = posicao;
+	atual.distancia = (posicao < ranking.size() ? OtimizadorDespacho::distancia(ranking.at(posicao), locais->at(indiceLocal)) : std::numeric_limits<double>::infinity());
+	if (posicao < ranking.size()){
+		cobertos[indicesPostos.at(ranking.at(posicao)->getId())][recurso].insert(indiceLocal);
+		raios[recurso].insert(atual.distancia);
+	}
+	else
+		descobertos[recurso].insert(indiceLocal);
+}
+
+void MapaCobertura::procurar(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, unsigned int inicio){
+	const std::vector<Posto*> &ranking = rankings->at(indiceLocal);
+	unsigned int posicao = inicio;
+	while (posicao < ranking.size() && !disponivel[indicesPostos.at(ranking.at(posicao)->getId())][recurso])
+		posicao++;
+	cobrir(indiceLocal, recurso, posicao);
+}
+
+void MapaCobertura::atualizar(const Posto* posto){
+	std::map<unsigned int, unsigned int>::const_iterator it = indicesPostos.find(posto->getId());
+	if (it == indicesPostos.end())
+		return;
+	unsigned int p = it->second;
+
+	for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+		ResultadoDespacho::TipoRecurso recurso = (ResultadoDespacho::TipoRecurso)r;
+		if (!recursoCoberto(recurso))
+			continue;
+
+		// Na maioria das alteracoes o posto continua com (ou sem) oferta e nada muda
+		bool agora = (OtimizadorDespacho::getOferta(posto, recurso) > 0);
+		if (agora == disponivel[p][r])
+			continue;
+		disponivel[p][r] = agora;
+
+		if (!agora){
+			// Os locais que este posto cobria passam para o posto disponivel seguinte no seu ranking
+			std::set<unsigned int> afetados = cobertos[p][r];
+			for (std::set<unsigned int>::const_iterator l = afetados.begin() ; l != afetados.end() ; l++){
+				procurar(*l, recurso, cobertura[*l][r].posicao + 1);
+			}
+		}
+		else{
+			// Os locais sem nenhum posto com oferta passam todos a ser cobertos por este
+			std::set<unsigned int> afetados = descobertos[r];
+			for (std::set<unsigned int>::const_iterator l = afetados.begin() ; l != afetados.end() ; l++){
+				if (posicoes[*l][p] < cobertura[*l][r].posicao)
+					cobrir(*l, recurso, posicoes[*l][p]);
+			}
+
+			// Dos restantes, so os locais mais perto deste posto do que o maior raio de cobertura (finito) podem passar a ser cobertos por ele
+			if (raios[r].empty())
+				continue;
+			double maiorRaio = *raios[r].rbegin();
+			for (unsigned int i=0 ; i<vizinhos[p].size() && vizinhos[p][i].first <= maiorRaio ; i++){
+				unsigned int l = vizinhos[p][i].second;
+				if (posicoes[l][p] < cobertura[l][r].posicao)
+					cobrir(l, recurso, posicoes[l][p]);
+			}
+		}
+	}
+}
+
+const Posto* MapaCobertura::getMaisProximo(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso) const{
+	if (!recursoCoberto(recurso))
+		return NULL;
+	unsigned int posicao = cobertura.at(indiceLocal).at(recurso).posicao;
+	return (posicao < rankings->at(indiceLocal).size() ? rankings->at(indiceLocal).at(posicao) : NULL);
+}
+
+double MapaCobertura::getDistancia(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso) const{
+	if (!recursoCoberto(recurso))
+		return std::numeric_limits<double>::infinity();
+	return cobertura.at(indiceLocal).at(recurso).distancia;
+}
+
+bool MapaCobertura::estaCoberto(unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, double distanciaMaxima) const{
+	return getDistancia(indiceLocal, recurso) <= distanciaMaxima;
+}
+
+std::vector<unsigned int> MapaCobertura::getLocaisDescobertos(ResultadoDespacho::TipoRecurso recurso, double distanciaMaxima) const{
+	std::vector<unsigned int> descobertos;
+	for (unsigned int l=0 ; l<cobertura.size() ; l++){
+		if (!estaCoberto(l, recurso, distanciaMaxima))
+			descobertos.push_back(l);
+	}
+	return descobertos;
+}
@@ -0,0 +1,9 @@
+#include "MeiosPostos.h"
+
+unsigned int MeiosReais::getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const{
+	return posto->getOferta(recurso);
+}
+
+bool MeiosReais::reservar(Posto* posto, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas){
+	return posto->reservar(recurso, veiculos, socorristas);
+}
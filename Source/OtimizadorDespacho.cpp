@@ -0,0 +1,212 @@
+#include "OtimizadorDespacho.h"
+#include <cmath>
+#include <algorithm>
+#include "EmparelhadorMeios.h"
+
+OtimizadorDespacho::OtimizadorDespacho(const std::vector<Posto*> &postos) : postos(postos), distanciaTotal(0), distanciaGulosa(0) {}
+
+unsigned int OtimizadorDespacho::getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso){
+	return posto->getOferta(recurso);
+}
+
+unsigned int OtimizadorDespacho::getTripulacao(const Posto* posto, ResultadoDespacho::TipoRecurso recurso){
+	return posto->getTripulacao(recurso);
+}
+
+std::string OtimizadorDespacho::getTipoVeiculos(const Posto* posto, ResultadoDespacho::TipoRecurso recurso){
+	return posto->getTipoVeiculos(recurso);
+}
+
+unsigned int OtimizadorDespacho::getProcura(const Acidente* acidente, ResultadoDespacho::TipoRecurso recurso){
+	// As necessidades de cada tipo de acidente estao num so sitio (ver NecessidadesAcidente)
+	Necessidade necessidades[Acidente::MAX_NECESSIDADES];
+	unsigned int numNecessidades = acidente->getNecessidades(necessidades);
+
+	unsigned int procura = 0;
+	for (unsigned int i=0 ; i<numNecessidades ; i++){
+		if (necessidades[i].recurso == recurso)
+			procura += necessidades[i].unidades;
+	}
+	return procura;
+}
+
+bool OtimizadorDespacho::atribuir(Posto* posto, Acidente* acidente, ResultadoDespacho::TipoRecurso recurso, unsigned int unidades){
+	// Veiculos e socorristas sao retirados de uma so vez: se o posto ja nao os tiver, nada e alterado
+	unsigned int tripulacao = getTripulacao(posto, recurso);
+	if (!posto->reservar(recurso, unidades, tripulacao * unidades))
+		return false;
+
+	// Uma unica atribuicao com todos os veiculos que saem deste posto para este acidente
+	acidente->addAtribuicao(Atribuicao(posto->getId(), tripulacao * unidades, unidades, getTipoVeiculos(posto, recurso)));
+	return true;
+}
+
+unsigned int OtimizadorDespacho::reservar(Posto* posto, Acidente* acidente, ResultadoDespacho::TipoRecurso recurso, unsigned int unidades){
+	// O mesmo ciclo do despacho guloso, so com este posto: as unidades sao reservadas de uma so vez
+	MeiosReais meios;
+	return EmparelhadorMeios::suprir(acidente, Necessidade(recurso, unidades), std::vector<Posto*>(1, posto), meios);
+}
+
+OtimizadorDespacho::Rede & OtimizadorDespacho::prepararRede(ResultadoDespacho::TipoRecurso recurso, const std::vector<unsigned int> &oferta){
+	Rede &rede = redes[recurso];
+
+	// Postos diferentes dos da rede: construir a parte fixa de novo (origem, destino e um no por posto)
+	if (rede.postos != postos){
+		rede.postos = postos;
+		rede.fluxo = FluxoCustoMinimo();
+		rede.origem = rede.fluxo.adicionarNo();
+		rede.destino = rede.fluxo.adicionarNo();
+		rede.nosPostos.clear();
+		rede.arestasPostos.clear();
+		for (unsigned int p=0 ; p<postos.size() ; p++){
+			rede.nosPostos.push_back(rede.fluxo.adicionarNo());
+			rede.arestasPostos.push_back(rede.fluxo.adicionarAresta(rede.origem, rede.nosPostos.back(), oferta.at(p), 0));
+		}
+		rede.numNosFixos = rede.fluxo.getNumNos();
+		rede.numArestasFixas = rede.fluxo.getNumArestas();
+		return rede;
+	}
+
+	// Arranque a quente: os acidentes do lote anterior saem (o seu fluxo volta aos postos) e a oferta de cada posto passa a ser a atual
+	rede.fluxo.recuar(rede.numNosFixos, rede.numArestasFixas);
+	for (unsigned int p=0 ; p<postos.size() ; p++){
+		rede.fluxo.alterarCapacidade(rede.arestasPostos.at(p), oferta.at(p));
+	}
+	return rede;
+}
+
+void OtimizadorDespacho::completarGuloso(const std::vector< std::vector<unsigned int> > &ordem, std::vector<unsigned int> &oferta, std::vector<unsigned int> &falta, std::vector<Envio> &plano){
+	for (unsigned int a=0 ; a<ordem.size() ; a++){
+		for (unsigned int i=0 ; i<ordem[a].size() && falta[a]>0 ; i++){
+			unsigned int p = ordem[a][i];
+			unsigned int unidades = std::min(oferta[p], falta[a]);
+			if (unidades == 0)
+				continue;
+			Envio envio = { p, a, unidades };
+			plano.push_back(envio);
+			oferta[p] -= unidades;
+			falta[a] -= unidades;
+		}
+	}
+}
+
+void OtimizadorDespacho::resolverRecurso(const std::vector<Acidente*> &acidentes, ResultadoDespacho::TipoRecurso recurso){
+	std::vector<unsigned int> oferta(postos.size());
+	std::vector<unsigned int> procura(acidentes.size());
+	long long ofertaTotal = 0, procuraTotal = 0;
+	for (unsigned int p=0 ; p<postos.size() ; p++){
+		oferta[p] = getOferta(postos.at(p), recurso);
+		ofertaTotal += oferta[p];
+	}
+	for (unsigned int a=0 ; a<acidentes.size() ; a++){
+		procura[a] = getProcura(acidentes.at(a), recurso);
+		procuraTotal += procura[a];
+	}
+	if (ofertaTotal == 0 || procuraTotal == 0)
+		return;
+
+	// Para cada acidente, os postos com unidades deste recurso por ordem crescente de distancia
+	std::vector< std::vector<double> > distancias(acidentes.size());
+	std::vector< std::vector<unsigned int> > ordem(acidentes.size());
+	for (unsigned int a=0 ; a<acidentes.size() ; a++){
+		if (procura[a] == 0)
+			continue;
+		distancias[a].resize(postos.size());
+		for (unsigned int p=0 ; p<postos.size() ; p++){
+			if (oferta[p] == 0)
+				continue;
+			distancias[a][p] = distancia(postos.at(p), acidentes.at(a));
+			ordem[a].push_back(p);
+		}
+		const std::vector<double> &dist = distancias[a];
+		std::stable_sort(ordem[a].begin(), ordem[a].end(), [&dist](unsigned int p1, unsigned int p2){ return dist[p1] < dist[p2]; });
+	}
+
+	// Rede do lote: origem -> posto (oferta), posto -> acidente so para os postos mais proximos (custo igual a distancia), acidente -> destino (procura)
+	Rede &rede = prepararRede(recurso, oferta);
+	std::vector<Envio> ligacoes;
+	std::vector<unsigned int> arestasLigacoes;
+	for (unsigned int a=0 ; a<acidentes.size() ; a++){
+		if (procura[a] == 0)
+			continue;
+		unsigned int noAcidente = rede.fluxo.adicionarNo();
+		rede.fluxo.adicionarAresta(noAcidente, rede.destino, procura[a], 0);
+		for (unsigned int i=0 ; i<ordem[a].size() && i<MAX_POSTOS_ACIDENTE ; i++){
+			unsigned int p = ordem[a][i];
+			long long custo = llround(distancias[a][p] * ESCALA_CUSTO);
+			Envio ligacao = { p, a, 0 };
+			ligacoes.push_back(ligacao);
+			arestasLigacoes.push_back(rede.fluxo.adicionarAresta(rede.nosPostos.at(p), noAcidente, std::min(procura[a], oferta[p]), custo));
+		}
+	}
+
+	// Pedir toda a procura: se nao houver unidades para tudo, fica o fluxo maximo de custo minimo (o excesso que resta na origem nao e atribuido)
+	rede.fluxo.definirOferta(rede.origem, procuraTotal);
+	rede.fluxo.definirOferta(rede.destino, -procuraTotal);
+	rede.fluxo.resolver();
+
+	std::vector<Envio> planoFluxo;
+	std::vector<unsigned int> ofertaFluxo = oferta, faltaFluxo = procura;
+	for (unsigned int i=0 ; i<ligacoes.size() ; i++){
+		long long fluxo = rede.fluxo.getFluxo(arestasLigacoes[i]);
+		if (fluxo <= 0)
+			continue;
+		Envio envio = ligacoes[i];
+		envio.unidades = fluxo;
+		planoFluxo.push_back(envio);
+		ofertaFluxo[envio.posto] -= envio.unidades;
+		faltaFluxo[envio.acidente] -= envio.unidades;
+	}
+	// O que os postos mais proximos nao chegaram para dar e completado pelos seguintes
+	completarGuloso(ordem, ofertaFluxo, faltaFluxo, planoFluxo);
+
+	std::vector<Envio> planoGuloso;
+	std::vector<unsigned int> ofertaGulosa = oferta, faltaGulosa = procura;
+	completarGuloso(ordem, ofertaGulosa, faltaGulosa, planoGuloso);
+
+	// Comparar os dois planos: mais unidades servidas e, com as mesmas unidades, menor distancia
+	long long unidadesFluxo = 0, unidadesGulosas = 0;
+	double distanciaFluxo = 0, distanciaPlanoGuloso = 0;
+	for (unsigned int i=0 ; i<planoFluxo.size() ; i++){
+		unidadesFluxo += planoFluxo[i].unidades;
+		distanciaFluxo += planoFluxo[i].unidades * distancias[planoFluxo[i].acidente][planoFluxo[i].posto];
+	}
+	for (unsigned int i=0 ; i<planoGuloso.size() ; i++){
+		unidadesGulosas += planoGuloso[i].unidades;
+		distanciaPlanoGuloso += planoGuloso[i].unidades * distancias[planoGuloso[i].acidente][planoGuloso[i].posto];
+	}
+	distanciaGulosa += distanciaPlanoGuloso;
+	bool fluxoMelhor = (unidadesFluxo > unidadesGulosas || (unidadesFluxo == unidadesGulosas && distanciaFluxo <= distanciaPlanoGuloso));
+	const std::vector<Envio> &plano = (fluxoMelhor ? planoFluxo : planoGuloso);
+
+	for (unsigned int i=0 ; i<plano.size() ; i++){
+		if (!atribuir(postos.at(plano[i].posto), acidentes.at(plano[i].acidente), recurso, plano[i].unidades))
+			continue;
+		distanciaTotal += plano[i].unidades * distancias[plano[i].acidente][plano[i].posto];
+	}
+}
+
+void OtimizadorDespacho::otimizar(const std::vector<Acidente*> &acidentes){
+	// Os autotanques primeiro: as ambulancias dos bombeiros so podem sair com os bombeiros que sobrarem
+	resolverRecurso(acidentes, ResultadoDespacho::AUTOTANQUES);
+	resolverRecurso(acidentes, ResultadoDespacho::EQUIPAS_POLICIAIS);
+	resolverRecurso(acidentes, ResultadoDespacho::EQUIPAS_MEDICAS);
+}
+
+double OtimizadorDespacho::getDistanciaTotal() const{
+	return distanciaTotal;
+}
+
+double OtimizadorDespacho::getDistanciaGulosa() const{
+	return distanciaGulosa;
+}
+
+double OtimizadorDespacho::distancia(const Posto* posto, const Acidente* acidente){
+	return distancia(posto, *acidente->getLocal());
+}
+
+double OtimizadorDespacho::distancia(const Posto* posto, const Local &local){
+	double vecX = (double)local.getXcoord() - posto->getLocal()->getXcoord();
+	double vecY = (double)local.getYcoord() - posto->getLocal()->getYcoord();
+	return sqrt(vecX*vecX + vecY*vecY);
+}
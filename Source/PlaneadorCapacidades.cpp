@@ -0,0 +1,142 @@
+#include "PlaneadorCapacidades.h"
+#include <algorithm>
+#include <cmath>
+#include "PoolTrabalho.h"
+
+/**
+ * @brief Permite obter um percentil de valores já ordenados (método do posto mais próximo)
+ * @param ordenados - Valores por ordem crescente
+ * @param percentil - Percentil (0 a 100)
+ * @return Retorna o percentil, ou 0 caso não haja valores
+ */
+static double getPercentil(const std::vector<double> &ordenados, double percentil){
+	if (ordenados.empty())
+		return 0;
+	unsigned int posicao = (unsigned int)ceil(percentil / 100 * ordenados.size());
+	return ordenados.at(posicao == 0 ? 0 : posicao - 1);
+}
+
+PlaneadorCapacidades::Resumo::Resumo() : media(0), desvio(0), minimo(0), maximo(0) {}
+
+PlaneadorCapacidades::ResultadoSimulacao::ResultadoSimulacao() : numAcidentes(0), numCompletos(0), numParciais(0), numSemMeios(0), unidadesAtribuidas(0), unidadesEmFalta(0),
+		distanciaP50(0), distanciaP90(0), distanciaP99(0) {}
+
+double PlaneadorCapacidades::ResultadoSimulacao::getTaxaUnidadesEmFalta() const{
+	unsigned int necessarias = unidadesAtribuidas + unidadesEmFalta;
+	return (necessarias == 0 ? 0 : (double)unidadesEmFalta / necessarias);
+}
+
+double PlaneadorCapacidades::ResultadoSimulacao::getTaxaNaoCompletos() const{
+	return (numAcidentes == 0 ? 0 : (double)(numParciais + numSemMeios) / numAcidentes);
+}
+
+PlaneadorCapacidades::PlaneadorCapacidades(const ProtecaoCivil &protecaoCivil, const SimuladorEventos::Parametros &parametros, double duracao, double acidentesPorDia)
+	: protecaoCivil(protecaoCivil), parametros(parametros), duracao(duracao), acidentesPorDia(acidentesPorDia) {}
+
+PlaneadorCapacidades::ResultadoSimulacao PlaneadorCapacidades::simular(const TabelaCapacidades &capacidades, unsigned int semente) const{
+	ResultadoSimulacao resultado;
+
+	// O simulador copia o instantaneo: so as paginas alteradas por esta simulacao sao copiadas
+	SimuladorEventos simulador(protecaoCivil, capacidades, parametros);
+	simulador.gerarAcidentes(duracao, acidentesPorDia, semente);
+
+	// A utilizacao so conta dentro do periodo simulado; depois, os acidentes ainda em curso terminam (e os meios regressam)
+	simulador.executar(duracao);
+	std::map<unsigned int, double> veiculosMinutos = simulador.getVeiculosMinutosPostos();
+	simulador.executar();
+
+	const SimuladorEventos::Estatisticas &estatisticas = simulador.getEstatisticas();
+	resultado.numAcidentes = estatisticas.numAcidentes;
+	resultado.numCompletos = estatisticas.numCompletos;
+	resultado.numParciais = estatisticas.numParciais;
+	resultado.numSemMeios = estatisticas.numSemMeios;
+	resultado.unidadesAtribuidas = estatisticas.unidadesAtribuidas;
+	resultado.unidadesEmFalta = estatisticas.unidadesEmFalta;
+
+	// O primeiro meio a chegar e o mais proximo: a sua distancia e o tempo de resposta pela velocidade
+	std::vector<double> distancias(estatisticas.temposResposta);
+	for (unsigned int i=0 ; i<distancias.size() ; i++){
+		distancias[i] *= parametros.velocidade;
+	}
+	std::sort(distancias.begin(), distancias.end());
+	resultado.distanciaP50 = getPercentil(distancias, 50);
+	resultado.distanciaP90 = getPercentil(distancias, 90);
+	resultado.distanciaP99 = getPercentil(distancias, 99);
+
+	// Utilizacao: veiculos x minutos fora, sobre os veiculos do posto x duracao da simulacao
+	std::vector<unsigned int> ids = capacidades.getIdsPostos();
+	for (unsigned int i=0 ; i<ids.size() ; i++){
+		const TabelaCapacidades::Capacidade &capacidade = capacidades.getCapacidade(protecaoCivil.getPosto(ids.at(i)));
+		unsigned int veiculos = 0;
+		for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+			veiculos += capacidade.veiculos[r];
+		}
+		if (veiculos == 0 || duracao <= 0)
+			continue;
+		std::map<unsigned int, double>::const_iterator it = veiculosMinutos.find(ids.at(i));
+		resultado.utilizacaoPostos[ids.at(i)] = (it == veiculosMinutos.end() ? 0 : it->second / (veiculos * duracao));
+	}
+
+	return resultado;
+}
+
+PlaneadorCapacidades::Resumo PlaneadorCapacidades::resumir(const std::vector<double> &valores){
+	Resumo resumo;
+	if (valores.empty())
+		return resumo;
+
+	resumo.minimo = resumo.maximo = valores.at(0);
+	double soma = 0;
+	for (unsigned int i=0 ; i<valores.size() ; i++){
+		soma += valores.at(i);
+		resumo.minimo = std::min(resumo.minimo, valores.at(i));
+		resumo.maximo = std::max(resumo.maximo, valores.at(i));
+	}
+	resumo.media = soma / valores.size();
+
+	if (valores.size() > 1){
+		double quadrados = 0;
+		for (unsigned int i=0 ; i<valores.size() ; i++){
+			quadrados += (valores.at(i) - resumo.media) * (valores.at(i) - resumo.media);
+		}
+		resumo.desvio = sqrt(quadrados / (valores.size() - 1));
+	}
+	return resumo;
+}
+
+PlaneadorCapacidades::Resultado PlaneadorCapacidades::executar(const TabelaCapacidades &capacidades, unsigned int numSimulacoes, unsigned int semente, unsigned int numThreads) const{
+	Resultado resultado;
+	resultado.simulacoes.resize(numSimulacoes);
+
+	// Cada simulacao escreve apenas na sua posicao do vetor de resultados
+	PoolTrabalho pool(numThreads);
+	pool.executar(numSimulacoes, [&](unsigned int indice){
+		resultado.simulacoes[indice] = simular(capacidades, semente + indice);
+	});
+
+	// Agregar pela ordem das sementes (o resultado nao depende da ordem de execucao)
+	std::vector<double> taxaUnidades, taxaAcidentes, p50, p90, p99;
+	std::map<unsigned int, std::vector<double> > utilizacao;
+	for (unsigned int i=0 ; i<numSimulacoes ; i++){
+		const ResultadoSimulacao &simulacao = resultado.simulacoes.at(i);
+		taxaUnidades.push_back(simulacao.getTaxaUnidadesEmFalta());
+		taxaAcidentes.push_back(simulacao.getTaxaNaoCompletos());
+		p50.push_back(simulacao.distanciaP50);
+		p90.push_back(simulacao.distanciaP90);
+		p99.push_back(simulacao.distanciaP99);
+		for (std::map<unsigned int, double>::const_iterator it = simulacao.utilizacaoPostos.begin() ; it != simulacao.utilizacaoPostos.end() ; it++){
+			utilizacao[it->first].push_back(it->second);
+		}
+	}
+
+	resultado.taxaUnidadesEmFalta = resumir(taxaUnidades);
+	resultado.taxaNaoCompletos = resumir(taxaAcidentes);
+	resultado.distanciaP50 = resumir(p50);
+	resultado.distanciaP90 = resumir(p90);
+	resultado.distanciaP99 = resumir(p99);
+	for (std::map<unsigned int, std::vector<double> >::const_iterator it = utilizacao.begin() ; it != utilizacao.end() ; it++){
+		resultado.utilizacaoPostos[it->first] = resumir(it->second);
+	}
+
+	return resultado;
+}
@@ -1,7 +1,10 @@
 #include "Policia.h"
 
 Policia::Policia(const unsigned int id, const Local* local, unsigned int numSocorristas, unsigned int numVeiculos, const std::string &tipoVeiculo)
-	: Posto(id,local,numSocorristas,numVeiculos) , tipoVeiculo(tipoVeiculo) {}
+	: Posto(id,local,numSocorristas,numVeiculos) , tipoVeiculo(tipoVeiculo) {
+	tripulacoes[ResultadoDespacho::EQUIPAS_POLICIAIS] = (tipoVeiculo == "Moto" ? 1 : 2);	// Cada moto leva 1 policia, cada carro leva 2
+	contadoresVeiculos[ResultadoDespacho::EQUIPAS_POLICIAIS] = &this->numVeiculos;
+}
 
 
 Policia::~Policia() {
@@ -16,6 +19,10 @@ std::string Policia::getTipoPosto() const{
 	return "Policia";
 }
 
+std::string Policia::getTipoVeiculos(ResultadoDespacho::TipoRecurso) const{
+	return tipoVeiculo;
+}
+
 void Policia::printInfoPosto() const{
 	std::cout << "***  POLICIA  ***" << std::endl;
 	std::cout << "Localidade: " << local->getNome() << std::endl;
@@ -25,6 +32,6 @@ void Policia::printInfoPosto() const{
 	std::cout << "Tipo de Veiculo usado: " << tipoVeiculo << std::endl;
 }
 
-void Policia::printSimplifiedInfo(std::ostream & os) const{
-	os << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Policia/" << tipoVeiculo;
+void Policia::serializar(BufferEscrita & buf) const{
+	buf << id << '/' << local->getNome() << '/' << numSocorristas << '/' << numVeiculos << "/Policia/" << tipoVeiculo;
 }
@@ -0,0 +1,68 @@
+#include "PoolTrabalho.h"
+#include <thread>
+#include <algorithm>
+
+PoolTrabalho::PoolTrabalho(unsigned int numThreads) : numThreads(numThreads), numRoubos(0) {
+	if (this->numThreads == 0)
+		this->numThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+bool PoolTrabalho::obterTarefa(std::vector< std::unique_ptr<Fila> > &filas, unsigned int propria, unsigned int &tarefa){
+	// As tarefas mais recentes da propria fila primeiro
+	{
+		std::lock_guard<std::mutex> trinco(filas.at(propria)->trinco);
+		if (!filas.at(propria)->tarefas.empty()){
+			tarefa = filas.at(propria)->tarefas.back();
+			filas.at(propria)->tarefas.pop_back();
+			return true;
+		}
+	}
+
+	// Roubar a tarefa mais antiga das outras filas, a comecar pela seguinte
+	for (unsigned int i=1 ; i<filas.size() ; i++){
+		Fila &vitima = *filas.at((propria + i) % filas.size());
+		std::lock_guard<std::mutex> trinco(vitima.trinco);
+		if (!vitima.tarefas.empty()){
+			tarefa = vitima.tarefas.front();
+			vitima.tarefas.pop_front();
+			numRoubos++;
+			return true;
+		}
+	}
+	return false;	// As tarefas nunca voltam a entrar nas filas: se todas estao vazias, ja nao ha trabalho
+}
+
+void PoolTrabalho::executar(unsigned int numTarefas, const std::function<void(unsigned int)> &tarefa){
+	numRoubos = 0;
+	unsigned int threads = std::min(numThreads, std::max(1u, numTarefas));
+
+	// Distribuir as tarefas pelas filas em blocos contiguos
+	std::vector< std::unique_ptr<Fila> > filas;
+	for (unsigned int t=0 ; t<threads ; t++){
+		filas.push_back(std::unique_ptr<Fila>(new Fila()));
+		for (unsigned int i = (unsigned long long)numTarefas * t / threads ; i < (unsigned long long)numTarefas * (t + 1) / threads ; i++){
+			filas.back()->tarefas.push_back(i);
+		}
+	}
+
+	std::vector<std::thread> trabalhadores;
+	for (unsigned int t=0 ; t<threads ; t++){
+		trabalhadores.push_back(std::thread([this, &filas, &tarefa, t](){
+			unsigned int indice;
+			while (obterTarefa(filas, t, indice)){
+				tarefa(indice);
+			}
+		}));
+	}
+	for (unsigned int t=0 ; t<trabalhadores.size() ; t++){
+		trabalhadores.at(t).join();
+	}
+}
+
+unsigned int PoolTrabalho::getNumThreads() const{
+	return numThreads;
+}
+
+unsigned int PoolTrabalho::getNumRoubos() const{
+	return numRoubos;
+}
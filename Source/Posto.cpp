@@ -1,7 +1,12 @@
 #include "Posto.h"
 
 Posto::Posto(const unsigned int id, const Local* local, unsigned int numSocorristas, unsigned int numVeiculos)
-	: id(id) , local(local) , numSocorristas(numSocorristas) , numVeiculos(numVeiculos) {}
+	: id(id) , local(local) , numSocorristas(numSocorristas) , numVeiculos(numVeiculos) {
+	for (unsigned int i=0 ; i<ResultadoDespacho::NUM_RECURSOS ; i++){
+		tripulacoes[i] = 0;	// As classes derivadas indicam os recursos que fornecem
+		contadoresVeiculos[i] = NULL;
+	}
+}
 
 Posto::~Posto() {
 	// TODO Auto-generated destructor stub
@@ -15,23 +20,35 @@ void Posto::addSocorristas(unsigned int num){
 	numSocorristas += num;
 }
 
-bool Posto::rmVeiculos(unsigned int num){
-	if (numVeiculos >= num){	// Ha veiculos suficientes para poder remover "num" veiculos.
-		numVeiculos -= num;
-		return true;
-	}
-	else					// Nao ha veiculos suficientes para poder remover "num" veiculos.
+bool Posto::retirar(std::atomic<unsigned int> &contador, unsigned int num){
+	unsigned int atual = contador.load();
+	do {
+		if (atual < num)	// Nao ha meios suficientes para poder remover "num" meios.
+			return false;
+	} while (!contador.compare_exchange_weak(atual, atual - num));	// Outro despachante alterou o contador entretanto: tentar de novo com o valor atual
+	return true;
+}
+
+bool Posto::reservar(std::atomic<unsigned int> &veiculos, unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas){
+	if (!retirar(numSocorristas, quantidadeSocorristas))
 		return false;
+	if (!retirar(veiculos, quantidadeVeiculos)){
+		numSocorristas += quantidadeSocorristas;	// Nao ha veiculos: desfazer a reserva dos socorristas
+		return false;
+	}
+	return true;
+}
+
+bool Posto::rmVeiculos(unsigned int num){
+	return retirar(numVeiculos, num);
 }
 
 bool Posto::rmSocorristas(unsigned int num){
+	return retirar(numSocorristas, num);
+}
 
-	if (numSocorristas >= num){	// Ha socorristas suficientes para poder remover "num" socorristas.
-		numSocorristas -= num;
-		return true;
-	}
-	else					// Nao ha socorristas suficientes para poder remover "num" socorristas.
-		return false;
+bool Posto::reservar(unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas){
+	return reservar(numVeiculos, quantidadeVeiculos, quantidadeSocorristas);
 }
 
 unsigned int Posto::getNumVeiculos() const{
@@ -42,6 +59,38 @@ unsigned int Posto::getNumSocorristas() const{
 	return numSocorristas;
 }
 
+unsigned int Posto::getTripulacao(ResultadoDespacho::TipoRecurso recurso) const{
+	return tripulacoes[recurso];
+}
+
+unsigned int Posto::getVeiculos(ResultadoDespacho::TipoRecurso recurso) const{
+	return (contadoresVeiculos[recurso] != NULL ? contadoresVeiculos[recurso]->load() : 0);
+}
+
+unsigned int Posto::getOferta(ResultadoDespacho::TipoRecurso recurso) const{
+	if (tripulacoes[recurso] == 0)
+		return 0;
+
+	// Um veiculo so pode sair com a sua equipa completa
+	unsigned int veiculos = contadoresVeiculos[recurso]->load();
+	unsigned int equipas = numSocorristas.load() / tripulacoes[recurso];
+	return (veiculos < equipas ? veiculos : equipas);
+}
+
+bool Posto::reservar(ResultadoDespacho::TipoRecurso recurso, unsigned int quantidadeVeiculos, unsigned int quantidadeSocorristas){
+	if (contadoresVeiculos[recurso] == NULL)
+		return false;
+	return reservar(*contadoresVeiculos[recurso], quantidadeVeiculos, quantidadeSocorristas);
+}
+
+ResultadoDespacho::TipoRecurso Posto::getRecurso(const std::string &tipoVeiculos) const{
+	for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+		if (contadoresVeiculos[r] != NULL && getTipoVeiculos((ResultadoDespacho::TipoRecurso)r) == tipoVeiculos)
+			return (ResultadoDespacho::TipoRecurso)r;
+	}
+	return ResultadoDespacho::NUM_RECURSOS;
+}
+
 const Local* Posto::getLocal() const{
 	return local;
 }
@@ -49,3 +98,8 @@ const Local* Posto::getLocal() const{
 const unsigned int Posto::getId() const{
 	return id;
 }
+
+void Posto::printSimplifiedInfo(std::ostream & os) const{
+	BufferEscrita buf(os, 256);
+	serializar(buf);
+}
@@ -1,21 +1,23 @@
 #include "ProtecaoCivil.h"
+#include "RebalanceadorFrota.h"
 
-ProtecaoCivil::ProtecaoCivil(const std::string &ficheiroPostos, const std::string &ficheiroAcidentes, const std::string &ficheiroLocais)
-	: ficheiroPostos(ficheiroPostos) , ficheiroAcidentes(ficheiroAcidentes) , ficheiroLocais(ficheiroLocais) {}
+const unsigned int ProtecaoCivil::INTERVALO_CHECKPOINT;
 
-void ProtecaoCivil::openFiles(){
-	std::ifstream istr;
-
-	////////////////////////////
-	// Ler ficheiro de locais //
-	////////////////////////////
+ProtecaoCivil::ProtecaoCivil(const std::string &ficheiroPostos, const std::string &ficheiroAcidentes, const std::string &ficheiroLocais, EscritorPersistencia::ModoDurabilidade modoDurabilidade,
+		ArquivoAcidentes::ModoVerificacao modoVerificacao)
+	: ficheiroPostos(ficheiroPostos) , ficheiroAcidentes(ficheiroAcidentes) , ficheiroLocais(ficheiroLocais) ,
+	  ficheiroDiario(ficheiroAcidentes + ".diario") , modoDurabilidade(modoDurabilidade) ,
+	  arquivo(ficheiroAcidentes, modoVerificacao) , assinaturaBase(0) , numSegmentos(0) , seqDiario(0) , otimizador(postos) , rebalanceador(NULL) , ultimoCheckpoint(std::chrono::steady_clock::now()) {}
 
+std::vector<Local> ProtecaoCivil::lerLocais(const std::string &ficheiroLocais){
+	std::ifstream istr;
 	istr.open(ficheiroLocais);
 
 	if(!istr.is_open())	// ficheiro nao foi aberto com sucesso
 		throw FicheiroNaoEncontrado("Falha ao abrir o ficheiro \"" + ficheiroLocais + "\" no construtor de ProtecaoCivil.");
 
 	// Preencher o vetor de locais com o conteudo do ficheiro
+	std::vector<Local> locais;
 	std::string line, nomeLocal;
 	unsigned int x_coord, y_coord;
 	int dashIndex;
@@ -39,229 +41,325 @@ void ProtecaoCivil::openFiles(){
 	}
 	istr.close();	// Fechar a stream
 
-	////////////////////////////
-	// Ler ficheiro de postos //
-	////////////////////////////
+	return locais;
+}
 
+std::vector<DescritorPosto> ProtecaoCivil::lerPostos(const std::string &ficheiroPostos){
+	std::ifstream istr;
 	istr.open(ficheiroPostos);
 
 	if(!istr.is_open())	// ficheiro nao foi aberto com sucesso
 		throw FicheiroNaoEncontrado("Falha ao abrir o ficheiro \"" + ficheiroPostos + "\" no construtor de ProtecaoCivil.");
 
-	// Preencher o vetor de postos com o conteudo do ficheiro
-	std::string tipoPosto, tipoVeiculo;
-	unsigned int numSocorristas, numVeiculos, numAutotanques, numAmbulancias, id;
-	int indexLocal;
+	// Ler a descricao de cada posto, sem resolver ainda o seu local
+	std::vector<DescritorPosto> descritores;
+	std::string line;
 	while(getline(istr,line)){
-		// obter o id do local
-		dashIndex = line.find_first_of('/');
-		id = std::stoi(line.substr(0,dashIndex));
-		line.erase(0,dashIndex+1);
+		descritores.push_back(DescritorPosto::ler(line));
+	}
+	istr.close();
 
-		// obter nome do local
-		dashIndex = line.find_first_of('/');
-		nomeLocal = line.substr(0,dashIndex);
-		line.erase(0,dashIndex+1);
+	return descritores;
+}
 
-		// obter indice do local no vetor
-		indexLocal = findLocal(nomeLocal);
-		if(indexLocal == -1){		// Este local nao foi encontrado no vetor de locais da protecao civil
-			throw LocalidadeInexistente("O local \"" + nomeLocal + "\" nao foi encontrado no vetor de locais da Protecao Civil, no construtor de ProtecaoCivil.");
-		}
+void ProtecaoCivil::openFiles(){
+	/////////////////////////////////////
+	// Ler os tres ficheiros em paralelo //
+	/////////////////////////////////////
+
+	// Nenhum dos ficheiros depende dos outros para ser lido: apenas a resolucao dos nomes dos locais depende do ficheiro de locais
+	std::future< std::vector<Local> > futuroLocais = std::async(std::launch::async, lerLocais, ficheiroLocais);
+	std::future< std::vector<DescritorPosto> > futuroPostos = std::async(std::launch::async, lerPostos, ficheiroPostos);
+	std::future< std::vector<DescritorAcidente> > futuroAcidentes = std::async(std::launch::async, LeitorAcidentes::lerFicheiro, ficheiroAcidentes, 0, &assinaturaBase, true);
+
+	////////////////////////////////////
+	// Resolver os locais pelo seu nome //
+	////////////////////////////////////
+
+	locais = futuroLocais.get();
+	for (unsigned int i=0 ; i<locais.size() ; i++){
+		indiceLocais[locais.at(i).getNome()] = i;
+	}
 
-		// obter num. de socorristas
-		dashIndex = line.find_first_of('/');
-		numSocorristas = std::stoi(line.substr(0,dashIndex));
-		line.erase(0,dashIndex+1);
+	std::vector<DescritorPosto> descritoresPostos = futuroPostos.get();
+	std::vector<DescritorAcidente> descritoresAcidentes = futuroAcidentes.get();
 
-		// obter num. de veiculos
-		dashIndex = line.find_first_of('/');
-		numVeiculos = std::stoi(line.substr(0,dashIndex));
-		line.erase(0,dashIndex+1);
+	// Os acidentes da base sao numerados sequencialmente, pela ordem do ficheiro
+	std::vector<unsigned int> numerosAcidentes(descritoresAcidentes.size());
+	for (unsigned int i=0 ; i<numerosAcidentes.size() ; i++){
+		numerosAcidentes[i] = i+1;
+	}
 
-		// obter tipo de posto
-		dashIndex = line.find_first_of('/');
-		tipoPosto = line.substr(0,dashIndex);
-		line.erase(0,dashIndex+1);
+	// Recuperar as alteracoes gravadas em checkpoints incrementais e no diario desde a ultima gravacao completa
+	arquivo.abrir();
+	std::set<unsigned int> abertosDiario;
+	recuperar(descritoresPostos, descritoresAcidentes, numerosAcidentes, abertosDiario);
 
-		if(tipoPosto == "Policia"){
-			// obter tipo de veiculo
-			tipoVeiculo = line;
+	postos.reserve(descritoresPostos.size());
+	for (unsigned int i=0 ; i<descritoresPostos.size() ; i++){
+		int indexLocal = findLocal(descritoresPostos.at(i).nomeLocal);
+		if(indexLocal == -1){		// Este local nao foi encontrado no vetor de locais da protecao civil
+			throw LocalidadeInexistente("O local \"" + descritoresPostos.at(i).nomeLocal + "\" nao foi encontrado no vetor de locais da Protecao Civil, no construtor de ProtecaoCivil.");
+		}
+		postos.push_back(descritoresPostos.at(i).criarPosto(&locais.at(indexLocal)));
+	}
 
-			postos.push_back(new Policia(id,&locais.at(indexLocal),numSocorristas,numVeiculos,tipoVeiculo));
+	// Criar os acidentes pela ordem do ficheiro (seguidos dos acidentes declarados nos segmentos e no diario)
+	acidentes.reserve(descritoresAcidentes.size());
+	for (unsigned int i=0 ; i<descritoresAcidentes.size() ; i++){
+		int indexLocal = findLocal(descritoresAcidentes.at(i).nomeLocal);
+		if(indexLocal == -1){		// Este local nao foi encontrado no vetor de locais da protecao civil
+			throw LocalidadeInexistente("O local \"" + descritoresAcidentes.at(i).nomeLocal + "\" nao foi encontrado no vetor de locais da Protecao Civil, no construtor de ProtecaoCivil.");
 		}
-		else if(tipoPosto == "Inem"){
-			// obter tipo de veiculo
-			tipoVeiculo = line;
+		acidentes.push_back(descritoresAcidentes.at(i).criarAcidente(&locais.at(indexLocal), numerosAcidentes.at(i)));
+	}
+
+	//////////////////////////////////////
+	// Construir os indices em paralelo //
+	//////////////////////////////////////
 
-			postos.push_back(new Inem(id,&locais.at(indexLocal),numSocorristas,numVeiculos,tipoVeiculo));
+	// O historico dos acidentes terminados em execucoes anteriores e reconstruido a partir do arquivo (incluindo os recuperados do diario) e indexado antes dos acidentes em decurso
+	std::thread threadIndiceAcidentes([this](){
+		carregarHistorico();
+		for (unsigned int i=0 ; i<acidentes.size() ; i++){
+			indiceAcidentes.adicionar(acidentes.at(i));
 		}
-		else {		// tipoPosto = Bombeiros
-			// obter num. de autotanques
-			dashIndex = line.find_first_of('/');
-			numAutotanques = std::stoi(line.substr(0,dashIndex));
-			line.erase(0,dashIndex+1);
+	});
+	std::thread threadRankings(&ProtecaoCivil::construirRankingsPostos, this);
 
-			// obter num. de ambulancias
-			numAmbulancias = std::stoi(line);
+	for (unsigned int i=0 ; i<postos.size() ; i++){
+		indicePostos[postos.at(i)->getId()] = postos.at(i);
+	}
+
+	threadIndiceAcidentes.join();
+	threadRankings.join();
+	particionarRegioes(LADO_REGIOES);
+	cobertura.construir(locais, postos, rankingsPostos);
+
+	// Os acidentes a que faltam meios ficam a espera que estes sejam retornados
+	for (unsigned int i=0 ; i<acidentes.size() ; i++){
+		atualizarPendente(acidentes.at(i));
+	}
 
-			postos.push_back(new Bombeiros(id,&locais.at(indexLocal),numSocorristas,numAutotanques,numAmbulancias));
+	// As alteracoes recuperadas do diario sao gravadas num segmento antes de o diario ser reiniciado
+	if (!abertosDiario.empty()){
+		for (unsigned int i=0 ; i<acidentes.size() ; i++){
+			if (abertosDiario.count(acidentes.at(i)->getNumOcorrencia()))
+				acidentesAbertos[acidentes.at(i)->getNumOcorrencia()] = acidentes.at(i);
 		}
 	}
-	istr.close();
+	checkpoint();
 
-	///////////////////////////////
-	// Ler Ficheiro de Acidentes //
-	///////////////////////////////
+	// Os acidentes arquivados so sao lidos quando forem pedidos
+	leitorArquivo.reset(new LeitorArquivo(arquivo, locais, indiceLocais));
 
-	istr.open(ficheiroAcidentes);
+	// As alteracoes feitas a partir daqui sao enviadas para o diario, numa thread dedicada (com numeros de sequencia posteriores aos ja arquivados)
+	escritor.reset(new EscritorPersistencia(ficheiroDiario, modoDurabilidade, assinaturaBase, std::max(seqDiario, arquivo.getUltimoSeq())));
+}
 
-	if(!istr.is_open())	// ficheiro nao foi aberto com sucesso
-		throw FicheiroNaoEncontrado("Falha ao abrir o ficheiro \"" + ficheiroAcidentes + "\" no construtor de ProtecaoCivil.");
+void ProtecaoCivil::recuperar(std::vector<DescritorPosto> &descritoresPostos, std::vector<DescritorAcidente> &descritoresAcidentes, std::vector<unsigned int> &numerosAcidentes, std::set<unsigned int> &abertosDiario){
+	//////////////////////////////////////////////////////////
+	// Ler os segmentos, pela sua ordem, ate encontrar um que nao exista //
+	//////////////////////////////////////////////////////////
 
-	// Preencher o vetor de Acidentes com o conteúdo do ficheiro
-	std::string data, tipoAcidente, tipoIncendio, tipoCasa, tipoEstrada, atribuicao, tipoVeiculos;
-	unsigned int numAutotanquesNecess, numBombeirosNecess, areaChamas, numFeridos, numVeiculosEnvolvidos, numAtribuicoes;
-	bool haFeridos;
-	Acidente* acidente;
-	unsigned int numOcorrencia = 1;	// Sera incrementado sempre que um novo acidente for criado
+	std::vector<SegmentoCheckpoint> segmentos;
+	unsigned int numero = 1;
+	while (true){
+		SegmentoCheckpoint segmento;
+		std::string ficheiro = SegmentoCheckpoint::nomeFicheiro(ficheiroAcidentes, numero);
+		bool lido = SegmentoCheckpoint::ler(ficheiro, segmento);
 
-	while(getline(istr,line)){
-		// obter nome do local
-		dashIndex = line.find_first_of('/');
-		nomeLocal = line.substr(0,dashIndex);
-		line.erase(0,dashIndex+1);
+		if (!lido && !std::ifstream(ficheiro).is_open())
+			break;		// Nao ha mais segmentos
 
-		// obter indice do local no vetor
-		indexLocal = findLocal(nomeLocal);
-		if(indexLocal == -1){		// Este local nao foi encontrado no vetor de locais da protecao civil
-			throw LocalidadeInexistente("O local \"" + nomeLocal + "\" nao foi encontrado no vetor de locais da Protecao Civil, no construtor de ProtecaoCivil.");
+		// Um segmento incompleto, ou escrito sobre outra base (a gravacao completa terminou antes de os apagar), invalida os seguintes
+		if (!lido || segmento.assinaturaBase != assinaturaBase){
+			for (unsigned int i=numero ; std::remove(SegmentoCheckpoint::nomeFicheiro(ficheiroAcidentes, i).c_str()) == 0 ; i++);
+			break;
 		}
 
-		// obter a data
-		dashIndex = line.find_first_of('/');
-		data = line.substr(0,dashIndex);
-		line.erase(0,dashIndex+1);
+		segmentos.push_back(segmento);
+		numero++;
+	}
 
-		// obter o tipo de acidente
-		dashIndex = line.find_first_of('/');
-		tipoAcidente = line.substr(0,dashIndex);
-		line.erase(0,dashIndex+1);
+	numSegmentos = segmentos.size();
+	seqDiario = (segmentos.empty() ? 0 : segmentos.back().seqDiario);
 
-		// Incendios
-		if (tipoAcidente == "Incendio"){
-			// obter o numero de autotanques necessarios
-			dashIndex = line.find_first_of('/');
-			numAutotanquesNecess = std::stoi(line.substr(0,dashIndex));
-			line.erase(0,dashIndex+1);
-
-			// obter o numero de bombeiros necessarios
-			dashIndex = line.find_first_of('/');
-			numBombeirosNecess = std::stoi(line.substr(0,dashIndex));
-			line.erase(0,dashIndex+1);
-
-			// obter o tipo de incendio
-			dashIndex = line.find_first_of('/');
-			tipoIncendio = line.substr(0,dashIndex);
-			line.erase(0,dashIndex+1);
-
-			// Incendio Florestal
-			if (tipoIncendio == "Florestal"){
-				// obter a area de chamas
-				dashIndex = line.find_first_of('/');
-				areaChamas = std::stoi(line.substr(0,dashIndex));
-				line.erase(0,dashIndex+1);
-
-				acidente = new IncendioFlorestal(data,&locais.at(indexLocal),numOcorrencia,numBombeirosNecess,numAutotanquesNecess,areaChamas);
-			}
-			// Incendio Domestico
-			else {
-				// obter o tipo de casa
-				dashIndex = line.find_first_of('/');
-				tipoCasa = line.substr(0,dashIndex);
-				line.erase(0,dashIndex+1);
-
-				acidente = new IncendioDomestico(data,&locais.at(indexLocal),numOcorrencia,numBombeirosNecess,numAutotanquesNecess,tipoCasa);
-			}
-		}
+	//////////////////////////////////////////////////////////////////////////
+	// Ler o diario: apenas os registos integros, escritos sobre esta base e posteriores ao ultimo segmento //
+	//////////////////////////////////////////////////////////////////////////
 
-		// Acidentes de Viacao
-		else if (tipoAcidente == "Viacao"){
-			// obter o numero de feridos
-			dashIndex = line.find_first_of('/');
-			numFeridos = std::stoi(line.substr(0,dashIndex));
-			line.erase(0,dashIndex+1);
+	unsigned long long assinaturaDiario;
+	std::vector< std::pair<unsigned long long, std::shared_ptr<const RegistoAlteracao> > > registos;
+	if (!RegistoAlteracao::lerDiario(ficheiroDiario, assinaturaDiario, registos) || assinaturaDiario != assinaturaBase)
+		registos.clear();
 
-			// obter o numero de veiculos envolvidos
-			dashIndex = line.find_first_of('/');
-			numVeiculosEnvolvidos = std::stoi(line.substr(0,dashIndex));
-			line.erase(0,dashIndex+1);
+	unsigned int primeiroRegisto = 0;
+	while (primeiroRegisto < registos.size() && registos.at(primeiroRegisto).first <= seqDiario)
+		primeiroRegisto++;
 
-			// obter o tipo de estrada
-			dashIndex = line.find_first_of('/');
-			tipoEstrada = line.substr(0,dashIndex);
-			line.erase(0,dashIndex+1);
+	if (segmentos.empty() && primeiroRegisto == registos.size())
+		return;		// Nada a recuperar
 
-			acidente = new AcidenteViacao(data,&locais.at(indexLocal),numOcorrencia,tipoEstrada,numFeridos,numVeiculosEnvolvidos);
-		}
+	////////////////////////////////////////////////
+	// Aplicar as alteracoes sobre os descritores //
+	////////////////////////////////////////////////
 
-		// Assaltos
-		else if (tipoAcidente == "Assalto"){
-			// obter o tipo de casa
-			dashIndex = line.find_first_of('/');
-			tipoCasa = line.substr(0,dashIndex);
-			line.erase(0,dashIndex+1);
+	// Posicao de cada posto e de cada acidente nos vetores de descritores
+	std::map<unsigned int, unsigned int> posicaoPostos;
+	for (unsigned int i=0 ; i<descritoresPostos.size() ; i++){
+		posicaoPostos[descritoresPostos.at(i).id] = i;
+	}
+	std::map<unsigned int, unsigned int> posicaoAcidentes;
+	for (unsigned int i=0 ; i<numerosAcidentes.size() ; i++){
+		posicaoAcidentes[numerosAcidentes.at(i)] = i;
+	}
+	std::vector<bool> terminado(descritoresAcidentes.size(), false);
+
+	// Todas as alteracoes sao idempotentes: os postos ficam com o estado indicado e um acidente declarado substitui o que tenha o mesmo numero
+	auto definirPosto = [&](const DescritorPosto &descritor){
+		std::map<unsigned int, unsigned int>::const_iterator it = posicaoPostos.find(descritor.id);
+		if (it != posicaoPostos.end())
+			descritoresPostos.at(it->second) = descritor;
+	};
+	auto terminarAcidente = [&](unsigned int numOcorrencia){
+		std::map<unsigned int, unsigned int>::iterator it = posicaoAcidentes.find(numOcorrencia);
+		if (it != posicaoAcidentes.end()){
+			terminado.at(it->second) = true;
+			posicaoAcidentes.erase(it);
+		}
+	};
+	auto declararAcidente = [&](unsigned int numOcorrencia, const DescritorAcidente &descritor){
+		terminarAcidente(numOcorrencia);
+		posicaoAcidentes[numOcorrencia] = descritoresAcidentes.size();
+		numerosAcidentes.push_back(numOcorrencia);
+		descritoresAcidentes.push_back(descritor);
+		terminado.push_back(false);
+	};
+
+	// Segmentos: os acidentes terminados sao retirados antes de serem acrescentados os declarados (um numero de ocorrencia pode ser reutilizado)
+	for (unsigned int s=0 ; s<segmentos.size() ; s++){
+		const SegmentoCheckpoint &segmento = segmentos.at(s);
+
+		for (unsigned int i=0 ; i<segmento.postos.size() ; i++){
+			definirPosto(segmento.postos.at(i));
+		}
+		for (unsigned int i=0 ; i<segmento.acidentesFechados.size() ; i++){
+			terminarAcidente(segmento.acidentesFechados.at(i));
+		}
+		for (unsigned int i=0 ; i<segmento.acidentesAbertos.size() ; i++){
+			declararAcidente(segmento.acidentesAbertos.at(i).first, segmento.acidentesAbertos.at(i).second);
+		}
+	}
 
-			// obter a existencia de feridos
-			dashIndex = line.find_first_of('/');
-			haFeridos = ((line.substr(0,dashIndex) == "1") ? true : false);
-			line.erase(0,dashIndex+1);
+	// Diario: os registos sao aplicados pela ordem em que foram escritos, e ficam pendentes para o proximo checkpoint
+	for (unsigned int r=primeiroRegisto ; r<registos.size() ; r++){
+		const RegistoAlteracao &registo = *registos.at(r).second;
 
-			acidente = new Assalto(data,&locais.at(indexLocal),numOcorrencia,tipoCasa,haFeridos);
+		for (unsigned int i=0 ; i<registo.getPostos().size() ; i++){
+			DescritorPosto descritor = DescritorPosto::ler(registo.getPostos().at(i));
+			definirPosto(descritor);
+			postosAlterados.insert(descritor.id);
 		}
 
-		// obter o numero de atribuicoes
-		numAtribuicoes = std::stoi(line);
+		if (registo.getTipo() == RegistoAlteracao::ACIDENTE_TERMINADO){
+			terminarAcidente(registo.getNumOcorrencia());
+			if (abertosDiario.erase(registo.getNumOcorrencia()) == 0)
+				acidentesFechados.insert(registo.getNumOcorrencia());
 
-		// colocar as atribuicoes no acidente em questao
-		for (unsigned int i=0 ; i<numAtribuicoes ; i++){
-			getline(istr, atribuicao);	// obter a atribuicao
+			// O acidente pode ja ter sido arquivado antes da interrupcao
+			std::vector<RegistoArquivo> arquivados = arquivo.procurarNumero(registo.getNumOcorrencia());
+			bool arquivado = false;
+			for (unsigned int i=0 ; i<arquivados.size() && !arquivado ; i++){
+				arquivado = (arquivados.at(i).seq == registos.at(r).first);
+			}
+			if (!arquivado)
+				arquivo.adicionar(registo.getNumOcorrencia(), registo.getAcidente(), registos.at(r).first);
+		}
+		else if (registo.getTipo() == RegistoAlteracao::ACIDENTE_DECLARADO){
+			DescritorAcidente descritor;
+			const char* pos = registo.getAcidente().data();
+			if (DescritorAcidente::ler(pos, pos + registo.getAcidente().size(), descritor)){
+				// Um acidente ja gravado que volta a ser declarado (reforco de meios) tem de ser substituido no proximo checkpoint
+				if (posicaoAcidentes.count(registo.getNumOcorrencia()) && !abertosDiario.count(registo.getNumOcorrencia()))
+					acidentesFechados.insert(registo.getNumOcorrencia());
+				declararAcidente(registo.getNumOcorrencia(), descritor);
+				abertosDiario.insert(registo.getNumOcorrencia());
+			}
+		}
 
-			// ler o id do posto a que ao qual atribuicao se refere
-			dashIndex = atribuicao.find_first_of('/');
-			id = std::stoi(atribuicao.substr(0,dashIndex));
-			atribuicao.erase(0,dashIndex+1);
+		seqDiario = registos.at(r).first;
+	}
 
-			// ler o numero de socorristas na atribuicao
-			dashIndex = atribuicao.find_first_of('/');
-			numSocorristas = std::stoi(atribuicao.substr(0,dashIndex));
-			atribuicao.erase(0,dashIndex+1);
+	// Retirar dos vetores os acidentes terminados, mantendo a ordem dos restantes
+	unsigned int livre = 0;
+	for (unsigned int i=0 ; i<descritoresAcidentes.size() ; i++){
+		if (terminado.at(i))
+			continue;
+		if (livre != i){
+			descritoresAcidentes.at(livre) = std::move(descritoresAcidentes.at(i));
+			numerosAcidentes.at(livre) = numerosAcidentes.at(i);
+		}
+		livre++;
+	}
+	descritoresAcidentes.resize(livre);
+	numerosAcidentes.resize(livre);
+}
 
-			// ler o numero de veiculos na atribuicao
-			dashIndex = atribuicao.find_first_of('/');
-			numVeiculos = std::stoi(atribuicao.substr(0,dashIndex));
-			atribuicao.erase(0,dashIndex+1);
+void ProtecaoCivil::construirRankingsPostos(){
+	rankingsPostos.assign(locais.size(), postos);
 
-			// obter o tipo de veiculos da atribuicao
-			tipoVeiculos = atribuicao;
+	for (unsigned int i=0 ; i<locais.size() ; i++){
+		// Distancia (ao quadrado) de cada posto a este local
+		std::vector< std::pair<double, unsigned int> > distancias(postos.size());
+		for (unsigned int j=0 ; j<postos.size() ; j++){
+			double vecX = (double)postos.at(j)->getLocal()->getXcoord() - locais.at(i).getXcoord();
+			double vecY = (double)postos.at(j)->getLocal()->getYcoord() - locais.at(i).getYcoord();
+			distancias[j] = std::make_pair(vecX*vecX + vecY*vecY, j);
+		}
 
-			// adicionar a atribuicao ao acidente
-			acidente->addAtribuicao(Atribuicao(id, numSocorristas, numVeiculos, tipoVeiculos));
+		// Ordenar os postos por distancia crescente (em caso de empate, mantem-se a ordem do ficheiro)
+		std::stable_sort(distancias.begin(), distancias.end());
+		for (unsigned int j=0 ; j<postos.size() ; j++){
+			rankingsPostos[i][j] = postos.at(distancias[j].second);
 		}
+	}
+}
 
-		// Adicionar o novo acidente à base de dados da Protecao Civil
-		acidentes.push_back(acidente);
+void ProtecaoCivil::carregarHistorico(){
+	// Bloco a bloco, para nao ter todo o arquivo em memoria ao mesmo tempo
+	std::vector<ReferenciaBloco> blocos = arquivo.getBlocos();
+	for (unsigned int b=0 ; b<blocos.size() ; b++){
+		std::vector<RegistoArquivo> registos = arquivo.lerBloco(blocos.at(b));
+		for (unsigned int i=0 ; i<registos.size() ; i++){
+			std::map<std::string, unsigned int>::const_iterator local = indiceLocais.find(registos.at(i).descritor.nomeLocal);
+			if (local == indiceLocais.end())
+				continue;
 
-		numOcorrencia++;
+			std::unique_ptr<Acidente> acidente(registos.at(i).descritor.criarAcidente(&locais.at(local->second), registos.at(i).numOcorrencia));
+			historico.adicionar(acidente.get());
+			indiceAcidentes.adicionarTerminado(acidente.get(), historico.getNumAcidentes() - 1);
+		}
 	}
-
-	// Fechar a stream
-	istr.close();
 }
 
 ProtecaoCivil::~ProtecaoCivil() {
-	// gravar ocorrencias
-	gravar();
+	// O rebalanceador le a protecao civil em segundo plano
+	if (rebalanceador)
+		rebalanceador->parar();
+
+	// So se grava caso os ficheiros tenham sido abertos com sucesso (o escritor e criado no fim de openFiles): caso contrario os ficheiros seriam substituidos por um estado incompleto
+	if (escritor){
+		// terminar o escritor do diario, depois de escritas as alteracoes pendentes
+		escritor.reset();
+
+		// os acidentes terminados ficam no arquivo
+		arquivo.sincronizar();
+
+		// gravar ocorrencias (o diario deixa de ser necessario)
+		gravar();
+		std::remove(ficheiroDiario.c_str());
+	}
 
 	// apagar memória alocada para postos
 	for (unsigned int i=0 ; i<postos.size() ; i++){
@@ -275,313 +373,418 @@ ProtecaoCivil::~ProtecaoCivil() {
 }
 
 void ProtecaoCivil::addAcidente(Acidente* acidente){
-	// Ordenar os postos por distancia ao local onde ocorreu este acidente
-	ordenarPostosDistLocal(acidente->getLocal()->getNome());
+	ResultadoDespacho resultado = despacharAcidente(acidente);
 
-	unsigned short addSuccess;
+	// Verificar o grau de sucesso da adicao de meios para tratar a ocorrencia
+	if (resultado.estado == ResultadoDespacho::PARCIAL)	// Foram acionados alguns meios para este acidente, mas não todos. O acidente foi adicionado à proteção civil, mas notificar lançando uma exceção
+		throw MeiosInsuficientes("O acidente foi adicionado a' base de dados da Protecao Civil, mas nem todas as necessidades do acidente foram supridas.");
+	else if (resultado.estado == ResultadoDespacho::SEM_MEIOS)	// Nao foram acionados quaisquer meios para este acidente, pelo que este nao foi adicionado ha base de dados da proteção civil
+		throw MeiosInexistentes("Nao ha quaisquer meios capazes de suprir as necessidades deste acidente, pelo que nao foi adicionado a' base de dados da Protecao Civil");
+}
 
-	// Acidentes de Viacao
-	if (acidente->getTipoAcidente() == "Acidente de Viacao"){
-		addSuccess = addAcidenteViacao(dynamic_cast<AcidenteViacao*>(acidente));
-	}
+ResultadoDespacho ProtecaoCivil::despacharAcidente(Acidente* acidente){
+	// Postos por ordem de distancia ao local onde ocorreu este acidente: o ranking do local e lido diretamente, sem copiar nem reordenar o vetor de postos
+	int indiceLocal = findLocal(acidente->getLocal()->getNome());
+	unsigned short addSuccess = despachar(acidente, (indiceLocal == -1 ? postos : rankingsPostos.at(indiceLocal)));
 
-	// Incendios
-	else if ((acidente->getTipoAcidente() == "Incendio Florestal") || (acidente->getTipoAcidente() == "Incendio Domestico")){
-		addSuccess =  addIncendio(dynamic_cast<Incendio*>(acidente));
-	}
+	ResultadoDespacho resultado;
+	resultado.atribuicoes = acidente->getAtribuicoes();
+	calcularFalta(acidente, resultado);
 
-	// Assaltos
-	else {
-		addSuccess = addAssalto(dynamic_cast<Assalto*>(acidente));
-	}
-
-	// Verificar o grau de sucesso da adicao de meios para tratar a ocorrencia
 	if (addSuccess == 0){	// Se foram acionados todos os meios para este acidente, ele pertence agora à protecao civil
-		acidentes.push_back(acidente);
-		return;
+		resultado.estado = ResultadoDespacho::COMPLETO;
+		resultado.numOcorrencia = acidente->getNumOcorrencia();
+		aceitarAcidente(acidente, true);
 	}
-	else if (addSuccess == 1){	// Foram acionados alguns meios para este acidente, mas não todos. Adicionar o acidente à proteção civil, mas notificar lançando uma exceção
-		acidentes.push_back(acidente);
-		throw MeiosInsuficientes("O acidente foi adicionado a' base de dados da Protecao Civil, mas nem todas as necessidades do acidente foram supridas.");
+	else if (addSuccess == 1){	// Foram acionados alguns meios para este acidente, mas não todos: ainda assim pertence à protecao civil
+		resultado.estado = ResultadoDespacho::PARCIAL;
+		resultado.numOcorrencia = acidente->getNumOcorrencia();
+		aceitarAcidente(acidente, true);
 	}
-	else{	// Nao foram acionados quaisquer meios para este acidente, pelo que este nao foi adicionado ha base de dados da proteção civil
-		throw MeiosInexistentes("Nao ha quaisquer meios capazes de suprir as necessidades deste acidente, pelo que nao foi adicionado a' base de dados da Protecao Civil");
+	else{	// Nao foram acionados quaisquer meios para este acidente, pelo que este nao fica na protecao civil
+		resultado.estado = ResultadoDespacho::SEM_MEIOS;
+		registarProcura(acidente);
 	}
-}
 
-unsigned short ProtecaoCivil::addAcidenteViacao(AcidenteViacao* acidenteViacao){
-	unsigned int numVeiculosAtribuidos = 0;
-	unsigned int numeroFeridos = acidenteViacao->getNumFeridos();
+	aplicarRebalanceamento();
+	return resultado;
+}
 
-	// Procurar postos (por ordem de proximidade, vetor de postos ja ordernado) do Inem ou dos Bombeiros para suprir as necessidades do acidente
-	// Cada ferido necessita de uma equipa de assistencia (ou seja, um veículo, seja ele uma Moto com 1 socorrista, um carro com 2 socorristas ou uma ambulancia com 2 socorristas)
-	for (unsigned int i=0 ; i<postos.size() ; i++){
+void ProtecaoCivil::calcularFalta(const Acidente* acidente, ResultadoDespacho &resultado) const{
+	// Unidades atribuidas, por tipo de recurso (o tipo de posto distingue as equipas policiais das medicas)
+	unsigned int atribuido[ResultadoDespacho::NUM_RECURSOS] = {};
+	for (unsigned int i=0 ; i<resultado.atribuicoes.size() ; i++){
+		const Atribuicao &atribuicao = resultado.atribuicoes.at(i);
+		if (atribuicao.getTipoVeiculos() == "Autotanque"){
+			atribuido[ResultadoDespacho::AUTOTANQUES] += atribuicao.getNumVeiculos();
+			continue;
+		}
 
-		// Verificar se o posto é um posto do Inem
-		if(postos.at(i)->getTipoPosto() == "Inem"){
-			// É um posto do Inem
-			Inem* postoInem = dynamic_cast<Inem*>(postos.at(i));
-
-			while (postoInem->getNumVeiculos() > 0){
-				// Posto de Inem com Motos
-				if (postoInem->getTipoVeiculo()=="Moto"){	// Cada moto leva 1 medico
-					if (postoInem->rmSocorristas(1)){
-						postoInem->rmVeiculos(1);
-						numVeiculosAtribuidos += 1;
-
-						// Adicionar a atribuicao
-						acidenteViacao->addAtribuicao(Atribuicao(postoInem->getId(),1,1,"Moto"));
-
-						// Verificar se ja foram supridas as necessidades do acidente
-						if(numVeiculosAtribuidos == numeroFeridos)
-							return 0;	// Todos as necessidades foram supridas!!!
-					}
-					else{	// Apesar de haver motos, não há medicos suficientes para o seu uso!
-						break;
-					}
-				}
+		std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(atribuicao.getPostoId());
+		if (it != indicePostos.end() && it->second->getTipoPosto() == "Policia")
+			atribuido[ResultadoDespacho::EQUIPAS_POLICIAIS] += atribuicao.getNumVeiculos();
+		else
+			atribuido[ResultadoDespacho::EQUIPAS_MEDICAS] += atribuicao.getNumVeiculos();
+	}
 
-				// Posto do Inem com Carros / Ambulancias
-				else{
-					if (postoInem->rmSocorristas(2)){	// Cada carro / ambulancia leva 2 medicos
-						postoInem->rmVeiculos(1);
-						numVeiculosAtribuidos += 1;
-
-						// Adicionar a atribuicao
-						acidenteViacao->addAtribuicao(Atribuicao(postoInem->getId(),2,1,postoInem->getTipoVeiculo()));
-
-						// Verificar se ja foram supridas as necessidades do acidente
-						if(numVeiculosAtribuidos == numeroFeridos)
-						return 0;	// Todos as necessidades foram supridas!!!
-					}
-					else{	// Apesar de haver carros/ambulancias, não há medicos suficientes para o seu uso!
-						break;
-					}
-				}
-			}
-		}
+	// Unidades necessarias, com as necessidades do proprio acidente (ver Acidente::getNecessidades)
+	for (unsigned int i=0 ; i<ResultadoDespacho::NUM_RECURSOS ; i++){
+		unsigned int necessario = OtimizadorDespacho::getProcura(acidente, (ResultadoDespacho::TipoRecurso)i);
+		resultado.falta[i] = (atribuido[i] < necessario ? necessario - atribuido[i] : 0);
+	}
+}
 
+unsigned short ProtecaoCivil::despachar(Acidente* acidente, const std::vector<Posto*> &ordem){
+	unsigned short addSuccess = acionarMeios(acidente, ordem);
 
-		// Verificar se é um posto dos bombeiros
-		else if (postos.at(i)->getTipoPosto() == "Bombeiros"){
-			// É um posto de bombeiros
-			Bombeiros* postoBombeiros = dynamic_cast<Bombeiros*>(postos.at(i));
+	// Os postos de onde sairam meios ficam por gravar no proximo checkpoint
+	marcarPostosAlterados(acidente);
 
-			while (postoBombeiros->getNumAmbulancias() > 0){
-				if(postoBombeiros->rmSocorristas(2)){	// Cada ambulancia leva 2 medicos
-					postoBombeiros->rmAmbulancias(1);
-					numVeiculosAtribuidos+=1;
+	return addSuccess;
+}
 
-					// Adicionar a atribuicao
-					acidenteViacao->addAtribuicao(Atribuicao(postoBombeiros->getId(),2,1,"Ambulancia"));
+unsigned short ProtecaoCivil::acionarMeios(Acidente* acidente, const std::vector<Posto*> &ordem){
+	// O mesmo algoritmo para todos os tipos de acidente, com as necessidades de cada tipo (ver Acidente::getNecessidades)
+	MeiosReais meios;
+	return EmparelhadorMeios::emparelhar(acidente, ordem, meios);
+}
 
-					// Verificar se ja foram supridas as necessidades do acidente
-					if(numVeiculosAtribuidos == numeroFeridos)
-						return 0;	// Todos as necessidades foram supridas!!!
-				}
-				else{	// Apesar de haver ambulancias, não há bombeiros suficientes para o seu uso!
-					break;
-				}
-			}
-		}
+unsigned short ProtecaoCivil::acionarMeios(Acidente* acidente, const std::vector<Posto*> &ordem, TabelaCapacidades &capacidades) const{
+	return EmparelhadorMeios::emparelhar(acidente, ordem, capacidades);
+}
 
-		// É um posto da Policia , na0 é pertinente para o tipo de acidente em questao
-		else {
-			continue;
-		}
-	}
+void ProtecaoCivil::registarProcura(const Acidente* acidente){
+	if (rebalanceador)
+		rebalanceador->registarProcura(acidente);
+}
 
-	// Todos os postos foram percorridos, mas as necessidades do acidente nao foram totalmente supridas!
+void ProtecaoCivil::aplicarRebalanceamento(){
+	if (!rebalanceador)
+		return;
 
-	// Verificar se foram parcialmente supridas
-	if (numVeiculosAtribuidos != 0)
-		return 1;
+	// Caso a proposta tenha sido calculada sobre capacidades entretanto desatualizadas, os postos ficam como estavam
+	std::shared_ptr<const RebalanceadorFrota::Proposta> proposta = rebalanceador->obterProposta();
+	if (!proposta)
+		return;
+	std::vector<MovimentoMeios> invalidos;
+	aplicarMovimentos(proposta->movimentos, &invalidos);
+	if (!invalidos.empty())
+		rebalanceador->registarMovimentosInvalidos(invalidos.size());
+}
 
-	// Nao houve uma unica atribuicao com sucesso, nenhumas necessidades foram supridas
-	else
-		return 2;
+void ProtecaoCivil::associarRebalanceador(RebalanceadorFrota* rebalanceador){
+	if (this->rebalanceador)
+		this->rebalanceador->parar();
+	this->rebalanceador = rebalanceador;
+	if (rebalanceador)
+		rebalanceador->iniciar();
 }
 
-unsigned short ProtecaoCivil::addIncendio(Incendio* incendio){
-	unsigned int numBombeirosAtribuidos = 0;
-	unsigned int numAutotanquesAtribuidos = 0;
-	unsigned int numBombeirosNecess = incendio->getNumBombeirosNecess();
-	unsigned int numAutotanquesNecess= incendio->getNumAutotanquesNecess();
+unsigned long long ProtecaoCivil::aceitarAcidente(Acidente* acidente, bool aguardar){
+	registarProcura(acidente);
+	acidentes.push_back(acidente);
+	indiceAcidentes.adicionar(acidente);
+	acidentesAbertos[acidente->getNumOcorrencia()] = acidente;
+	atualizarPendente(acidente);
+	return registarAlteracao(RegistoAlteracao::ACIDENTE_DECLARADO, acidente, acidente->getAtribuicoes(), aguardar);
+}
 
-	// Procurar postos (por ordem de proximidade, vetor de postos ja ordernado) de bombeiros para suprir as necessidades do incendio
-	// Cada autotanque leva até 4 bombeiros
-	for (unsigned int i=0 ; i<postos.size() ; i++){
+std::vector<ResultadoDespacho> ProtecaoCivil::ingerirAcidentes(const std::vector<DescritorAcidente> &descritores){
+	std::vector<ResultadoDespacho> resultados(descritores.size());
 
-		// Verificar se o posto é um posto de bombeiros
-		if(postos.at(i)->getTipoPosto() != "Bombeiros")
-			continue;	// Nao é. Continuar para o proximo posto
+	// Validar todos os descritores numa unica passagem, resolvendo os locais
+	std::vector<int> indicesLocais(descritores.size(), -1);
+	for (unsigned int i=0 ; i<descritores.size() ; i++){
+		if (!descritores.at(i).valido()){
+			resultados[i].estado = ResultadoDespacho::INVALIDO;
+			resultados[i].erro = "Acidente invalido.";
+			continue;
+		}
 
-		// É um posto de bombeiros
-		Bombeiros* postoBombeiros = dynamic_cast<Bombeiros*>(postos.at(i));
+		indicesLocais[i] = findLocal(descritores.at(i).nomeLocal);
+		if (indicesLocais[i] == -1){
+			resultados[i].estado = ResultadoDespacho::INVALIDO;
+			resultados[i].erro = "O local \"" + descritores.at(i).nomeLocal + "\" nao existe.";
+		}
+	}
 
-		while (postoBombeiros->getNumAutotanques() > 0){
-			if(postoBombeiros->rmSocorristas(3)){	// Cada autotanque leva 3 bombeiros
-				postoBombeiros->rmAutotanques(1);
-				numBombeirosAtribuidos+=3;
-				numAutotanquesAtribuidos+=1;
+	// Despachar pela ordem recebida, com os rankings de postos ja calculados para cada local (sem reordenar o vetor de postos)
+	unsigned int numOcorrencia = getMaxNumOcorrencia();
+	unsigned long long ultimoSeq = 0;
+	for (unsigned int i=0 ; i<descritores.size() ; i++){
+		if (indicesLocais[i] == -1)
+			continue;
 
-				// Adicionar a atribuicao
-				incendio->addAtribuicao(Atribuicao(postoBombeiros->getId(),3,1,"Autotanque"));
+		Acidente* acidente = descritores.at(i).criarAcidente(&locais.at(indicesLocais[i]), ++numOcorrencia);
+		unsigned short addSuccess = despachar(acidente, rankingsPostos.at(indicesLocais[i]));
+		resultados[i].atribuicoes = acidente->getAtribuicoes();
+		calcularFalta(acidente, resultados[i]);
 
-				// Verificar se ja foram supridas as necessidades do acidente
-				if((numBombeirosAtribuidos == numBombeirosNecess) && (numAutotanquesAtribuidos==numAutotanquesNecess))
-					return 0;	// Todos as necessidades foram supridas!!!
-			}
-			else{	// Apesar de haver autotanques, não há bombeiros suficientes para o seu uso!
-				break;
-			}
+		if (addSuccess == 2){	// Nenhum meio acionado: o acidente nao fica na protecao civil nem gasta o numero de ocorrencia
+			resultados[i].estado = ResultadoDespacho::SEM_MEIOS;
+			registarProcura(acidente);
+			numOcorrencia--;
+			delete acidente;
+			continue;
 		}
+
+		ultimoSeq = aceitarAcidente(acidente, false);
+		resultados[i].estado = (addSuccess == 0 ? ResultadoDespacho::COMPLETO : ResultadoDespacho::PARCIAL);
+		resultados[i].numOcorrencia = acidente->getNumOcorrencia();
 	}
 
-	// Todos os postos foram percorridos, mas as necessidades do acidente nao foram totalmente supridas!
+	// No modo POR_OPERACAO o lote inteiro fica no disco antes de retornar (uma unica espera, em vez de uma por acidente)
+	if (escritor && ultimoSeq > 0 && escritor->getModo() == EscritorPersistencia::POR_OPERACAO)
+		escritor->aguardar(ultimoSeq);
 
-	// Verificar se foram parcialmente supridas
-	if ((numBombeirosAtribuidos != 0) && (numAutotanquesAtribuidos != 0))
-		return 1;
+	aplicarRebalanceamento();
+	return resultados;
+}
 
-	// Nao houve uma unica atribuicao com sucesso, nenhumas necessidades foram supridas
-	else
-		return 2;
+std::vector<ResultadoDespacho> ProtecaoCivil::ingerirFicheiro(const std::string &ficheiro){
+	return ingerirAcidentes(LeitorAcidentes::lerFicheiro(ficheiro));
 }
 
-unsigned short ProtecaoCivil::addAssalto(Assalto* assalto){
-	bool haFeridos = assalto->haFeridos();
-	bool haApoioMedico = false;	// Se houver feridos, esta variavel indica se foi encontrado apoio médico
-	bool haApoioPolicial = false;	// Se for encontrado um posto da policia que forneca apoio policial, esta variavel fica a true
+std::vector<ResultadoDespacho> ProtecaoCivil::despacharLote(const std::vector<Acidente*> &acidentes){
+	// Distribuir os meios por todo o lote de uma so vez (as redes de fluxo do lote anterior sao retomadas)
+	otimizador.otimizar(acidentes);
 
-	// Procurar postos (por ordem de proximidade, vetor de postos ja ordernado) da policia para suprir as necessidades do assalto
-	// Cada assalto necissita de uma equipa policial ( Seja um carro com 2 Policias ou uma mota com 1 Policia )
-	for (unsigned int i=0 ; i<postos.size() ; i++){
+	return concluirLote(acidentes);
+}
 
-		// Verificar se o posto é um posto da policia
-		if(postos.at(i)->getTipoPosto() != "Policia")
-			continue;	// Nao é. Continuar para o proximo posto
+std::vector<ResultadoDespacho> ProtecaoCivil::concluirLote(const std::vector<Acidente*> &acidentes){
+	std::vector<ResultadoDespacho> resultados(acidentes.size());
 
-		// É um posto da policia
-		Policia* postoPolicia = dynamic_cast<Policia*>(postos.at(i));
+	unsigned long long ultimoSeq = 0;
+	for (unsigned int i=0 ; i<acidentes.size() ; i++){
+		Acidente* acidente = acidentes.at(i);
+		marcarPostosAlterados(acidente);
+		resultados[i].atribuicoes = acidente->getAtribuicoes();
+		calcularFalta(acidente, resultados[i]);
+
+		if (resultados[i].atribuicoes.empty()){	// Nenhum meio acionado: o acidente nao fica na protecao civil
+			resultados[i].estado = ResultadoDespacho::SEM_MEIOS;
+			registarProcura(acidente);
+			continue;
+		}
 
-		if(postoPolicia->getNumVeiculos()>0){
-			// Posto de Motos
-			if(postoPolicia->getTipoVeiculo()=="Moto"){
-				if(postoPolicia->rmSocorristas(1)){		// Cada moto leva 1 policia
-					postoPolicia->rmVeiculos(1);
+		bool completo = true;
+		for (unsigned int j=0 ; j<ResultadoDespacho::NUM_RECURSOS ; j++){
+			if (resultados[i].falta[j] != 0)
+				completo = false;
+		}
+		resultados[i].estado = (completo ? ResultadoDespacho::COMPLETO : ResultadoDespacho::PARCIAL);
+		resultados[i].numOcorrencia = acidente->getNumOcorrencia();
+		ultimoSeq = aceitarAcidente(acidente, false);
+	}
 
-					// Adicionar a atribuicao
-					assalto->addAtribuicao(Atribuicao(postoPolicia->getId(),1,1,"Moto"));
+	// No modo POR_OPERACAO o lote inteiro fica no disco antes de retornar (uma unica espera, em vez de uma por acidente)
+	if (escritor && ultimoSeq > 0 && escritor->getModo() == EscritorPersistencia::POR_OPERACAO)
+		escritor->aguardar(ultimoSeq);
 
-					// Foi encontrado apoio policial!
-					haApoioPolicial = true;
-					break;
-				}
-			}
-			// Posto de Carros
-			else{
-				if(postoPolicia->rmSocorristas(2)){		// Cada carro leva 2 policias
-					postoPolicia->rmVeiculos(1);
+	aplicarRebalanceamento();
+	return resultados;
+}
 
-					// Adicionar a atribuicao
-					assalto->addAtribuicao(Atribuicao(postoPolicia->getId(),2,1,"Carro"));
+std::vector< std::vector<ResultadoDespacho> > ProtecaoCivil::despacharConcorrente(const std::vector< std::vector<Acidente*> > &grupos){
+	std::vector< std::vector<unsigned short> > sucesso(grupos.size());
+
+	// Um despachante por grupo: os rankings e os locais so sao lidos, e os meios sao reservados nos contadores atomicos dos postos
+	std::vector<std::thread> despachantes;
+	for (unsigned int g=0 ; g<grupos.size() ; g++){
+		despachantes.push_back(std::thread([this, &grupos, &sucesso, g](){
+			sucesso[g].resize(grupos.at(g).size());
+			for (unsigned int i=0 ; i<grupos.at(g).size() ; i++){
+				Acidente* acidente = grupos.at(g).at(i);
+				int indiceLocal = findLocal(acidente->getLocal()->getNome());
+				sucesso[g][i] = acionarMeios(acidente, (indiceLocal == -1 ? postos : rankingsPostos.at(indiceLocal)));
+			}
+		}));
+	}
+	for (unsigned int g=0 ; g<despachantes.size() ; g++){
+		despachantes.at(g).join();
+	}
 
-					// Foi encontrado apoio policial!
-					haApoioPolicial = true;
-					break;
-				}
+	// Os acidentes sao aceites por uma so thread, pela ordem dos grupos
+	std::vector< std::vector<ResultadoDespacho> > resultados(grupos.size());
+	unsigned long long ultimoSeq = 0;
+	for (unsigned int g=0 ; g<grupos.size() ; g++){
+		resultados[g].resize(grupos.at(g).size());
+		for (unsigned int i=0 ; i<grupos.at(g).size() ; i++){
+			Acidente* acidente = grupos.at(g).at(i);
+			ResultadoDespacho &resultado = resultados[g][i];
+			marcarPostosAlterados(acidente);
+			resultado.atribuicoes = acidente->getAtribuicoes();
+			calcularFalta(acidente, resultado);
+
+			if (sucesso[g][i] == 2){	// Nenhum meio acionado: o acidente nao fica na protecao civil
+				resultado.estado = ResultadoDespacho::SEM_MEIOS;
+				registarProcura(acidente);
+				continue;
 			}
+
+			resultado.estado = (sucesso[g][i] == 0 ? ResultadoDespacho::COMPLETO : ResultadoDespacho::PARCIAL);
+			resultado.numOcorrencia = acidente->getNumOcorrencia();
+			ultimoSeq = aceitarAcidente(acidente, false);
 		}
 	}
 
-	// Se houver feridos, procurar por uma equipa de apoio medico (1 moto com 1 médico, ou um carro/ambulancia com 2 medicos)
-	if(haFeridos){
-		for(unsigned int i=0 ; i<postos.size() ; i++){
-			if(postos.at(i)->getTipoPosto()=="Inem"){
-				// É um posto do Inem
-				Inem* postoInem = dynamic_cast<Inem*>(postos.at(i));
+	// No modo POR_OPERACAO todos os grupos ficam no disco antes de retornar (uma unica espera)
+	if (escritor && ultimoSeq > 0 && escritor->getModo() == EscritorPersistencia::POR_OPERACAO)
+		escritor->aguardar(ultimoSeq);
 
-				if (postoInem->getNumVeiculos() > 0){
-					// Posto de Motos
-					if(postoInem->getTipoVeiculo() == "Moto"){
-						if(postoInem->rmSocorristas(1)){  // uma moto leva 1 medico
-							postoInem->rmVeiculos(1);
-
-							// Adicionar a atribuicao
-							assalto->addAtribuicao(Atribuicao(postoInem->getId(),1,1,"Moto"));
+	aplicarRebalanceamento();
+	return resultados;
+}
 
-							// Foi encontrado apoio medico!
-							haApoioMedico = true;
-							break;
-						}
-					}
+std::vector<ResultadoDespacho> ProtecaoCivil::despacharRegioes(const std::vector<Acidente*> &acidentes){
+	// Dividir os acidentes pelas regioes dos seus locais
+	std::vector< std::vector<unsigned int> > porRegiao(regioes->getNumRegioes());
+	std::vector<int> indicesLocais(acidentes.size());
+	for (unsigned int i=0 ; i<acidentes.size() ; i++){
+		indicesLocais[i] = findLocal(acidentes.at(i)->getLocal()->getNome());
+		if (indicesLocais[i] != -1)
+			porRegiao[regioes->getRegiao(indicesLocais[i])].push_back(i);
+	}
 
-					// Posto de Carros / Ambulancias
-					else {
-						if(postoInem->rmSocorristas(2)){  // um carro/ambulancia leva 2 medicos
-							postoInem->rmVeiculos(1);
+	// Uma fase do despacho: o despachante de cada regiao com acidentes trata os acidentes da sua regiao
+	auto executarFase = [&](std::function<void(Acidente*, unsigned int)> despachar){
+		std::vector< std::function<void()> > tarefas(porRegiao.size());
+		for (unsigned int r=0 ; r<porRegiao.size() ; r++){
+			if (porRegiao.at(r).empty())
+				continue;
+			tarefas[r] = [&, r](){
+				for (unsigned int i=0 ; i<porRegiao.at(r).size() ; i++){
+					unsigned int indice = porRegiao.at(r).at(i);
+					despachar(acidentes.at(indice), indicesLocais.at(indice));
+				}
+			};
+		}
+		regioes->executar(tarefas);
+	};
 
-							// Adicionar a atribuicao
-							assalto->addAtribuicao(Atribuicao(postoInem->getId(),2,1,postoInem->getTipoVeiculo()));
+	// Cada regiao serve os seus acidentes com os seus postos
+	executarFase([this](Acidente* acidente, unsigned int indiceLocal){
+		acionarMeios(acidente, regioes->getOrdemRegiao(indiceLocal));
+	});
 
-							// Foi encontrado apoio medico!
-							haApoioMedico = true;
-							break;
-						}
-					}
-				}
-			}
+	// So depois de todas as regioes terem servido os seus acidentes e que os meios que sobram podem ir para outras regioes
+	executarFase([this](Acidente* acidente, unsigned int indiceLocal){
+		reforcarDeFora(acidente, regioes->getOrdemFora(indiceLocal));
+	});
 
-			else if(postos.at(i)->getTipoPosto()=="Bombeiros"){
-				// É um posto dos Bombeiros
-				Bombeiros* postoBombeiros = dynamic_cast<Bombeiros*>(postos.at(i));
+	return concluirLote(acidentes);
+}
 
-				if(postoBombeiros->getNumAmbulancias() > 0){
-					if(postoBombeiros->rmSocorristas(2)){	// Cada ambulancia leva 2 bombeiros
-						postoBombeiros->rmAmbulancias(1);
+void ProtecaoCivil::reforcarDeFora(Acidente* acidente, const std::vector<Posto*> &ordem){
+	ResultadoDespacho resultado;
+	resultado.atribuicoes = acidente->getAtribuicoes();
+	calcularFalta(acidente, resultado);
+
+	// Os autotanques primeiro: as ambulancias dos bombeiros so podem sair com os bombeiros que sobrarem
+	const ResultadoDespacho::TipoRecurso recursos[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+	for (unsigned int r=0 ; r<3 ; r++){
+		unsigned int emFalta = resultado.falta[recursos[r]];
+		for (unsigned int i=0 ; i<ordem.size() && emFalta > 0 ; i++){
+			emFalta -= OtimizadorDespacho::reservar(ordem.at(i), acidente, recursos[r], emFalta);
+		}
+	}
+}
 
-						// Adicionar a atribuicao
-						assalto->addAtribuicao(Atribuicao(postoBombeiros->getId(),2,1,"Ambulancia"));
+void ProtecaoCivil::particionarRegioes(unsigned int lado){
+	regioes.reset(new RegioesDespacho(locais, postos, rankingsPostos, lado));
+}
 
-						// Foi encontrado apoio medico!
-						haApoioMedico = true;
-						break;
-					}
-				}
-			}
+TabelaCapacidades ProtecaoCivil::getCapacidades() const{
+	// O indice de postos nao muda depois de abertos os ficheiros (ao contrario do vetor de postos, reordenado por cada despacho)
+	return TabelaCapacidades(indicePostos);
+}
 
-			else{	// Posto da Policia, nao contem medicos
-				continue;
-			}
-		}
+std::vector<ResultadoDespacho> ProtecaoCivil::planearDespacho(const std::vector<DescritorAcidente> &descritores, TabelaCapacidades &capacidades) const{
+	// Validar todo o cenario antes de planear
+	std::vector<int> indicesLocais(descritores.size());
+	for (unsigned int i=0 ; i<descritores.size() ; i++){
+		if (!descritores.at(i).valido())
+			throw InputInvalido("Acidente invalido no cenario a planear.");
+		indicesLocais[i] = findLocal(descritores.at(i).nomeLocal);
+		if (indicesLocais[i] == -1)
+			throw LocalidadeInexistente("O local \"" + descritores.at(i).nomeLocal + "\" nao existe.");
 	}
 
-	// No caso de haver feridos
-	if (haFeridos){
-		if(haApoioMedico && haApoioPolicial){
-			return 0;	// Todas as necessidades supridas!
-		}
-		else if(haApoioMedico || haApoioPolicial){
-			return 1;	// Parte das necessidades supridas!
-		}
-		else{
-			return 2;	// Nenhumas necessidades supridas...
-		}
+	std::vector<ResultadoDespacho> resultados(descritores.size());
+	for (unsigned int i=0 ; i<descritores.size() ; i++){
+		// Acidente temporario (sem numero de ocorrencia), so para receber as atribuicoes planeadas
+		std::unique_ptr<Acidente> acidente(descritores.at(i).criarAcidente(&locais.at(indicesLocais[i]), 0));
+		resultados[i] = planearDespacho(acidente.get(), capacidades);
 	}
 
-	// No caso de nao haver feridos
-	else{
-		if (haApoioPolicial)	// Necessidades supridas!
-			return 0;
-		else					// Necessidades nao supridas...
-			return 2;
+	return resultados;
+}
+
+ResultadoDespacho ProtecaoCivil::planearDespacho(Acidente* acidente, TabelaCapacidades &capacidades) const{
+	int indiceLocal = findLocal(acidente->getLocal()->getNome());
+	if (indiceLocal == -1)
+		throw LocalidadeInexistente("O local \"" + acidente->getLocal()->getNome() + "\" nao existe.");
+
+	ResultadoDespacho resultado;
+	unsigned short addSuccess = acionarMeios(acidente, rankingsPostos.at(indiceLocal), capacidades);
+	resultado.atribuicoes = acidente->getAtribuicoes();
+	calcularFalta(acidente, resultado);
+	if (addSuccess == 0)
+		resultado.estado = ResultadoDespacho::COMPLETO;
+	else if (addSuccess == 1)
+		resultado.estado = ResultadoDespacho::PARCIAL;
+	else
+		resultado.estado = ResultadoDespacho::SEM_MEIOS;
+	return resultado;
+}
+
+std::vector<Acidente*> ProtecaoCivil::planearRegresso(const Atribuicao &atribuicao, TabelaCapacidades &capacidades, FilaPendentes &pendentesPlaneados) const{
+	std::vector<Acidente*> reforcados;
+	std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(atribuicao.getPostoId());
+	if (it == indicePostos.end())
+		return reforcados;		// O posto ja nao existe, nao ha para onde retornar os meios
+	Posto* posto = it->second;
+	capacidades.repor(posto, atribuicao);
+
+	// Tal como em reforcarPendentes, mas com os meios do instantaneo e a fila dada
+	const ResultadoDespacho::TipoRecurso recursos[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+	const std::vector<Posto*> ordem(1, posto);
+	for (unsigned int r=0 ; r<3 && pendentesPlaneados.getNumPendentes() != 0 ; r++){
+		unsigned int oferta = capacidades.getOferta(posto, recursos[r]);
+		if (oferta == 0)
+			continue;
+
+		pendentesPlaneados.distribuir(recursos[r], oferta, [&](Acidente* acidente, unsigned int unidades){
+			EmparelhadorMeios::suprir(acidente, Necessidade(recursos[r], unidades), ordem, capacidades);
+			ResultadoDespacho resultado;
+			resultado.atribuicoes = acidente->getAtribuicoes();
+			calcularFalta(acidente, resultado);
+			pendentesPlaneados.atualizar(acidente, resultado);
+			if (std::find(reforcados.begin(), reforcados.end(), acidente) == reforcados.end())
+				reforcados.push_back(acidente);
+		});
 	}
+	return reforcados;
+}
+
+ResultadoDespacho ProtecaoCivil::planearDespacho(const DescritorAcidente &descritor) const{
+	TabelaCapacidades capacidades = getCapacidades();
+	return planearDespacho(std::vector<DescritorAcidente>(1, descritor), capacidades).front();
 }
 
 
 
 bool ProtecaoCivil::rmAcidente(unsigned int numOcorrencia){
+	std::vector<Atribuicao> atribuicoes;
+	return fecharAcidente(numOcorrencia, true, atribuicoes);
+}
+
+bool ProtecaoCivil::terminarAcidente(unsigned int numOcorrencia, std::vector<Atribuicao> &meiosEmRegresso){
+	return fecharAcidente(numOcorrencia, false, meiosEmRegresso);
+}
+
+bool ProtecaoCivil::fecharAcidente(unsigned int numOcorrencia, bool retornarMeios, std::vector<Atribuicao> &atribuicoes){
 	// Encontrar o acidente no vetor de acidentes
 	int indiceAcidente = -1;
 	for (unsigned int i=0 ; i<acidentes.size() ; i++){
@@ -595,28 +798,41 @@ bool ProtecaoCivil::rmAcidente(unsigned int numOcorrencia){
 	if (indiceAcidente==-1)
 		return false;
 
+	// O acidente deixa de esperar por meios (os que retorna podem ir para outros acidentes pendentes)
+	pendentes.remover(numOcorrencia);
+
 	// Obter todas as atribuicoes a esse acidente
-	std::vector<Atribuicao> atribuicoes = acidentes.at(indiceAcidente)->getAtribuicoes();
+	atribuicoes = acidentes.at(indiceAcidente)->getAtribuicoes();
 
-	// Retornar os meios das atribuicoes de volta para os seus respetivos postos
-	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
-		retornarAtribuicao(atribuicoes.at(i));
+	// Retornar os meios das atribuicoes de volta para os seus respetivos postos (caso contrario, os meios so retornam quando chegarem, ver regressarMeios)
+	if (retornarMeios){
+		for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
+			retornarAtribuicao(atribuicoes.at(i));
+		}
 	}
 
-	// Apagar o acidente da base de dados da protecao civil
+	unsigned long long seq = registarAlteracao(RegistoAlteracao::ACIDENTE_TERMINADO, acidentes.at(indiceAcidente), atribuicoes);
+
+	// Um acidente declarado desde o ultimo checkpoint ainda nao foi gravado, basta esquece-lo; os restantes tem de ser retirados no proximo checkpoint
+	if (acidentesAbertos.erase(numOcorrencia) == 0)
+		acidentesFechados.insert(numOcorrencia);
+
+	// Passar o acidente para o historico e para o arquivo e apaga-lo da base de dados da protecao civil
+	historico.adicionar(acidentes.at(indiceAcidente));
+	arquivo.adicionar(acidentes.at(indiceAcidente), seq);
+	indiceAcidentes.terminar(acidentes.at(indiceAcidente), historico.getNumAcidentes() - 1);
+	delete acidentes.at(indiceAcidente);
 	acidentes.erase(acidentes.begin()+indiceAcidente);
 
 	return true;
 }
 
 int ProtecaoCivil::findLocal(const std::string &nomeLocal) const{
-	for(unsigned int i=0 ; i<locais.size() ; i++){
-		if(locais.at(i).getNome() == nomeLocal){
-			return i;
-		}
-	}
+	std::map<std::string, unsigned int>::const_iterator it = indiceLocais.find(nomeLocal);
+	if (it == indiceLocais.end())
+		return -1;	// local nao foi encontrado
 
-	return -1;	// local nao foi encontrado
+	return it->second;
 }
 
 void ProtecaoCivil::ordenarPostos(bool compareFunction(Posto* p1, Posto*p2)){
@@ -697,12 +913,11 @@ void ProtecaoCivil::printPostosLocal(const std::string &local) const{
 }
 
 void ProtecaoCivil::printPostosId(unsigned int id) const{
-	// Procurar o Postos
-	for (unsigned int i=0 ; i<postos.size() ; i++){
-		if (postos.at(i)->getId() == id){		// Encontrado
-			postos.at(i)->printInfoPosto();
-			return;
-		}
+	// Procurar o Posto
+	std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(id);
+	if (it != indicePostos.end()){		// Encontrado
+		it->second->printInfoPosto();
+		return;
 	}
 
 	// Nao ha postos com este id
@@ -844,6 +1059,14 @@ void ProtecaoCivil::printAcidentesId(unsigned int id) const{
 		}
 	}
 
+	// Procurar o acidente (terminado) no arquivo
+	std::shared_ptr<const Acidente> arquivado = getAcidenteArquivado(id);
+	if (arquivado){
+		arquivado->printInfoAcidente();
+		std::cout << "(Acidente terminado)" << std::endl;
+		return;
+	}
+
 	// Nao ha acidentes com este id
 	std::cout << "Nao ha nenhum acidente com o numero de identificacao especificado.";
 }
@@ -877,77 +1100,191 @@ double ProtecaoCivil::getDistLocais(const std::string &nomeLocal1, const std::st
 }
 
 void ProtecaoCivil::ordenarPostosDistLocal(const std::string &nomeLocal){
-	bool swapOccured = false;
-	Posto* temp;
-
-	// Ordenar o vetor de postos com base na distancia a este local (Bubble sort)
-	for (unsigned int i=0 ; i < postos.size() ; i++){
-		swapOccured = false;
-		for(unsigned int j=0 ; j<postos.size()-1-i ; j++){
-			if (getDistLocais(nomeLocal,postos.at(j+1)->getLocal()->getNome()) < getDistLocais(nomeLocal,postos.at(j)->getLocal()->getNome())){
-				// Trocar elementos
-				temp = postos.at(j);
-				postos.at(j) = postos.at(j+1);
-				postos.at(j+1) = temp;
-				swapOccured = true;	// Ocorreu uma troca
-			}
+	int indiceLocal = findLocal(nomeLocal);
+	if (indiceLocal == -1)
+		return;
+
+	// A ordem dos postos por distancia a cada local e calculada uma unica vez, ao abrir os ficheiros
+	postos = rankingsPostos.at(indiceLocal);
+}
+
+void ProtecaoCivil::gravar(){
+	// Escrever no ficheiro info. sobre os postos (num ficheiro temporario, que so substitui o original depois de completo)
+	FicheiroAtomico ficheiroNovoPostos(ficheiroPostos);
+
+	// Escrever no ficheiro a info. de todos os postos (formatada num buffer e escrita em blocos grandes)
+	{
+		BufferEscrita buf(ficheiroNovoPostos.getStream());
+		for (unsigned int i=0 ; i<postos.size() ; i++){
+			postos.at(i)->serializar(buf);
+			if(i != postos.size() - 1)	// So muda de linha se nao for o ultimo elemento do vec.
+				buf << '\n';
 		}
-		if (!swapOccured)	// Nao houve nenhuma troca, vetor ja esta ordenado!
-			break;
 	}
+
+	// Substituir o ficheiro de postos
+	ficheiroNovoPostos.confirmar();
+
+
+
+	// Escrever no ficheiro info. sobre os acidentes
+	FicheiroAtomico ficheiroNovoAcidentes(ficheiroAcidentes);
+
+	// Escrever no ficheiro a info. de todos os acidentes (formatada num buffer e escrita em blocos grandes)
+	{
+		BufferEscrita buf(ficheiroNovoAcidentes.getStream());
+		for (unsigned int i=0 ; i<acidentes.size() ; i++){
+			acidentes.at(i)->serializar(buf);
+			if(i != acidentes.size() - 1)	// So muda de linha se nao for o ultimo elemento do vec.
+				buf << '\n';
+		}
+	}
+
+	// Substituir o ficheiro de acidentes. A partir deste ponto os segmentos pertencem a uma base antiga e seriam ignorados ao abrir
+	ficheiroNovoAcidentes.confirmar();
+
+	// Os segmentos de checkpoint ja estao incluidos nos ficheiros
+	apagarSegmentos();
+	postosAlterados.clear();
+	acidentesAbertos.clear();
+	acidentesFechados.clear();
 }
 
-void ProtecaoCivil::gravar() const{
-	// Escrever no ficheiro info. sobre os postos
-	std::ofstream ostr;
+void ProtecaoCivil::apagarSegmentos(){
+	for (unsigned int i=numSegmentos ; i>0 ; i--){
+		std::remove(SegmentoCheckpoint::nomeFicheiro(ficheiroAcidentes, i).c_str());
+	}
+	numSegmentos = 0;
+	FicheiroAtomico::sincronizarDiretorio(ficheiroAcidentes);
+}
 
-	ostr.open(ficheiroPostos);	// Abrir o ficheiro em modo de escrita
+void ProtecaoCivil::marcarPostosAlterados(const Acidente* acidente){
+	// Os meios destes postos acabaram de mudar: o mapa de cobertura so olha para eles
+	std::vector<Atribuicao> atribuicoes = acidente->getAtribuicoes();
+	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
+		postosAlterados.insert(atribuicoes.at(i).getPostoId());
+		std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(atribuicoes.at(i).getPostoId());
+		if (it != indicePostos.end())
+			cobertura.atualizar(it->second);
+	}
+}
 
-	// Veficar se não houve erro ao abrir o ficheiro
-	if(!ostr.is_open())
-		throw LocalidadeInexistente("Falha ao abrir o ficheiro \"" + ficheiroPostos + "\" ao guardar o estado atual dos postos da Protecao Civil.");
+unsigned long long ProtecaoCivil::registarAlteracao(RegistoAlteracao::Tipo tipo, const Acidente* acidente, const std::vector<Atribuicao> &atribuicoes, bool aguardar){
+	if (!escritor)
+		return 0;		// Os ficheiros ainda nao foram abertos
 
-	// Escrever no ficheiro a info. de todos os postos
-	for (unsigned int i=0 ; i<postos.size() ; i++){
-		postos.at(i)->printSimplifiedInfo(ostr);
-		if(i != postos.size() - 1)	// So muda de linha se nao for o ultimo elemento do vec.
-			ostr << '\n';
+	// Estado final de cada posto envolvido (cada posto uma unica vez)
+	std::set<unsigned int> idsPostos;
+	std::vector<std::string> linhasPostos;
+	for (unsigned int i=0 ; i<atribuicoes.size() ; i++){
+		std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(atribuicoes.at(i).getPostoId());
+		if (it == indicePostos.end() || !idsPostos.insert(it->first).second)
+			continue;
+
+		std::ostringstream linha;
+		{
+			BufferEscrita buf(linha, 1 << 8);
+			it->second->serializar(buf);
+		}
+		linhasPostos.push_back(linha.str());
+	}
+
+	// Entrada do acidente declarado (ou terminado, para que possa ser arquivado ao recuperar)
+	std::ostringstream entrada;
+	if (tipo != RegistoAlteracao::POSTOS_ALTERADOS){
+		BufferEscrita buf(entrada, 1 << 10);
+		acidente->serializar(buf);
 	}
 
-	// Fechar a stream
-	ostr.close();
+	// O registo e imutavel: a thread de escrita nao partilha nada com o estado da Protecao Civil
+	return escritor->submeter(std::make_shared<const RegistoAlteracao>(tipo, (acidente ? acidente->getNumOcorrencia() : 0), entrada.str(), linhasPostos), aguardar);
+}
 
+void ProtecaoCivil::checkpoint(){
+	// Os acidentes terminados tem de estar no arquivo antes de o diario ser reiniciado
+	arquivo.sincronizar();
 
+	// Nada mudou desde o ultimo checkpoint
+	if (getNumAlteracoesPendentes() == 0){
+		ultimoCheckpoint = std::chrono::steady_clock::now();
+		return;
+	}
 
-	// Escrever no ficheiro info. sobre os acidentes
-	ostr.open(ficheiroAcidentes);	// Abrir o ficheiro em modo de escrita
+	// Reunir apenas o que mudou: o custo do checkpoint depende do numero de alteracoes e nao do tamanho da base
+	std::vector<const Posto*> postosSegmento;
+	for (std::set<unsigned int>::const_iterator it = postosAlterados.begin() ; it != postosAlterados.end() ; it++){
+		std::map<unsigned int, Posto*>::const_iterator posto = indicePostos.find(*it);
+		if (posto != indicePostos.end())
+			postosSegmento.push_back(posto->second);
+	}
 
-	// Verificar se não houve erro abrir o ficheiro
-	if(!ostr.is_open())
-		throw LocalidadeInexistente("Falha ao abrir o ficheiro \"" + ficheiroPostos + "\" ao guardar o estado atual dos acidentes ao abrigo da Protecao Civil.");
+	std::vector<unsigned int> fechadosSegmento(acidentesFechados.begin(), acidentesFechados.end());
 
-	// Escrever no ficheiro a info. de todos os acidentes
-	for (unsigned int i=0 ; i<acidentes.size() ; i++){
-		acidentes.at(i)->printSimplifiedInfo(ostr);
-		if(i != acidentes.size() - 1)	// So muda de linha se nao for o ultimo elemento do vec.
-			ostr << '\n';
+	std::vector<const Acidente*> abertosSegmento;
+	for (std::map<unsigned int, const Acidente*>::const_iterator it = acidentesAbertos.begin() ; it != acidentesAbertos.end() ; it++){
+		abertosSegmento.push_back(it->second);
 	}
 
-	// Fechar a stream
-	ostr.close();
+	// O segmento inclui todos os registos ja enviados para o diario
+	if (escritor)
+		seqDiario = escritor->getUltimoSubmetido();
+
+	// Escrever o segmento de forma atomica; em caso de falha as alteracoes continuam pendentes
+	SegmentoCheckpoint::escrever(SegmentoCheckpoint::nomeFicheiro(ficheiroAcidentes, numSegmentos + 1), assinaturaBase, seqDiario, postosSegmento, fechadosSegmento, abertosSegmento);
+	numSegmentos++;
+
+	// As alteracoes do diario estao agora no segmento
+	if (escritor)
+		escritor->reiniciar();
+
+	postosAlterados.clear();
+	acidentesAbertos.clear();
+	acidentesFechados.clear();
+	ultimoCheckpoint = std::chrono::steady_clock::now();
+}
+
+bool ProtecaoCivil::checkpointPeriodico(){
+	std::chrono::steady_clock::duration decorrido = std::chrono::steady_clock::now() - ultimoCheckpoint;
+
+	if (getNumAlteracoesPendentes() == 0)
+		return false;
+	if (getNumAlteracoesPendentes() < LIMITE_ALTERACOES && decorrido < std::chrono::seconds(INTERVALO_CHECKPOINT))
+		return false;
+
+	checkpoint();
+	return true;
+}
+
+unsigned int ProtecaoCivil::getNumAlteracoesPendentes() const{
+	return postosAlterados.size() + acidentesAbertos.size() + acidentesFechados.size();
 }
 
 
 const Local * ProtecaoCivil::getLocal(const std::string &nomeLocal) const{
 	// Procurar o local
-	for(unsigned int i=0 ; i<locais.size() ; i++){
-		if(locais.at(i).getNome() == nomeLocal){		// Encontrado!
-			return &(locais.at(i));
-		}
-	}
+	int indiceLocal = findLocal(nomeLocal);
 
 	// Local nao foi encontrado
-	return NULL;
+	if (indiceLocal == -1)
+		return NULL;
+
+	return &(locais.at(indiceLocal));
+}
+
+const Posto * ProtecaoCivil::getPosto(unsigned int id) const{
+	std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(id);
+	if (it == indicePostos.end())
+		return NULL;
+
+	return it->second;
+}
+
+const std::vector<Local> & ProtecaoCivil::getLocais() const{
+	return locais;
+}
+
+const std::vector<Posto*> & ProtecaoCivil::getRankingPostos(unsigned int indiceLocal) const{
+	return rankingsPostos.at(indiceLocal);
 }
 
 unsigned int ProtecaoCivil::getMaxNumOcorrencia() const{
@@ -963,15 +1300,128 @@ unsigned int ProtecaoCivil::getMaxNumOcorrencia() const{
 	return max;
 }
 
-void ProtecaoCivil::retornarAtribuicao(const Atribuicao & atribuicao){
-	// Procurar pelo posto de onde originam os meios desta atribuicao
-	Posto* posto;
-	for (unsigned int i=0 ; i<postos.size() ; i++){
-		if (postos.at(i)->getId()==atribuicao.getPostoId()){
-			posto = postos.at(i);
-			break;
+std::vector<Acidente*> ProtecaoCivil::regressarMeios(const Atribuicao & atribuicao){
+	std::vector<Acidente*> reforcados = retornarAtribuicao(atribuicao);
+
+	// O novo estado do posto fica no diario (os acidentes reforcados ja foram registados)
+	registarAlteracao(RegistoAlteracao::POSTOS_ALTERADOS, NULL, std::vector<Atribuicao>(1, atribuicao));
+	return reforcados;
+}
+
+/**
+ * @brief Reserva ou devolve os meios de um movimento no seu posto de origem
+ * @param posto - Posto de origem
+ * @param movimento - Movimento
+ * @param reservar - true para reservar os meios (tudo ou nada) e false para os devolver
+ * @return Retorna true caso a reserva tenha sido feita (ou os meios devolvidos) e false caso o posto não tenha os meios
+ */
+static bool reservarMovimento(Posto* posto, const MovimentoMeios &movimento, bool reservar){
+	Bombeiros* postoBombeiros = dynamic_cast<Bombeiros*>(posto);
+	if (!reservar){
+		posto->addSocorristas(movimento.socorristas);
+		if (!postoBombeiros)
+			posto->addVeiculos(movimento.veiculos);
+		else if (movimento.recurso == ResultadoDespacho::AUTOTANQUES)
+			postoBombeiros->addAutotanques(movimento.veiculos);
+		else
+			postoBombeiros->addAmbulancias(movimento.veiculos);
+		return true;
+	}
+
+	if (!postoBombeiros)
+		return posto->reservar(movimento.veiculos, movimento.socorristas);
+	if (movimento.recurso == ResultadoDespacho::AUTOTANQUES)
+		return postoBombeiros->reservarAutotanques(movimento.veiculos, movimento.socorristas);
+	return postoBombeiros->reservarAmbulancias(movimento.veiculos, movimento.socorristas);
+}
+
+/**
+ * @brief Verifica se os meios de um movimento podem passar de um posto para outro
+ * @param origem - Posto de origem
+ * @param destino - Posto de destino
+ * @param movimento - Movimento
+ * @return Retorna true caso os postos sejam do mesmo tipo, com o mesmo tipo de veículo, forneçam o recurso e os socorristas sejam as equipas dos veículos
+ */
+static bool movimentoCompativel(const Posto* origem, const Posto* destino, const MovimentoMeios &movimento){
+	if (origem->getTipoPosto() != destino->getTipoPosto() || movimento.veiculos == 0)
+		return false;
+	if (const Inem* origemInem = dynamic_cast<const Inem*>(origem)){
+		if (movimento.recurso != ResultadoDespacho::EQUIPAS_MEDICAS || origemInem->getTipoVeiculo() != dynamic_cast<const Inem*>(destino)->getTipoVeiculo())
+			return false;
+	}
+	else if (const Policia* origemPolicia = dynamic_cast<const Policia*>(origem)){
+		if (movimento.recurso != ResultadoDespacho::EQUIPAS_POLICIAIS || origemPolicia->getTipoVeiculo() != dynamic_cast<const Policia*>(destino)->getTipoVeiculo())
+			return false;
+	}
+	else if (movimento.recurso != ResultadoDespacho::AUTOTANQUES && movimento.recurso != ResultadoDespacho::EQUIPAS_MEDICAS)
+		return false;
+	return movimento.socorristas == movimento.veiculos * OtimizadorDespacho::getTripulacao(origem, movimento.recurso);
+}
+
+bool ProtecaoCivil::aplicarMovimentos(const std::vector<MovimentoMeios> &movimentos, std::vector<MovimentoMeios>* invalidos){
+	// Validar todos os movimentos antes de tocar em qualquer posto; os invalidos sao ignorados
+	std::vector<MovimentoMeios> validos;
+	std::vector<Posto*> origens, destinos;
+	for (unsigned int i=0 ; i<movimentos.size() ; i++){
+		const MovimentoMeios &movimento = movimentos.at(i);
+		std::map<unsigned int, Posto*>::const_iterator origem = indicePostos.find(movimento.origem);
+		std::map<unsigned int, Posto*>::const_iterator destino = indicePostos.find(movimento.destino);
+
+		// Os meios so podem ir de um posto existente para outro que os use da mesma forma (mesmo tipo de posto e veiculo), cada veiculo com a sua equipa completa
+		if (origem == indicePostos.end() || destino == indicePostos.end() || origem == destino || !movimentoCompativel(origem->second, destino->second, movimento)){
+			if (invalidos != NULL)
+				invalidos->push_back(movimento);
+			continue;
 		}
+		validos.push_back(movimento);
+		origens.push_back(origem->second);
+		destinos.push_back(destino->second);
+	}
+
+	if (validos.empty())
+		return true;
+
+	// Reservar nas origens; se alguma falhar, devolver o que ja foi reservado
+	for (unsigned int i=0 ; i<validos.size() ; i++){
+		if (!reservarMovimento(origens.at(i), validos.at(i), true)){
+			while (i > 0){
+				i--;
+				reservarMovimento(origens.at(i), validos.at(i), false);
+			}
+			return false;
+		}
+	}
+
+	// Os meios reservados chegam aos destinos
+	std::vector<Atribuicao> postosEnvolvidos;
+	for (unsigned int i=0 ; i<validos.size() ; i++){
+		reservarMovimento(destinos.at(i), validos.at(i), false);
+		postosAlterados.insert(validos.at(i).origem);
+		postosAlterados.insert(validos.at(i).destino);
+		postosEnvolvidos.push_back(Atribuicao(validos.at(i).origem, 0, 0, ""));
+		postosEnvolvidos.push_back(Atribuicao(validos.at(i).destino, 0, 0, ""));
 	}
+	registarAlteracao(RegistoAlteracao::POSTOS_ALTERADOS, NULL, postosEnvolvidos);
+
+	for (unsigned int i=0 ; i<destinos.size() ; i++){
+		reforcarPendentes(destinos.at(i));
+	}
+
+	// So agora os meios de cada posto envolvido estao no seu estado final
+	for (unsigned int i=0 ; i<validos.size() ; i++){
+		cobertura.atualizar(origens.at(i));
+		cobertura.atualizar(destinos.at(i));
+	}
+	return true;
+}
+
+std::vector<Acidente*> ProtecaoCivil::retornarAtribuicao(const Atribuicao & atribuicao){
+	// Procurar pelo posto de onde originam os meios desta atribuicao
+	std::map<unsigned int, Posto*>::const_iterator it = indicePostos.find(atribuicao.getPostoId());
+	if (it == indicePostos.end())
+		return std::vector<Acidente*>();		// O posto ja nao existe, nao ha para onde retornar os meios
+	Posto* posto = it->second;
+	postosAlterados.insert(posto->getId());
 
 	// Posto da Policia
 	if (posto->getTipoPosto() == "Policia"){
@@ -1000,9 +1450,145 @@ void ProtecaoCivil::retornarAtribuicao(const Atribuicao & atribuicao){
 			postoBombeiros->addAmbulancias(atribuicao.getNumVeiculos());
 		}
 	}
+
+	// Os meios retornados vao de imediato para os acidentes que estao a espera deles; o que sobrar conta para a cobertura
+	std::vector<Acidente*> reforcados = reforcarPendentes(posto);
+	cobertura.atualizar(posto);
+	return reforcados;
 }
 
+void ProtecaoCivil::atualizarPendente(Acidente* acidente){
+	ResultadoDespacho resultado;
+	resultado.atribuicoes = acidente->getAtribuicoes();
+	calcularFalta(acidente, resultado);
+	pendentes.atualizar(acidente, resultado);
+}
 
+std::vector<Acidente*> ProtecaoCivil::reforcarPendentes(Posto* posto){
+	std::vector<Acidente*> reforcados;
+	if (pendentes.getNumPendentes() == 0)
+		return reforcados;
 
+	// Os autotanques primeiro: as ambulancias dos bombeiros so podem sair com os bombeiros que sobrarem
+	const ResultadoDespacho::TipoRecurso recursos[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+	for (unsigned int r=0 ; r<3 ; r++){
+		unsigned int oferta = OtimizadorDespacho::getOferta(posto, recursos[r]);
+		if (oferta == 0)
+			continue;
+
+		// Apenas os acidentes a espera deste recurso, pela ordem da fila (gravidade e antiguidade), ate acabar a oferta do posto
+		pendentes.distribuir(recursos[r], oferta, [&](Acidente* acidente, unsigned int unidades){
+			if (!OtimizadorDespacho::atribuir(posto, acidente, recursos[r], unidades))
+				return;
+			atualizarPendente(acidente);
+			if (std::find(reforcados.begin(), reforcados.end(), acidente) == reforcados.end())
+				reforcados.push_back(acidente);
+		});
+	}
+	if (reforcados.empty())
+		return reforcados;
+
+	postosAlterados.insert(posto->getId());
+	for (unsigned int i=0 ; i<reforcados.size() ; i++){
+		Acidente* acidente = reforcados.at(i);
+
+		// Um acidente ja gravado e substituido no proximo checkpoint (retirado e declarado de novo)
+		if (acidentesAbertos.find(acidente->getNumOcorrencia()) == acidentesAbertos.end())
+			acidentesFechados.insert(acidente->getNumOcorrencia());
+		acidentesAbertos[acidente->getNumOcorrencia()] = acidente;
+
+		registarAlteracao(RegistoAlteracao::ACIDENTE_DECLARADO, acidente, acidente->getAtribuicoes());
+	}
+	return reforcados;
+}
+
+const IndiceAcidentes & ProtecaoCivil::getIndiceAcidentes() const{
+	return indiceAcidentes;
+}
+
+std::vector<Acidente*> ProtecaoCivil::getAcidentesFiltro(const BitmapComprimido &filtro) const{
+	std::vector<Acidente*> resultado;
+	resultado.reserve(filtro.cardinalidade());
 
+	// Apenas as linhas do filtro sao visitadas (as dos acidentes terminados nao tem acidente em memoria)
+	filtro.percorrer([this, &resultado](unsigned int linha){
+		Acidente* acidente = indiceAcidentes.getAcidente(linha);
+		if (acidente != NULL)
+			resultado.push_back(acidente);
+	});
+
+	return resultado;
+}
+
+std::vector<unsigned int> ProtecaoCivil::getHistoricoFiltro(const BitmapComprimido &filtro) const{
+	std::vector<unsigned int> resultado;
+
+	filtro.percorrer([this, &resultado](unsigned int linha){
+		unsigned int linhaHistorico = indiceAcidentes.getLinhaHistorico(linha);
+		if (linhaHistorico != IndiceAcidentes::SEM_LINHA)
+			resultado.push_back(linhaHistorico);
+	});
+
+	return resultado;
+}
+
+const FilaPendentes & ProtecaoCivil::getPendentes() const{
+	return pendentes;
+}
+
+const MapaCobertura & ProtecaoCivil::getCobertura() const{
+	return cobertura;
+}
 
+const OtimizadorDespacho & ProtecaoCivil::getOtimizador() const{
+	return otimizador;
+}
+
+const HistoricoAcidentes & ProtecaoCivil::getHistorico() const{
+	return historico;
+}
+
+std::vector<RegistoArquivo> ProtecaoCivil::getArquivoNumero(unsigned int numOcorrencia) const{
+	return arquivo.procurarNumero(numOcorrencia);
+}
+
+std::vector<RegistoArquivo> ProtecaoCivil::getArquivoIntervalo(const Date &inicio, const Date &fim) const{
+	return arquivo.procurarIntervalo(inicio, fim);
+}
+
+std::shared_ptr<const Acidente> ProtecaoCivil::getAcidenteArquivado(unsigned int numOcorrencia) const{
+	if (!leitorArquivo)
+		return std::shared_ptr<const Acidente>();		// Os ficheiros ainda nao foram abertos
+
+	return leitorArquivo->obter(numOcorrencia);
+}
+
+unsigned long long ProtecaoCivil::exportarColunas(const std::string &prefixo) const{
+	ExportadorColunar exportador(prefixo);
+
+	// Acidentes em decurso, convertidos para descritores a partir da sua entrada no ficheiro de acidentes
+	for (unsigned int i=0 ; i<acidentes.size() ; i++){
+		std::ostringstream entrada;
+		{
+			BufferEscrita buf(entrada, 1 << 10);
+			acidentes.at(i)->serializar(buf);
+		}
+		const std::string texto = entrada.str();
+		const char* pos = texto.data();
+		DescritorAcidente descritor;
+		if (DescritorAcidente::ler(pos, pos + texto.size(), descritor))
+			exportador.adicionar(acidentes.at(i)->getNumOcorrencia(), 0, false, descritor);
+	}
+
+	// Acidentes arquivados, lidos um bloco de cada vez
+	std::vector<ReferenciaBloco> blocos = arquivo.getBlocos();
+	for (unsigned int i=0 ; i<blocos.size() ; i++){
+		std::vector<RegistoArquivo> registos = arquivo.lerBloco(blocos.at(i));
+		for (unsigned int j=0 ; j<registos.size() ; j++){
+			exportador.adicionar(registos.at(j).numOcorrencia, registos.at(j).seq, true, registos.at(j).descritor);
+		}
+	}
+
+	exportador.concluir();
+	return exportador.getNumAcidentes();
+}
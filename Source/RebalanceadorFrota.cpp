@@ -0,0 +1,304 @@
+#include "RebalanceadorFrota.h"
+#include <cmath>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include "OtimizadorDespacho.h"
+
+static const ResultadoDespacho::TipoRecurso RECURSOS[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+static const unsigned int NUM_RECURSOS_POSTOS = 3;
+
+/**
+ * @brief Verifica se dois postos podem trocar meios entre si
+ * @param posto1 - Posto
+ * @param posto2 - Posto
+ * @return Retorna true caso sejam do mesmo tipo e, nos postos do Inem e da Polícia, tenham o mesmo tipo de veículo (e portanto a mesma tripulação)
+ */
+static bool compativeis(const Posto* posto1, const Posto* posto2){
+	if (posto1->getTipoPosto() != posto2->getTipoPosto())
+		return false;
+	if (const Inem* postoInem = dynamic_cast<const Inem*>(posto1))
+		return postoInem->getTipoVeiculo() == dynamic_cast<const Inem*>(posto2)->getTipoVeiculo();
+	if (const Policia* postoPolicia = dynamic_cast<const Policia*>(posto1))
+		return postoPolicia->getTipoVeiculo() == dynamic_cast<const Policia*>(posto2)->getTipoVeiculo();
+	return true;
+}
+
+/**
+ * @brief Transfere, numa tabela de capacidades, um veículo de um recurso e a sua equipa de um posto para outro
+ * @param capacidades - Tabela de capacidades
+ * @param origem - Posto de onde sai o veículo
+ * @param destino - Posto para onde vai o veículo
+ * @param recurso - Tipo de recurso
+ */
+static void mover(TabelaCapacidades &capacidades, const Posto* origem, const Posto* destino, ResultadoDespacho::TipoRecurso recurso){
+	unsigned int tripulacao = OtimizadorDespacho::getTripulacao(origem, recurso);
+
+	TabelaCapacidades::Capacidade saida = capacidades.getCapacidade(origem);
+	TabelaCapacidades::Capacidade entrada = capacidades.getCapacidade(destino);
+	saida.socorristas -= tripulacao;
+	entrada.socorristas += tripulacao;
+	saida.veiculos[recurso]--;
+	entrada.veiculos[recurso]++;
+	capacidades.definirCapacidade(origem, saida);
+	capacidades.definirCapacidade(destino, entrada);
+}
+
+RebalanceadorFrota::Parametros::Parametros() : janela(200), maxVeiculos(4), reservaMinima(1), ganhoMinimo(1), intervalo(1000) {}
+
+RebalanceadorFrota::Proposta::Proposta() : distanciaAntes(0), distanciaDepois(0) {}
+
+RebalanceadorFrota::RebalanceadorFrota(const ProtecaoCivil &protecaoCivil, const Parametros &parametros)
+	: protecaoCivil(protecaoCivil), parametros(parametros), penalizacao(0), numMovimentosInvalidos(0), aTerminar(false) {
+	std::vector<unsigned int> ids = protecaoCivil.getCapacidades().getIdsPostos();
+	for (unsigned int i=0 ; i<ids.size() ; i++){
+		postos.push_back(protecaoCivil.getPosto(ids.at(i)));
+	}
+
+	// Uma unidade que nao existe conta como se viesse do dobro da maior distancia entre um local e um posto
+	const std::vector<Local> &locais = protecaoCivil.getLocais();
+	for (unsigned int l=0 ; l<locais.size() ; l++){
+		for (unsigned int p=0 ; p<postos.size() ; p++){
+			penalizacao = std::max(penalizacao, 2 * OtimizadorDespacho::distancia(postos.at(p), locais.at(l)));
+		}
+	}
+	if (penalizacao == 0)
+		penalizacao = 1;
+
+	ProcuraLocal vazia;
+	vazia.unidades = vazia.acidentes = 0;
+	procura.assign(locais.size(), std::vector<ProcuraLocal>(ResultadoDespacho::NUM_RECURSOS, vazia));
+}
+
+RebalanceadorFrota::~RebalanceadorFrota(){
+	parar();
+}
+
+void RebalanceadorFrota::registarProcura(const Acidente* acidente){
+	int indiceLocal = protecaoCivil.findLocal(acidente->getLocal()->getNome());
+	if (indiceLocal == -1)
+		return;
+
+	AcidenteRecente recente;
+	recente.indiceLocal = indiceLocal;
+	for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+		recente.unidades[r] = OtimizadorDespacho::getProcura(acidente, (ResultadoDespacho::TipoRecurso)r);
+	}
+
+	std::lock_guard<std::mutex> lock(trinco);
+	recentes.push_back(recente);
+	for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+		if (recente.unidades[r] == 0)
+			continue;
+		procura[recente.indiceLocal][r].unidades += recente.unidades[r];
+		procura[recente.indiceLocal][r].acidentes++;
+	}
+
+	// O acidente mais antigo sai da janela
+	if (recentes.size() > parametros.janela){
+		const AcidenteRecente &antigo = recentes.front();
+		for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+			if (antigo.unidades[r] == 0)
+				continue;
+			procura[antigo.indiceLocal][r].unidades -= antigo.unidades[r];
+			procura[antigo.indiceLocal][r].acidentes--;
+		}
+		recentes.pop_front();
+	}
+}
+
+double RebalanceadorFrota::calcularCusto(const TabelaCapacidades &capacidades, unsigned int indiceLocal, ResultadoDespacho::TipoRecurso recurso, const ProcuraLocal &procuraLocal, double &raio) const{
+	// As unidades que o despacho guloso enviaria a um acidente tipico deste local: as mais proximas, pela ordem dos postos
+	unsigned int porAcidente = (procuraLocal.unidades + procuraLocal.acidentes - 1) / procuraLocal.acidentes;
+	const Local &local = protecaoCivil.getLocais().at(indiceLocal);
+	const std::vector<Posto*> &ranking = protecaoCivil.getRankingPostos(indiceLocal);
+
+	double soma = 0;
+	unsigned int emFalta = porAcidente;
+	raio = std::numeric_limits<double>::infinity();
+	for (unsigned int i=0 ; i<ranking.size() && emFalta > 0 ; i++){
+		unsigned int oferta = capacidades.getOferta(ranking.at(i), recurso);
+		if (oferta == 0)
+			continue;
+
+		unsigned int usadas = std::min(oferta, emFalta);
+		double distanciaPosto = OtimizadorDespacho::distancia(ranking.at(i), local);
+		soma += usadas * distanciaPosto;
+		emFalta -= usadas;
+		if (emFalta == 0)
+			raio = distanciaPosto;
+	}
+	soma += emFalta * penalizacao;
+
+	return procuraLocal.unidades * soma / porAcidente;
+}
+
+RebalanceadorFrota::Proposta RebalanceadorFrota::calcularProposta(const TabelaCapacidades &capacidades, const Procura &procuraAtual) const{
+	Proposta resultado;
+	TabelaCapacidades atual = capacidades;	// So as paginas dos postos movidos sao copiadas
+	const std::vector<Local> &locais = protecaoCivil.getLocais();
+
+	// Custo e raio de cada local para cada recurso, com as capacidades atuais
+	std::vector< std::vector<double> > custos(locais.size(), std::vector<double>(ResultadoDespacho::NUM_RECURSOS, 0));
+	std::vector< std::vector<double> > raios(locais.size(), std::vector<double>(ResultadoDespacho::NUM_RECURSOS, 0));
+	double custoTotal = 0;
+	unsigned int unidadesTotal = 0;
+	for (unsigned int l=0 ; l<locais.size() ; l++){
+		for (unsigned int r=0 ; r<NUM_RECURSOS_POSTOS ; r++){
+			const ProcuraLocal &procuraLocal = procuraAtual.at(l).at(RECURSOS[r]);
+			if (procuraLocal.unidades == 0)
+				continue;
+			custos[l][RECURSOS[r]] = calcularCusto(atual, l, RECURSOS[r], procuraLocal, raios[l][RECURSOS[r]]);
+			custoTotal += custos[l][RECURSOS[r]];
+			unidadesTotal += procuraLocal.unidades;
+		}
+	}
+	if (unidadesTotal == 0)
+		return resultado;
+	resultado.distanciaAntes = custoTotal / unidadesTotal;
+
+	// Reducao do custo com um veiculo movido (ja aplicado em 'depois'): so mudam os locais para quem a origem ou o destino estao dentro do raio das unidades que usam.
+	// Nos postos de Bombeiros os socorristas sao partilhados, pelo que um autotanque movido tambem muda as ambulancias que podem sair, e vice-versa
+	auto recalcular = [&](const TabelaCapacidades &depois, const Posto* origem, const Posto* destino, ResultadoDespacho::TipoRecurso recurso, bool aplicar){
+		bool bombeiros = (dynamic_cast<const Bombeiros*>(origem) != NULL);
+		double ganho = 0;
+		for (unsigned int r=0 ; r<NUM_RECURSOS_POSTOS ; r++){
+			ResultadoDespacho::TipoRecurso afetado = RECURSOS[r];
+			if (afetado != recurso && !(bombeiros && afetado != ResultadoDespacho::EQUIPAS_POLICIAIS))
+				continue;
+
+			for (unsigned int l=0 ; l<locais.size() ; l++){
+				const ProcuraLocal &procuraLocal = procuraAtual.at(l).at(afetado);
+				if (procuraLocal.unidades == 0)
+					continue;
+				if (OtimizadorDespacho::distancia(origem, locais.at(l)) > raios[l][afetado] && OtimizadorDespacho::distancia(destino, locais.at(l)) >= raios[l][afetado])
+					continue;
+
+				double raio;
+				double custo = calcularCusto(depois, l, afetado, procuraLocal, raio);
+				ganho += custos[l][afetado] - custo;
+				if (aplicar){
+					custos[l][afetado] = custo;
+					raios[l][afetado] = raio;
+				}
+			}
+		}
+		return ganho;
+	};
+
+	// Movimentos gulosos, um veiculo de cada vez; um posto que recebe meios nao os envia na mesma proposta (e vice-versa),
+	// para que todas as origens tenham os meios antes de a proposta ser aplicada
+	std::vector<bool> recebe(postos.size(), false), envia(postos.size(), false);
+	for (unsigned int v=0 ; v<parametros.maxVeiculos ; v++){
+		double melhorGanho = parametros.ganhoMinimo;
+		int melhorOrigem = -1, melhorDestino = -1;
+		ResultadoDespacho::TipoRecurso melhorRecurso = ResultadoDespacho::AUTOTANQUES;
+
+		for (unsigned int o=0 ; o<postos.size() ; o++){
+			if (recebe.at(o))
+				continue;
+			for (unsigned int r=0 ; r<NUM_RECURSOS_POSTOS ; r++){
+				if (atual.getOferta(postos.at(o), RECURSOS[r]) <= parametros.reservaMinima)
+					continue;
+
+				for (unsigned int d=0 ; d<postos.size() ; d++){
+					if (d == o || envia.at(d) || !compativeis(postos.at(o), postos.at(d)))
+						continue;
+
+					TabelaCapacidades depois = atual;
+					mover(depois, postos.at(o), postos.at(d), RECURSOS[r]);
+					double ganho = recalcular(depois, postos.at(o), postos.at(d), RECURSOS[r], false);
+					if (ganho > melhorGanho){
+						melhorGanho = ganho;
+						melhorOrigem = o;
+						melhorDestino = d;
+						melhorRecurso = RECURSOS[r];
+					}
+				}
+			}
+		}
+		if (melhorOrigem == -1)
+			break;	// Nenhum movimento reduz o custo o suficiente
+
+		const Posto* origem = postos.at(melhorOrigem);
+		const Posto* destino = postos.at(melhorDestino);
+		TabelaCapacidades depois = atual;
+		mover(depois, origem, destino, melhorRecurso);
+		custoTotal -= recalcular(depois, origem, destino, melhorRecurso, true);
+		atual = depois;
+		envia[melhorOrigem] = true;
+		recebe[melhorDestino] = true;
+
+		// Os veiculos entre os mesmos postos ficam num unico movimento
+		unsigned int tripulacao = OtimizadorDespacho::getTripulacao(origem, melhorRecurso);
+		unsigned int m = 0;
+		while (m < resultado.movimentos.size() && !(resultado.movimentos.at(m).origem == origem->getId() && resultado.movimentos.at(m).destino == destino->getId() && resultado.movimentos.at(m).recurso == melhorRecurso))
+			m++;
+		if (m == resultado.movimentos.size())
+			resultado.movimentos.push_back(MovimentoMeios(origem->getId(), destino->getId(), melhorRecurso, 0, 0));
+		resultado.movimentos.at(m).veiculos++;
+		resultado.movimentos.at(m).socorristas += tripulacao;
+	}
+
+	resultado.distanciaDepois = custoTotal / unidadesTotal;
+	return resultado;
+}
+
+RebalanceadorFrota::Proposta RebalanceadorFrota::calcularProposta(const TabelaCapacidades &capacidades) const{
+	Procura procuraAtual;
+	{
+		std::lock_guard<std::mutex> lock(trinco);
+		procuraAtual = procura;
+	}
+	return calcularProposta(capacidades, procuraAtual);
+}
+
+void RebalanceadorFrota::executar(){
+	std::unique_lock<std::mutex> lock(trinco);
+
+	while (!acordar.wait_for(lock, std::chrono::milliseconds(parametros.intervalo), [this](){ return aTerminar; })){
+		// Calcular sem o trinco, sobre uma copia da procura: o despacho continua a registar acidentes entretanto
+		Procura procuraAtual = procura;
+		lock.unlock();
+		Proposta nova = calcularProposta(protecaoCivil.getCapacidades(), procuraAtual);
+		lock.lock();
+
+		// Uma proposta anterior por aplicar foi calculada sobre capacidades mais antigas: e substituida
+		proposta = (nova.movimentos.empty() ? std::shared_ptr<const Proposta>() : std::make_shared<const Proposta>(nova));
+	}
+}
+
+void RebalanceadorFrota::iniciar(){
+	std::lock_guard<std::mutex> lock(trinco);
+	if (thread.joinable())
+		return;
+	aTerminar = false;
+	thread = std::thread(&RebalanceadorFrota::executar, this);
+}
+
+void RebalanceadorFrota::parar(){
+	{
+		std::lock_guard<std::mutex> lock(trinco);
+		aTerminar = true;
+	}
+	acordar.notify_one();
+	if (thread.joinable())
+		thread.join();
+}
+
+std::shared_ptr<const RebalanceadorFrota::Proposta> RebalanceadorFrota::obterProposta(){
+	std::lock_guard<std::mutex> lock(trinco);
+	std::shared_ptr<const Proposta> retirada;
+	retirada.swap(proposta);
+	return retirada;
+}
+
+void RebalanceadorFrota::registarMovimentosInvalidos(unsigned int num){
+	std::lock_guard<std::mutex> lock(trinco);
+	numMovimentosInvalidos += num;
+}
+
+unsigned int RebalanceadorFrota::getNumMovimentosInvalidos() const{
+	std::lock_guard<std::mutex> lock(trinco);
+	return numMovimentosInvalidos;
+}
@@ -0,0 +1,131 @@
+#include "RegioesDespacho.h"
+#include <algorithm>
+
+RegioesDespacho::RegioesDespacho(const std::vector<Local> &locais, const std::vector<Posto*> &postos, const std::vector< std::vector<Posto*> > &rankingsPostos, unsigned int lado)
+	: lado(lado == 0 ? 1 : lado), minX(0), minY(0), largura(1), altura(1), porTerminar(0), aTerminar(false) {
+
+	// Limites da grelha: as regioes cobrem apenas a zona onde ha locais
+	if (!locais.empty()){
+		unsigned int maxX = locais.at(0).getXcoord(), maxY = locais.at(0).getYcoord();
+		minX = maxX;
+		minY = maxY;
+		for (unsigned int i=1 ; i<locais.size() ; i++){
+			minX = std::min(minX, locais.at(i).getXcoord());
+			minY = std::min(minY, locais.at(i).getYcoord());
+			maxX = std::max(maxX, locais.at(i).getXcoord());
+			maxY = std::max(maxY, locais.at(i).getYcoord());
+		}
+		largura = maxX - minX + 1;
+		altura = maxY - minY + 1;
+	}
+
+	regiaoLocal.resize(locais.size());
+	locaisRegiao.resize(this->lado * this->lado);
+	for (unsigned int i=0 ; i<locais.size() ; i++){
+		regiaoLocal[i] = calcularRegiao(locais.at(i).getXcoord(), locais.at(i).getYcoord());
+		locaisRegiao[regiaoLocal[i]].push_back(i);
+	}
+
+	postosRegiao.resize(this->lado * this->lado);
+	for (unsigned int i=0 ; i<postos.size() ; i++){
+		postosRegiao[calcularRegiao(postos.at(i)->getLocal()->getXcoord(), postos.at(i)->getLocal()->getYcoord())].push_back(postos.at(i));
+	}
+
+	// As ordens de cada local sao os rankings ja calculados, separados pela regiao do posto
+	ordemRegiao.resize(locais.size());
+	ordemFora.resize(locais.size());
+	for (unsigned int i=0 ; i<locais.size() && i<rankingsPostos.size() ; i++){
+		const std::vector<Posto*> &ranking = rankingsPostos.at(i);
+		for (unsigned int j=0 ; j<ranking.size() ; j++){
+			const Local* localPosto = ranking.at(j)->getLocal();
+			if (calcularRegiao(localPosto->getXcoord(), localPosto->getYcoord()) == regiaoLocal[i])
+				ordemRegiao[i].push_back(ranking.at(j));
+			else
+				ordemFora[i].push_back(ranking.at(j));
+		}
+	}
+
+	// Um despachante por regiao com locais (so nessas pode haver acidentes)
+	tarefas.resize(this->lado * this->lado);
+	despachantes.resize(this->lado * this->lado);
+	for (unsigned int r=0 ; r<locaisRegiao.size() ; r++){
+		if (!locaisRegiao[r].empty())
+			despachantes[r] = std::thread(&RegioesDespacho::executarRegiao, this, r);
+	}
+}
+
+RegioesDespacho::~RegioesDespacho(){
+	{
+		std::lock_guard<std::mutex> lock(trinco);
+		aTerminar = true;
+	}
+	haTarefas.notify_all();
+	for (unsigned int r=0 ; r<despachantes.size() ; r++){
+		if (despachantes[r].joinable())
+			despachantes[r].join();
+	}
+}
+
+void RegioesDespacho::executarRegiao(unsigned int regiao){
+	std::unique_lock<std::mutex> lock(trinco);
+	while (true){
+		haTarefas.wait(lock, [this, regiao](){ return tarefas[regiao] || aTerminar; });
+		if (!tarefas[regiao])
+			return;	// A terminar, sem tarefas por executar
+
+		// A tarefa e executada sem o trinco: as regioes correm em simultaneo
+		std::function<void()> tarefa;
+		tarefa.swap(tarefas[regiao]);
+		lock.unlock();
+		tarefa();
+		lock.lock();
+
+		porTerminar--;
+		terminadas.notify_all();
+	}
+}
+
+void RegioesDespacho::executar(const std::vector< std::function<void()> > &tarefasRegioes){
+	std::unique_lock<std::mutex> lock(trinco);
+	for (unsigned int r=0 ; r<tarefasRegioes.size() && r<tarefas.size() ; r++){
+		if (!tarefasRegioes[r] || !despachantes[r].joinable())
+			continue;
+		tarefas[r] = tarefasRegioes[r];
+		porTerminar++;
+	}
+	haTarefas.notify_all();
+	terminadas.wait(lock, [this](){ return porTerminar == 0; });
+}
+
+unsigned int RegioesDespacho::calcularRegiao(unsigned int x, unsigned int y) const{
+	// Coordenadas fora da grelha ficam na regiao mais proxima
+	unsigned long long dx = (x < minX ? 0 : std::min(x - minX, largura - 1));
+	unsigned long long dy = (y < minY ? 0 : std::min(y - minY, altura - 1));
+	unsigned int coluna = dx * lado / largura;
+	unsigned int linha = dy * lado / altura;
+	return linha * lado + coluna;
+}
+
+unsigned int RegioesDespacho::getNumRegioes() const{
+	return lado * lado;
+}
+
+unsigned int RegioesDespacho::getRegiao(unsigned int indiceLocal) const{
+	return regiaoLocal.at(indiceLocal);
+}
+
+const std::vector<Posto*> & RegioesDespacho::getPostosRegiao(unsigned int regiao) const{
+	return postosRegiao.at(regiao);
+}
+
+const std::vector<unsigned int> & RegioesDespacho::getLocaisRegiao(unsigned int regiao) const{
+	return locaisRegiao.at(regiao);
+}
+
+const std::vector<Posto*> & RegioesDespacho::getOrdemRegiao(unsigned int indiceLocal) const{
+	return ordemRegiao.at(indiceLocal);
+}
+
+const std::vector<Posto*> & RegioesDespacho::getOrdemFora(unsigned int indiceLocal) const{
+	return ordemFora.at(indiceLocal);
+}
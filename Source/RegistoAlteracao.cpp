@@ -0,0 +1,199 @@
+#include "RegistoAlteracao.h"
+#include <fstream>
+#include <sstream>
+#include "Crc32c.h"
+#include "SegmentoCheckpoint.h"
+#include "Erro.h"
+
+RegistoAlteracao::RegistoAlteracao(Tipo tipo, unsigned int numOcorrencia, const std::string &acidente, const std::vector<std::string> &postos)
+	: tipo(tipo) , numOcorrencia(numOcorrencia) , acidente(acidente) , postos(postos) {}
+
+RegistoAlteracao::Tipo RegistoAlteracao::getTipo() const{
+	return tipo;
+}
+
+unsigned int RegistoAlteracao::getNumOcorrencia() const{
+	return numOcorrencia;
+}
+
+const std::string & RegistoAlteracao::getAcidente() const{
+	return acidente;
+}
+
+const std::vector<std::string> & RegistoAlteracao::getPostos() const{
+	return postos;
+}
+
+std::string RegistoAlteracao::getConteudo() const{
+	std::ostringstream texto;
+	{
+		BufferEscrita buf(texto, 1 << 10);
+
+		// Tipo, numero de ocorrencia e numero de postos
+		if (tipo == ACIDENTE_DECLARADO)
+			buf << 'D';
+		else if (tipo == ACIDENTE_TERMINADO)
+			buf << 'T';
+		else
+			buf << 'P';
+		buf << ' ' << numOcorrencia << ' ' << postos.size() << '\n';
+
+		// Estado final dos postos alterados
+		for (unsigned int i=0 ; i<postos.size() ; i++){
+			buf << postos.at(i) << '\n';
+		}
+
+		// Entrada do acidente declarado (ou terminado, para o arquivo)
+		if (tipo != POSTOS_ALTERADOS && !acidente.empty())
+			buf << acidente << '\n';
+	}
+
+	return texto.str();
+}
+
+void RegistoAlteracao::serializar(BufferEscrita &buf, unsigned long long seq) const{
+	std::string conteudo = getConteudo();
+
+	// O tamanho e o checksum (CRC32C) permitem detetar um registo cuja escrita foi interrompida
+	buf << "R " << seq << ' ' << conteudo.size() << ' ' << Crc32c::calcular(conteudo.data(), conteudo.size()) << '\n';
+	buf << conteudo;
+}
+
+bool RegistoAlteracao::lerCabecalho(const char* &pos, const char* fim, unsigned long long &seq, unsigned long long &tamanho, unsigned long long &checksum){
+	const char* fimLinha = pos;
+	while (fimLinha < fim && *fimLinha != '\n')
+		fimLinha++;
+	if (fimLinha >= fim)
+		return false;		// Cabecalho incompleto (ou fim do diario)
+
+	std::istringstream cabecalho(std::string(pos, fimLinha));
+	std::string marca;
+	if (!(cabecalho >> marca >> seq >> tamanho >> checksum) || marca != "R")
+		return false;
+
+	// O conteudo tem de estar completo
+	pos = fimLinha + 1;
+	return ((unsigned long long)(fim - pos) >= tamanho);
+}
+
+unsigned long long RegistoAlteracao::calcularChecksum(const char* conteudo, unsigned long long tamanho, unsigned int versao){
+	// Os diarios da versao 1 (anteriores ao CRC32C) usavam a assinatura FNV-1a dos segmentos
+	return (versao == 1 ? SegmentoCheckpoint::calcularAssinatura(conteudo, tamanho) : Crc32c::calcular(conteudo, tamanho));
+}
+
+bool RegistoAlteracao::registoIntegro(const char* pos, const char* fim, unsigned int versao){
+	unsigned long long seq, tamanho, checksum;
+	return (lerCabecalho(pos, fim, seq, tamanho, checksum) && calcularChecksum(pos, tamanho, versao) == checksum);
+}
+
+bool RegistoAlteracao::ler(const char* &pos, const char* fim, unsigned long long &seq, std::shared_ptr<const RegistoAlteracao> &registo, unsigned int versao){
+	// Cabecalho do registo e conteudo, que tem de estar completo e integro
+	const char* conteudo = pos;
+	unsigned long long tamanho, checksum;
+	if (!lerCabecalho(conteudo, fim, seq, tamanho, checksum))
+		return false;
+	const char* fimConteudo = conteudo + tamanho;
+	if (calcularChecksum(conteudo, tamanho, versao) != checksum){
+		// Apenas o ultimo registo pode ter ficado a meio de uma escrita, deixando lixo ou zeros no resto do diario:
+		// so um registo integro a seguir mostra que este esta corrompido
+		if (registoIntegro(fimConteudo, fim, versao))
+			throw DadosCorrompidos("Registo corrompido no diario (numero de sequencia " + std::to_string(seq) + ").");
+		return false;
+	}
+
+	// Tipo, numero de ocorrencia e numero de postos
+	const char* fimLinha = conteudo;
+	while (fimLinha < fimConteudo && *fimLinha != '\n')
+		fimLinha++;
+	std::istringstream descricao(std::string(conteudo, fimLinha));
+	char letraTipo;
+	unsigned int numOcorrencia, numPostos;
+	if (!(descricao >> letraTipo >> numOcorrencia >> numPostos))
+		return false;
+
+	Tipo tipo;
+	if (letraTipo == 'D')
+		tipo = ACIDENTE_DECLARADO;
+	else if (letraTipo == 'T')
+		tipo = ACIDENTE_TERMINADO;
+	else if (letraTipo == 'P')
+		tipo = POSTOS_ALTERADOS;
+	else
+		return false;
+
+	// Linhas dos postos
+	std::vector<std::string> postos;
+	const char* linha = (fimLinha < fimConteudo ? fimLinha + 1 : fimConteudo);
+	for (unsigned int i=0 ; i<numPostos ; i++){
+		fimLinha = linha;
+		while (fimLinha < fimConteudo && *fimLinha != '\n')
+			fimLinha++;
+		if (fimLinha >= fimConteudo)
+			return false;
+		postos.push_back(std::string(linha, fimLinha));
+		linha = fimLinha + 1;
+	}
+
+	// Entrada do acidente: o resto do conteudo, sem o '\n' final
+	std::string acidente;
+	if (tipo != POSTOS_ALTERADOS && linha < fimConteudo)
+		acidente = std::string(linha, fimConteudo - 1);
+
+	registo = std::make_shared<const RegistoAlteracao>(tipo, numOcorrencia, acidente, postos);
+	pos = fimConteudo;
+	return true;
+}
+
+std::string RegistoAlteracao::cabecalhoDiario(unsigned long long assinaturaBase){
+	std::ostringstream cabecalho;
+	cabecalho << "DIARIO V" << VERSAO_DIARIO << ' ' << assinaturaBase << '\n';
+	return cabecalho.str();
+}
+
+bool RegistoAlteracao::lerDiario(const std::string &ficheiro, unsigned long long &assinaturaBase, std::vector< std::pair<unsigned long long, std::shared_ptr<const RegistoAlteracao> > > &registos){
+	std::ifstream istr(ficheiro, std::ios::binary);
+	if(!istr.is_open())	// nao ha diario
+		return false;
+
+	std::ostringstream conteudo;
+	conteudo << istr.rdbuf();
+	istr.close();
+
+	const std::string texto = conteudo.str();
+	const char* pos = texto.data();
+	const char* fim = pos + texto.size();
+
+	// Cabecalho do diario
+	std::string::size_type fimCabecalho = texto.find('\n');
+	if (fimCabecalho == std::string::npos)
+		return false;
+	std::istringstream cabecalho(texto.substr(0, fimCabecalho));
+	std::string marca, campo;
+	if (!(cabecalho >> marca >> campo) || marca != "DIARIO")
+		return false;
+
+	// Os diarios da versao 1 nao indicam a versao: "DIARIO assinatura"
+	unsigned int versao = 1;
+	if (campo.size() > 1 && campo[0] == 'V'){
+		std::istringstream numero(campo.substr(1));
+		if (!(numero >> versao) || !(cabecalho >> assinaturaBase))
+			return false;
+	}
+	else {
+		std::istringstream numero(campo);
+		if (!(numero >> assinaturaBase))
+			return false;
+	}
+	if (versao > VERSAO_DIARIO)
+		throw DadosCorrompidos("O diario \"" + ficheiro + "\" tem a versao " + std::to_string(versao) + ", mais recente do que a suportada (" + std::to_string(VERSAO_DIARIO) + "): atualize o programa antes de o abrir.");
+	pos += fimCabecalho + 1;
+
+	// Ler os registos ate ao fim, ou ate ao primeiro que esteja truncado/corrompido (o resto do diario e descartado)
+	unsigned long long seq;
+	std::shared_ptr<const RegistoAlteracao> registo;
+	while (pos < fim && ler(pos, fim, seq, registo, versao)){
+		registos.push_back(std::make_pair(seq, registo));
+	}
+
+	return true;
+}
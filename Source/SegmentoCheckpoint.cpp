@@ -0,0 +1,163 @@
+#include "SegmentoCheckpoint.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include "BufferEscrita.h"
+#include "FicheiroAtomico.h"
+#include "Crc32c.h"
+#include "Erro.h"
+
+/**
+ * @brief Lê a próxima linha de um texto (sem '\n' nem '\r')
+ * @param pos - Posição atual no texto; no fim aponta para o início da linha seguinte
+ * @param fim - Fim do texto
+ * @return Retorna o conteúdo da linha
+ */
+static std::string lerLinha(const char* &pos, const char* fim){
+	const char* inicio = pos;
+	while (pos < fim && *pos != '\n')
+		pos++;
+	const char* fimLinha = pos;
+	if (pos < fim)
+		pos++;		// saltar o '\n'
+	if (fimLinha > inicio && *(fimLinha-1) == '\r')
+		fimLinha--;
+	return std::string(inicio, fimLinha);
+}
+
+/**
+ * @brief Lê uma linha de cabeçalho de secção, no formato "NOME valor"
+ * @param pos - Posição atual no texto; no fim aponta para o início da linha seguinte
+ * @param fim - Fim do texto
+ * @param nome - Nome esperado da secção
+ * @param valor - Variável onde é colocado o valor do cabeçalho
+ * @return Retorna true caso a linha seja o cabeçalho esperado e false caso contrário
+ */
+static bool lerCabecalho(const char* &pos, const char* fim, const std::string &nome, unsigned long long &valor){
+	std::string linha = lerLinha(pos, fim);
+	if (linha.compare(0, nome.size() + 1, nome + " ") != 0)
+		return false;
+
+	valor = std::strtoull(linha.c_str() + nome.size() + 1, NULL, 10);
+	return true;
+}
+
+std::string SegmentoCheckpoint::nomeFicheiro(const std::string &ficheiroAcidentes, unsigned int numero){
+	std::ostringstream nome;
+	nome << ficheiroAcidentes << ".seg" << numero;
+	return nome.str();
+}
+
+bool SegmentoCheckpoint::ler(const std::string &ficheiro, SegmentoCheckpoint &segmento){
+	std::ifstream istr(ficheiro, std::ios::binary);
+	if(!istr.is_open())	// o segmento nao existe
+		return false;
+
+	std::ostringstream conteudo;
+	conteudo << istr.rdbuf();
+	istr.close();
+
+	const std::string texto = conteudo.str();
+
+	// Um segmento so e valido se tiver sido escrito ate ao fim: a ultima linha e "FIM checksum"
+	std::string::size_type inicioFim = texto.rfind("FIM ");
+	if (inicioFim == std::string::npos || texto.empty() || texto[texto.size()-1] != '\n' || (inicioFim > 0 && texto[inicioFim-1] != '\n'))
+		return false;
+	unsigned long long checksum = std::strtoull(texto.c_str() + inicioFim + 4, NULL, 10);
+
+	// Um segmento completo e escrito de forma atomica: um checksum errado so pode ser corrupcao
+	if (Crc32c::calcular(texto.data(), inicioFim) != checksum)
+		throw DadosCorrompidos("O segmento de checkpoint \"" + ficheiro + "\" esta corrompido.");
+
+	const char* pos = texto.data();
+	const char* fim = pos + inicioFim;
+	unsigned long long num;
+
+	segmento = SegmentoCheckpoint();
+
+	// Base sobre a qual o segmento foi escrito
+	if (!lerCabecalho(pos, fim, "SEGMENTO", segmento.assinaturaBase))
+		return false;
+
+	// Ultimo registo do diario incluido no segmento
+	if (!lerCabecalho(pos, fim, "DIARIO", segmento.seqDiario))
+		return false;
+
+	// Postos cuja capacidade mudou
+	if (!lerCabecalho(pos, fim, "POSTOS", num))
+		return false;
+	for (unsigned long long i=0 ; i<num ; i++){
+		if (pos >= fim)
+			return false;
+		segmento.postos.push_back(DescritorPosto::ler(lerLinha(pos, fim)));
+	}
+
+	// Acidentes terminados
+	if (!lerCabecalho(pos, fim, "FECHADOS", num))
+		return false;
+	for (unsigned long long i=0 ; i<num ; i++){
+		if (pos >= fim)
+			return false;
+		segmento.acidentesFechados.push_back(std::strtoul(lerLinha(pos, fim).c_str(), NULL, 10));
+	}
+
+	// Acidentes declarados
+	if (!lerCabecalho(pos, fim, "ABERTOS", num))
+		return false;
+	for (unsigned long long i=0 ; i<num ; i++){
+		if (pos >= fim)
+			return false;
+		unsigned int numOcorrencia = std::strtoul(lerLinha(pos, fim).c_str(), NULL, 10);
+
+		DescritorAcidente descritor;
+		if (!DescritorAcidente::ler(pos, fim, descritor))
+			return false;
+		segmento.acidentesAbertos.push_back(std::make_pair(numOcorrencia, descritor));
+	}
+
+	// Todo o conteudo tem de ter sido lido
+	return (pos == fim);
+}
+
+void SegmentoCheckpoint::escrever(const std::string &ficheiro, unsigned long long assinaturaBase, unsigned long long seqDiario, const std::vector<const Posto*> &postos, const std::vector<unsigned int> &acidentesFechados, const std::vector<const Acidente*> &acidentesAbertos){
+	// O conteudo e preparado em memoria para que o checksum seja calculado antes da escrita
+	std::ostringstream conteudo;
+	{
+		BufferEscrita buf(conteudo, 1 << 16);
+
+		buf << "SEGMENTO " << assinaturaBase << '\n';
+		buf << "DIARIO " << seqDiario << '\n';
+
+		buf << "POSTOS " << postos.size() << '\n';
+		for (unsigned int i=0 ; i<postos.size() ; i++){
+			postos.at(i)->serializar(buf);
+			buf << '\n';
+		}
+
+		buf << "FECHADOS " << acidentesFechados.size() << '\n';
+		for (unsigned int i=0 ; i<acidentesFechados.size() ; i++){
+			buf << acidentesFechados.at(i) << '\n';
+		}
+
+		buf << "ABERTOS " << acidentesAbertos.size() << '\n';
+		for (unsigned int i=0 ; i<acidentesAbertos.size() ; i++){
+			buf << acidentesAbertos.at(i)->getNumOcorrencia() << '\n';
+			acidentesAbertos.at(i)->serializar(buf);
+			buf << '\n';
+		}
+	}
+
+	const std::string texto = conteudo.str();
+	FicheiroAtomico destino(ficheiro);
+	destino.getStream() << texto << "FIM " << Crc32c::calcular(texto.data(), texto.size()) << '\n';
+	destino.confirmar();
+}
+
+unsigned long long SegmentoCheckpoint::calcularAssinatura(const char* dados, unsigned long long tamanho){
+	unsigned long long assinatura = 14695981039346656037ULL;	// Base do FNV-1a
+	for (unsigned long long i=0 ; i<tamanho ; i++){
+		assinatura ^= (unsigned char) dados[i];
+		assinatura *= 1099511628211ULL;						// Primo do FNV-1a
+	}
+	return assinatura;
+}
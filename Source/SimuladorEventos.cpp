@@ -0,0 +1,320 @@
+#include "SimuladorEventos.h"
+#include <random>
+#include <cstdio>
+#include <limits>
+
+/**
+ * @brief Permite obter a data (DD-MM-AAAA) de um instante da simulação
+ * @param instante - Instante (minutos desde as 0h de 1 de janeiro do ano inicial)
+ * @param ano - Ano inicial
+ * @return Retorna a data do instante
+ */
+static std::string getData(double instante, unsigned int ano){
+	static const unsigned int diasMes[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	unsigned long long dia = (unsigned long long)(instante / (24 * 60));
+
+	// Avancar ano a ano e depois mes a mes
+	while (true){
+		unsigned int diasAno = (((ano % 4 == 0) && (ano % 100 != 0)) || (ano % 400 == 0)) ? 366 : 365;
+		if (dia < diasAno)
+			break;
+		dia -= diasAno;
+		ano++;
+	}
+	unsigned int mes = 0;
+	while (true){
+		unsigned int dias = diasMes[mes] + ((mes == 1 && ((((ano % 4 == 0) && (ano % 100 != 0)) || (ano % 400 == 0)))) ? 1 : 0);
+		if (dia < dias)
+			break;
+		dia -= dias;
+		mes++;
+	}
+
+	char data[32];
+	snprintf(data, sizeof(data), "%02u-%02u-%04u", (unsigned int)dia + 1, mes + 1, ano);
+	return data;
+}
+
+SimuladorEventos::Parametros::Parametros() : velocidade(1.0), duracaoIncendio(180), duracaoViacao(60), duracaoAssalto(45), ano(2018) {}
+
+SimuladorEventos::Estatisticas::Estatisticas() : numAcidentes(0), numCompletos(0), numParciais(0), numSemMeios(0), numReforcos(0), unidadesAtribuidas(0), unidadesEmFalta(0),
+		tempoRespostaTotal(0), tempoRespostaMaximo(0), veiculosMinutos(0), veiculosFora(0), maxVeiculosFora(0) {}
+
+double SimuladorEventos::Estatisticas::getTempoRespostaMedio() const{
+	unsigned int aceites = numCompletos + numParciais;
+	return (aceites == 0 ? 0 : tempoRespostaTotal / aceites);
+}
+
+bool SimuladorEventos::Evento::operator>(const Evento &outro) const{
+	if (instante != outro.instante)
+		return instante > outro.instante;
+	return ordem > outro.ordem;
+}
+
+SimuladorEventos::SimuladorEventos(const ProtecaoCivil &protecaoCivil, const Parametros &parametros)
+	: protecaoCivil(protecaoCivil), capacidades(protecaoCivil.getCapacidades()), parametros(parametros), instante(0), numAgendados(0), proximoNumOcorrencia(protecaoCivil.getMaxNumOcorrencia() + 1) {}
+
+SimuladorEventos::SimuladorEventos(const ProtecaoCivil &protecaoCivil, const TabelaCapacidades &capacidades, const Parametros &parametros)
+	: protecaoCivil(protecaoCivil), capacidades(capacidades), parametros(parametros), instante(0), numAgendados(0), proximoNumOcorrencia(protecaoCivil.getMaxNumOcorrencia() + 1) {}
+
+void SimuladorEventos::agendar(double instanteEvento, TipoEvento tipo, unsigned int indice){
+	Evento evento;
+	evento.instante = instanteEvento;
+	evento.ordem = numAgendados++;
+	evento.tipo = tipo;
+	evento.indice = indice;
+	calendario.push(evento);
+}
+
+void SimuladorEventos::avancar(double novoInstante){
+	if (novoInstante <= instante)
+		return;
+	estatisticas.veiculosMinutos += estatisticas.veiculosFora * (novoInstante - instante);
+	instante = novoInstante;
+}
+
+void SimuladorEventos::registarOcupacao(const Atribuicao &atribuicao, bool saida){
+	OcupacaoPosto &posto = ocupacao[atribuicao.getPostoId()];
+	posto.veiculosMinutos += posto.veiculosFora * (instante - posto.desde);
+	posto.desde = instante;
+
+	if (saida){
+		posto.veiculosFora += atribuicao.getNumVeiculos();
+		estatisticas.veiculosFora += atribuicao.getNumVeiculos();
+		estatisticas.maxVeiculosFora = std::max(estatisticas.maxVeiculosFora, estatisticas.veiculosFora);
+	}
+	else {
+		posto.veiculosFora -= std::min(posto.veiculosFora, atribuicao.getNumVeiculos());
+		estatisticas.veiculosFora -= std::min(estatisticas.veiculosFora, atribuicao.getNumVeiculos());
+	}
+}
+
+double SimuladorEventos::getTempoViagem(const Atribuicao &atribuicao, const Acidente* acidente) const{
+	const Posto* posto = protecaoCivil.getPosto(atribuicao.getPostoId());
+	if (posto == NULL)
+		return 0;
+	return OtimizadorDespacho::distancia(posto, acidente) / parametros.velocidade;
+}
+
+double SimuladorEventos::getDuracao(const Acidente* acidente) const{
+	std::string tipoAcidente = acidente->getTipoAcidente();
+	if (tipoAcidente == "Acidente de Viacao")
+		return parametros.duracaoViacao;
+	if ((tipoAcidente == "Incendio Florestal") || (tipoAcidente == "Incendio Domestico"))
+		return parametros.duracaoIncendio;
+	return parametros.duracaoAssalto;
+}
+
+void SimuladorEventos::agendarAcidente(double instanteChegada, const DescritorAcidente &descritor){
+	agendados.push_back(descritor);
+	agendados.back().data = getData(instanteChegada, parametros.ano);
+	agendar(instanteChegada, CHEGADA_ACIDENTE, agendados.size() - 1);
+}
+
+std::vector< std::pair<double, DescritorAcidente> > SimuladorEventos::gerarDescritores(const std::vector<Local> &locais, double inicio, double duracao, double acidentesPorDia, unsigned int semente, unsigned int ano){
+	std::vector< std::pair<double, DescritorAcidente> > gerados;
+	if (locais.empty() || acidentesPorDia <= 0)
+		return gerados;
+
+	std::mt19937 gerador(semente);
+	std::exponential_distribution<double> intervalo(acidentesPorDia / (24 * 60));
+	std::uniform_int_distribution<unsigned int> local(0, locais.size() - 1);
+	std::uniform_int_distribution<unsigned int> percentagem(0, 99);
+	std::uniform_int_distribution<unsigned int> umATres(1, 3);
+
+	for (double t = inicio + intervalo(gerador) ; t < inicio + duracao ; t += intervalo(gerador)){
+		DescritorAcidente descritor;
+		descritor.nomeLocal = locais.at(local(gerador)).getNome();
+		descritor.data = getData(t, ano);
+
+		unsigned int tipo = percentagem(gerador);
+		if (tipo < 45){
+			descritor.tipo = "Assalto";
+			descritor.tipoCasa = (percentagem(gerador) < 50 ? "Particular" : "Comercial");
+			descritor.haFeridos = (percentagem(gerador) < 30);
+		}
+		else if (tipo < 75){
+			descritor.tipo = "Viacao";
+			descritor.tipoEstrada = (percentagem(gerador) < 50 ? "Estrada Nacional" : "Auto-Estrada");
+			descritor.numFeridos = umATres(gerador);
+			descritor.numVeiculos = umATres(gerador);
+		}
+		else {
+			descritor.tipo = "Incendio";
+			descritor.numAutotanquesNecess = umATres(gerador);
+			descritor.numBombeirosNecess = 3 * descritor.numAutotanquesNecess;	// Os autotanques saem com 3 bombeiros cada
+			if (percentagem(gerador) < 50){
+				descritor.tipoIncendio = "Florestal";
+				descritor.areaChamas = 1 + percentagem(gerador);
+			}
+			else {
+				descritor.tipoIncendio = "Domestico";
+				descritor.tipoCasa = (percentagem(gerador) < 50 ? "Particular" : "Comercial");
+			}
+		}
+
+		gerados.push_back(std::make_pair(t, descritor));
+	}
+	return gerados;
+}
+
+unsigned int SimuladorEventos::gerarAcidentes(double duracao, double acidentesPorDia, unsigned int semente){
+	std::vector< std::pair<double, DescritorAcidente> > gerados = gerarDescritores(protecaoCivil.getLocais(), instante, duracao, acidentesPorDia, semente, parametros.ano);
+	for (unsigned int i=0 ; i<gerados.size() ; i++){
+		agendarAcidente(gerados.at(i).first, gerados.at(i).second);
+	}
+	return gerados.size();
+}
+
+double SimuladorEventos::acompanharAtribuicoes(unsigned int numOcorrencia, AcidenteEmCurso &acidenteEmCurso){
+	const std::vector<Atribuicao> &atribuicoes = acidenteEmCurso.acidente->getAtribuicoes();
+	double primeiraChegada = std::numeric_limits<double>::infinity();
+	double ultimaChegada = instante;
+
+	for (unsigned int i=acidenteEmCurso.numAtribuicoes ; i<atribuicoes.size() ; i++){
+		double chegada = instante + getTempoViagem(atribuicoes.at(i), acidenteEmCurso.acidente.get());
+		primeiraChegada = std::min(primeiraChegada, chegada);
+		ultimaChegada = std::max(ultimaChegada, chegada);
+
+		registarOcupacao(atribuicoes.at(i), true);
+		estatisticas.unidadesAtribuidas += atribuicoes.at(i).getNumVeiculos();
+	}
+	acidenteEmCurso.numAtribuicoes = atribuicoes.size();
+
+	// O trabalho no local so acaba depois de decorrida a duracao a partir da chegada do ultimo meio
+	double fim = ultimaChegada + getDuracao(acidenteEmCurso.acidente.get());
+	if (fim > acidenteEmCurso.fim){
+		acidenteEmCurso.fim = fim;
+		agendar(fim, FIM_ACIDENTE, numOcorrencia);
+	}
+
+	return primeiraChegada - instante;
+}
+
+void SimuladorEventos::chegarAcidente(unsigned int indice){
+	DescritorAcidente descritor;
+	std::swap(descritor, agendados.at(indice));	// O descritor deixa de ser necessario
+	estatisticas.numAcidentes++;
+
+	const Local* local = protecaoCivil.getLocal(descritor.nomeLocal);
+	if (local == NULL || !descritor.valido()){
+		estatisticas.numSemMeios++;
+		return;
+	}
+
+	std::shared_ptr<Acidente> acidente(descritor.criarAcidente(local, proximoNumOcorrencia));
+	ResultadoDespacho resultado = protecaoCivil.planearDespacho(acidente.get(), capacidades);
+
+	if (!resultado.aceite()){	// O acidente nao fica na simulacao, mas os meios que tenham saido regressam
+		estatisticas.numSemMeios++;
+		const ResultadoDespacho::TipoRecurso recursos[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+		for (unsigned int r=0 ; r<3 ; r++){
+			estatisticas.unidadesEmFalta += resultado.falta[recursos[r]];
+		}
+		for (unsigned int i=0 ; i<resultado.atribuicoes.size() ; i++){
+			registarOcupacao(resultado.atribuicoes.at(i), true);
+			estatisticas.unidadesAtribuidas += resultado.atribuicoes.at(i).getNumVeiculos();
+			emRegresso.push_back(resultado.atribuicoes.at(i));
+			agendar(instante, REGRESSO_MEIOS, emRegresso.size() - 1);
+		}
+		return;
+	}
+
+	if (resultado.estado == ResultadoDespacho::COMPLETO)
+		estatisticas.numCompletos++;
+	else
+		estatisticas.numParciais++;
+	pendentes.atualizar(acidente.get(), resultado);
+
+	AcidenteEmCurso acidenteEmCurso;
+	acidenteEmCurso.acidente = acidente;
+	acidenteEmCurso.fim = -std::numeric_limits<double>::infinity();		// Ainda sem fim agendado
+	acidenteEmCurso.numAtribuicoes = 0;
+	double tempoResposta = acompanharAtribuicoes(proximoNumOcorrencia, acidenteEmCurso);
+	emCurso.insert(std::make_pair(proximoNumOcorrencia, acidenteEmCurso));
+	proximoNumOcorrencia++;
+
+	estatisticas.temposResposta.push_back(tempoResposta);
+	estatisticas.tempoRespostaTotal += tempoResposta;
+	estatisticas.tempoRespostaMaximo = std::max(estatisticas.tempoRespostaMaximo, tempoResposta);
+}
+
+void SimuladorEventos::terminarAcidente(unsigned int numOcorrencia, double instanteEvento){
+	std::map<unsigned int, AcidenteEmCurso>::iterator it = emCurso.find(numOcorrencia);
+	if (it == emCurso.end() || it->second.fim != instanteEvento)
+		return;		// O fim foi adiado por um reforco (ha outro evento para o novo fim)
+
+	// Os meios do acidente regressam aos postos (o que ainda lhe faltava deixa de ser preciso)
+	std::shared_ptr<Acidente> acidente = it->second.acidente;
+	std::vector<Atribuicao> meiosEmRegresso = acidente->getAtribuicoes();
+	const ResultadoDespacho::TipoRecurso recursos[] = { ResultadoDespacho::AUTOTANQUES, ResultadoDespacho::EQUIPAS_POLICIAIS, ResultadoDespacho::EQUIPAS_MEDICAS };
+	for (unsigned int r=0 ; r<3 ; r++){
+		estatisticas.unidadesEmFalta += pendentes.getUnidadesEmFalta(numOcorrencia, recursos[r]);
+	}
+	pendentes.remover(numOcorrencia);
+	emCurso.erase(it);
+
+	for (unsigned int i=0 ; i<meiosEmRegresso.size() ; i++){
+		emRegresso.push_back(meiosEmRegresso.at(i));
+		agendar(instante + getTempoViagem(meiosEmRegresso.at(i), acidente.get()), REGRESSO_MEIOS, emRegresso.size() - 1);
+	}
+}
+
+void SimuladorEventos::regressarMeios(unsigned int indice){
+	const Atribuicao &atribuicao = emRegresso.at(indice);
+	registarOcupacao(atribuicao, false);
+
+	// Os meios podem seguir de imediato para acidentes simulados pendentes (todos eles em curso): esses meios voltam a sair
+	std::vector<Acidente*> reforcados = protecaoCivil.planearRegresso(atribuicao, capacidades, pendentes);
+	for (unsigned int i=0 ; i<reforcados.size() ; i++){
+		std::map<unsigned int, AcidenteEmCurso>::iterator it = emCurso.find(reforcados.at(i)->getNumOcorrencia());
+		acompanharAtribuicoes(it->first, it->second);
+		estatisticas.numReforcos++;
+	}
+}
+
+void SimuladorEventos::executar(double instanteFinal){
+	while (!calendario.empty() && calendario.top().instante <= instanteFinal){
+		Evento evento = calendario.top();
+		calendario.pop();
+		avancar(evento.instante);
+
+		if (evento.tipo == CHEGADA_ACIDENTE)
+			chegarAcidente(evento.indice);
+		else if (evento.tipo == FIM_ACIDENTE)
+			terminarAcidente(evento.indice, evento.instante);
+		else
+			regressarMeios(evento.indice);
+	}
+	avancar(instanteFinal);
+}
+
+void SimuladorEventos::executar(){
+	while (!calendario.empty()){
+		executar(calendario.top().instante);
+	}
+}
+
+double SimuladorEventos::getInstante() const{
+	return instante;
+}
+
+unsigned int SimuladorEventos::getNumEmCurso() const{
+	return emCurso.size();
+}
+
+std::map<unsigned int, double> SimuladorEventos::getVeiculosMinutosPostos() const{
+	std::map<unsigned int, double> veiculosMinutos;
+	for (std::map<unsigned int, OcupacaoPosto>::const_iterator it = ocupacao.begin() ; it != ocupacao.end() ; it++){
+		veiculosMinutos[it->first] = it->second.veiculosMinutos + it->second.veiculosFora * (instante - it->second.desde);
+	}
+	return veiculosMinutos;
+}
+
+const TabelaCapacidades & SimuladorEventos::getCapacidades() const{
+	return capacidades;
+}
+
+const SimuladorEventos::Estatisticas & SimuladorEventos::getEstatisticas() const{
+	return estatisticas;
+}
@@ -0,0 +1,123 @@
+#include "TabelaCapacidades.h"
+#include "OtimizadorDespacho.h"
+
+unsigned long long TabelaCapacidades::novoId(){
+	static std::atomic<unsigned long long> ultimoId(0);
+	return ++ultimoId;
+}
+
+TabelaCapacidades::TabelaCapacidades(const std::map<unsigned int, Posto*> &postos) : id(novoId()) {
+	std::map<unsigned int, unsigned int>* indice = new std::map<unsigned int, unsigned int>();
+	posicoes.reset(indice);
+
+	unsigned int posicao = 0;
+	for (std::map<unsigned int, Posto*>::const_iterator it = postos.begin() ; it != postos.end() ; it++, posicao++){
+		if (posicao % TAMANHO_PAGINA == 0)
+			paginas.push_back(std::make_shared<Pagina>(id));
+		(*indice)[it->first] = posicao;
+
+		Capacidade capacidade;
+		for (unsigned int r=0 ; r<ResultadoDespacho::NUM_RECURSOS ; r++){
+			capacidade.veiculos[r] = it->second->getVeiculos((ResultadoDespacho::TipoRecurso)r);
+		}
+		capacidade.socorristas = it->second->getNumSocorristas();
+		paginas.back()->capacidades.push_back(capacidade);
+	}
+}
+
+TabelaCapacidades::TabelaCapacidades(const TabelaCapacidades &outra) : id(novoId()) {
+	partilhar(outra);
+}
+
+TabelaCapacidades & TabelaCapacidades::operator=(const TabelaCapacidades &outra){
+	if (this != &outra)
+		partilhar(outra);
+	return *this;
+}
+
+void TabelaCapacidades::partilhar(const TabelaCapacidades &outra){
+	// Nenhuma das copias pode voltar a alterar estas paginas sem as duplicar (a escrita e atomica porque a outra tabela pode estar a ser copiada noutras threads)
+	for (unsigned int i=0 ; i<outra.paginas.size() ; i++){
+		outra.paginas.at(i)->dono.store(0, std::memory_order_relaxed);
+	}
+	posicoes = outra.posicoes;
+	paginas = outra.paginas;
+}
+
+unsigned int TabelaCapacidades::getPosicao(const Posto* posto) const{
+	return posicoes->at(posto->getId());
+}
+
+const TabelaCapacidades::Capacidade & TabelaCapacidades::ler(unsigned int posicao) const{
+	return paginas.at(posicao / TAMANHO_PAGINA)->capacidades.at(posicao % TAMANHO_PAGINA);
+}
+
+TabelaCapacidades::Capacidade & TabelaCapacidades::escrever(unsigned int posicao){
+	std::shared_ptr<Pagina> &pagina = paginas.at(posicao / TAMANHO_PAGINA);
+
+	// Uma pagina que nao foi criada por esta copia pode estar a ser lida por outras: esta copia passa a ter a sua
+	if (pagina->dono.load(std::memory_order_relaxed) != id)
+		pagina = std::make_shared<Pagina>(*pagina, id);
+	return pagina->capacidades.at(posicao % TAMANHO_PAGINA);
+}
+
+const TabelaCapacidades::Capacidade & TabelaCapacidades::getCapacidade(const Posto* posto) const{
+	return ler(getPosicao(posto));
+}
+
+std::vector<unsigned int> TabelaCapacidades::getIdsPostos() const{
+	std::vector<unsigned int> ids;
+	for (std::map<unsigned int, unsigned int>::const_iterator it = posicoes->begin() ; it != posicoes->end() ; it++){
+		ids.push_back(it->first);
+	}
+	return ids;
+}
+
+void TabelaCapacidades::definirCapacidade(const Posto* posto, const Capacidade &capacidade){
+	escrever(getPosicao(posto)) = capacidade;
+}
+
+void TabelaCapacidades::repor(const Posto* posto, const Atribuicao &atribuicao){
+	Capacidade &capacidade = escrever(getPosicao(posto));
+	capacidade.socorristas += atribuicao.getNumSocorristas();
+	ResultadoDespacho::TipoRecurso recurso = posto->getRecurso(atribuicao.getTipoVeiculos());
+	if (recurso != ResultadoDespacho::NUM_RECURSOS)
+		capacidade.veiculos[recurso] += atribuicao.getNumVeiculos();
+}
+
+unsigned int TabelaCapacidades::getNumPaginasProprias() const{
+	unsigned int proprias = 0;
+	for (unsigned int i=0 ; i<paginas.size() ; i++){
+		if (paginas.at(i)->dono.load(std::memory_order_relaxed) == id)
+			proprias++;
+	}
+	return proprias;
+}
+
+unsigned int TabelaCapacidades::getVeiculos(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const{
+	return ler(getPosicao(posto)).veiculos[recurso];
+}
+
+unsigned int TabelaCapacidades::getOferta(const Posto* posto, ResultadoDespacho::TipoRecurso recurso) const{
+	// O mesmo que Posto::getOferta, com os contadores deste instantaneo
+	unsigned int tripulacao = posto->getTripulacao(recurso);
+	if (tripulacao == 0)
+		return 0;
+
+	const Capacidade &capacidade = ler(getPosicao(posto));
+	unsigned int equipas = capacidade.socorristas / tripulacao;
+	return (capacidade.veiculos[recurso] < equipas ? capacidade.veiculos[recurso] : equipas);
+}
+
+bool TabelaCapacidades::reservar(Posto* posto, ResultadoDespacho::TipoRecurso recurso, unsigned int veiculos, unsigned int socorristas){
+	unsigned int posicao = getPosicao(posto);
+
+	// Verificar primeiro na pagina partilhada, para que uma reserva falhada nao duplique a pagina
+	if (ler(posicao).veiculos[recurso] < veiculos || ler(posicao).socorristas < socorristas)
+		return false;
+
+	Capacidade &capacidade = escrever(posicao);
+	capacidade.socorristas -= socorristas;
+	capacidade.veiculos[recurso] -= veiculos;
+	return true;
+}
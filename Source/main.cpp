@@ -31,6 +31,10 @@ int main(){
 		std::cerr << e.getInfo();
 		return 1;
 	}
+	catch(DadosCorrompidos &e){
+		std::cerr << e.getInfo();
+		return 1;
+	}
 
 
 	int opt;
@@ -41,7 +45,7 @@ int main(){
 
 		// Pedir opcao ao utilizador e verificar se nao houve erro de input
 		try{
-			opt = getOption(1,5);
+			opt = getOption(1,6);
 		}
 		catch(InputInvalido &e){
 			std::cout << "\n" << e.getInfo();
@@ -56,8 +60,18 @@ int main(){
 			infoOcorrencia(protecaoCivil);
 		else if (opt == 4)
 			pesquisarPostos(protecaoCivil);
+		else if (opt == 5)
+			exportarHistorico(protecaoCivil);
 		else
-			break;	// opt = 5, o utilizador quer sair
+			break;	// opt = 6, o utilizador quer sair
+
+		// Gravar periodicamente as alteracoes feitas (apenas o que mudou desde o ultimo checkpoint)
+		try{
+			protecaoCivil.checkpointPeriodico();
+		}
+		catch(ErroEscrita &e){
+			std::cerr << "\n" << e.getInfo();
+		}
 	}
 
 	return 0;
@@ -181,6 +195,33 @@ void terminarOcorrencia(ProtecaoCivil &protecaoCivil){
 	pause();
 }
 
+void exportarHistorico(ProtecaoCivil &protecaoCivil){
+	std::string prefixo;
+	std::cout << "\nIndique o prefixo dos ficheiros a exportar: ";
+	getline(std::cin, prefixo);
+
+	if (prefixo.empty()){
+		std::cout << "\nPrefixo invalido!\n\n";
+		pause();
+		return;
+	}
+
+	// Exportar e lidar com eventuais erros de leitura do arquivo ou de escrita
+	try{
+		unsigned long long numAcidentes = protecaoCivil.exportarColunas(prefixo);
+		std::cout << "\nForam exportados " << numAcidentes << " acidentes (esquema em \"" << prefixo << ".esquema\")\n\n";
+	}
+	catch(ErroEscrita &e){
+		std::cout << '\n' << e.getInfo() << std::endl << std::endl;
+	}
+	catch(DadosCorrompidos &e){
+		std::cout << '\n' << e.getInfo() << std::endl << std::endl;
+	}
+
+	// Esperar que o utilizador prima enter para retorna ao menu principal
+	pause();
+}
+
 void infoOcorrencia(ProtecaoCivil &protecaoCivil){
 
 	int opt;
@@ -310,7 +351,12 @@ void infoOcorrencia(ProtecaoCivil &protecaoCivil){
 
 			// Imprimir o acidente com o id pretendido
 			std::cout << std::endl;
-			protecaoCivil.printAcidentesId(acidenteId);
+			try{
+				protecaoCivil.printAcidentesId(acidenteId);
+			}
+			catch(DadosCorrompidos &e){
+				std::cout << e.getInfo();
+			}
 			std::cout << std::endl;
 
 			pause();
@@ -474,7 +520,8 @@ void printMainMenu(){
 	std::cout << "2. Terminar Ocorrencia" << std::endl;
 	std::cout << "3. Informacoes sobre Ocorrencias" << std::endl;
 	std::cout << "4. Pesquisar Postos" << std::endl;
-	std::cout << "5. Sair" << std::endl << std::endl;
+	std::cout << "5. Exportar Historico (colunas)" << std::endl;
+	std::cout << "6. Sair" << std::endl << std::endl;
 }
 
 void printPesquisarPostosMenu(){